@@ -23,7 +23,7 @@ struct SerialBridge
 #else
     hal::UartUnix serialPort;
 #endif
-    services::SerialServer::WithBuffer<512> serialServer;
+    services::SerialServer::WithBuffers<512, 512> serialServer;
 };
 
 void ShowUsage(services::Tracer& tracer, const std::string& program)
@@ -0,0 +1,69 @@
+#include "hal/generic/EthernetFileDescriptorStation.hpp"
+#include "infra/event/EventDispatcher.hpp"
+#include <poll.h>
+#include <unistd.h>
+
+namespace hal
+{
+    EthernetFileDescriptorStation::EthernetFileDescriptorStation(EthernetLinkSimulated& link, int fileDescriptor)
+        : EthernetStationSimulated(link)
+        , fileDescriptor(fileDescriptor)
+        , readThread([this]()
+              {
+                  Read();
+              })
+    {}
+
+    EthernetFileDescriptorStation::~EthernetFileDescriptorStation()
+    {
+        {
+            std::unique_lock lock(mutex);
+            running = false;
+            transmitted.notify_all();
+        }
+
+        readThread.join();
+        close(fileDescriptor);
+    }
+
+    void EthernetFileDescriptorStation::ReceiveFrame(infra::ConstByteRange frame)
+    {
+        // A frame which the descriptor does not accept is dropped, as it would be on a link
+        auto result = write(fileDescriptor, frame.begin(), frame.size());
+        static_cast<void>(result);
+    }
+
+    void EthernetFileDescriptorStation::Read()
+    {
+        while (running)
+        {
+            // Poll with a timeout, so that the thread notices when the station is destroyed
+            pollfd descriptor{ fileDescriptor, POLLIN, 0 };
+            if (poll(&descriptor, 1, 100) <= 0)
+                continue;
+
+            auto size = read(fileDescriptor, buffer.data(), buffer.size());
+            if (size == 0)
+                return; // The peer closed its end of a socket, no more frames will arrive
+            if (size < 0)
+                continue;
+
+            // The frame is transmitted on the event dispatcher; the buffer is reused only after that has happened
+            std::unique_lock lock(mutex);
+            transmitting = true;
+            infra::EventDispatcher::Instance().Schedule([this, size]()
+                {
+                    TransmitFrame(infra::ConstByteRange(buffer.data(), buffer.data() + size));
+
+                    std::unique_lock lock(mutex);
+                    transmitting = false;
+                    transmitted.notify_all();
+                });
+
+            transmitted.wait(lock, [this]()
+                {
+                    return !transmitting || !running;
+                });
+        }
+    }
+}
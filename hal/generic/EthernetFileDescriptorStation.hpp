@@ -0,0 +1,40 @@
+#ifndef HAL_ETHERNET_FILE_DESCRIPTOR_STATION_HPP
+#define HAL_ETHERNET_FILE_DESCRIPTOR_STATION_HPP
+
+#include "hal/generic/EthernetLinkSimulated.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace hal
+{
+    // EthernetFileDescriptorStation attaches a file descriptor that transfers one frame per read and write, e.g. a TAP
+    // interface or a datagram socket, to an EthernetLinkSimulated. With one end of a socketpair in each of two processes,
+    // the links of both processes are joined without needing privileges. The station takes ownership of the descriptor.
+    class EthernetFileDescriptorStation
+        : public EthernetStationSimulated
+    {
+    public:
+        EthernetFileDescriptorStation(EthernetLinkSimulated& link, int fileDescriptor);
+        ~EthernetFileDescriptorStation();
+
+        // Implementation of EthernetStationSimulated
+        void ReceiveFrame(infra::ConstByteRange frame) override;
+
+    private:
+        void Read();
+
+    private:
+        int fileDescriptor;
+        std::array<uint8_t, 1518> buffer;
+        std::atomic<bool> running{ true };
+        std::mutex mutex;
+        std::condition_variable transmitted;
+        bool transmitting = false;
+        std::thread readThread;
+    };
+}
+
+#endif
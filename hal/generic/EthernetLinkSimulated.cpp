@@ -0,0 +1,75 @@
+#include "hal/generic/EthernetLinkSimulated.hpp"
+#include "infra/event/EventDispatcher.hpp"
+
+namespace hal
+{
+    void EthernetStationSimulated::TransmitFrame(infra::ConstByteRange frame)
+    {
+        Subject().Transmit(*this, frame);
+    }
+
+    EthernetLinkSimulated::EthernetLinkSimulated(const Config& config)
+        : config(config)
+        , randomGenerator(config.seed)
+        , loss(config.lossProbability)
+    {}
+
+    void EthernetLinkSimulated::Transmit(EthernetStationSimulated& sender, infra::ConstByteRange frame)
+    {
+        ++statistics.framesTransmitted;
+
+        if (loss(randomGenerator))
+        {
+            ++statistics.framesLost;
+            return;
+        }
+
+        bool idle = inTransit.empty();
+        inTransit.push_back(Frame{ &sender, std::vector<uint8_t>(frame.begin(), frame.end()), infra::Now() + config.latency });
+
+        if (!idle)
+            return;
+
+        if (config.latency == infra::Duration::zero())
+            infra::EventDispatcher::Instance().Schedule([this]()
+                {
+                    DeliverDueFrames();
+                });
+        else
+            deliveryTimer.Start(inTransit.front().deliveryTime, [this]()
+                {
+                    DeliverDueFrames();
+                });
+    }
+
+    EthernetLinkSimulated::Statistics EthernetLinkSimulated::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void EthernetLinkSimulated::DeliverDueFrames()
+    {
+        while (!inTransit.empty() && inTransit.front().deliveryTime <= infra::Now())
+        {
+            // Stations may transmit while receiving, so the frame is taken out of the queue before delivering it
+            auto frame = std::move(inTransit.front());
+            inTransit.pop_front();
+            Deliver(frame);
+        }
+
+        if (!inTransit.empty() && config.latency != infra::Duration::zero())
+            deliveryTimer.Start(inTransit.front().deliveryTime, [this]()
+                {
+                    DeliverDueFrames();
+                });
+    }
+
+    void EthernetLinkSimulated::Deliver(const Frame& frame)
+    {
+        NotifyObservers([&frame](EthernetStationSimulated& station)
+            {
+                if (&station != frame.sender)
+                    station.ReceiveFrame(infra::MakeRange(frame.data));
+            });
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef HAL_ETHERNET_LINK_SIMULATED_HPP
+#define HAL_ETHERNET_LINK_SIMULATED_HPP
+
+#include "infra/timer/Timer.hpp"
+#include "infra/util/ByteRange.hpp"
+#include "infra/util/Observer.hpp"
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace hal
+{
+    class EthernetLinkSimulated;
+
+    class EthernetStationSimulated
+        : public infra::Observer<EthernetStationSimulated, EthernetLinkSimulated>
+    {
+    public:
+        using infra::Observer<EthernetStationSimulated, EthernetLinkSimulated>::Observer;
+
+        // Invoked on the event dispatcher for each frame transmitted by another station on the link
+        virtual void ReceiveFrame(infra::ConstByteRange frame) = 0;
+
+    protected:
+        void TransmitFrame(infra::ConstByteRange frame);
+    };
+
+    // EthernetLinkSimulated is an Ethernet segment between stations in the same process, e.g. EthernetMacSimulated
+    // or EthernetTapStation. Each frame that a station transmits is delivered to all other stations after the configured
+    // latency, unless it is lost. Losses are drawn from a generator seeded by the configuration, so that a run can be repeated.
+    class EthernetLinkSimulated
+        : public infra::Subject<EthernetStationSimulated>
+    {
+    public:
+        struct Config
+        {
+            Config() {}
+
+            infra::Duration latency = infra::Duration::zero();
+            double lossProbability = 0;
+            uint32_t seed = 0;
+        };
+
+        struct Statistics
+        {
+            uint32_t framesTransmitted = 0;
+            uint32_t framesLost = 0;
+        };
+
+        explicit EthernetLinkSimulated(const Config& config = Config());
+
+        void Transmit(EthernetStationSimulated& sender, infra::ConstByteRange frame);
+
+        Statistics GetStatistics() const;
+
+    private:
+        struct Frame
+        {
+            const EthernetStationSimulated* sender;
+            std::vector<uint8_t> data;
+            infra::TimePoint deliveryTime;
+        };
+
+        void DeliverDueFrames();
+        void Deliver(const Frame& frame);
+
+    private:
+        Config config;
+        std::mt19937 randomGenerator;
+        std::bernoulli_distribution loss;
+        std::deque<Frame> inTransit;
+        infra::TimerSingleShot deliveryTimer;
+        Statistics statistics;
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "hal/generic/EthernetMacSimulated.hpp"
+#include "infra/event/EventDispatcher.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace hal
+{
+    namespace
+    {
+        const MacAddress broadcastAddress{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+        constexpr std::size_t headerSize = 14;
+    }
+
+    EthernetMacSimulated::EthernetMacSimulated(EthernetLinkSimulated& link, MacAddress macAddress)
+        : EthernetStationSimulated(link)
+        , macAddress(macAddress)
+    {}
+
+    void EthernetMacSimulated::SendBuffer(infra::ConstByteRange data, bool last)
+    {
+        sendFrame.insert(sendFrame.end(), data.begin(), data.end());
+
+        if (last)
+        {
+            TransmitFrame(infra::MakeRange(sendFrame));
+            sendFrame.clear();
+
+            infra::EventDispatcher::Instance().Schedule([this]()
+                {
+                    if (HasObserver())
+                        GetObserver().SentFrame();
+                });
+        }
+    }
+
+    void EthernetMacSimulated::RetryAllocation()
+    {
+        DeliverReceivedFrames();
+    }
+
+    void EthernetMacSimulated::AddMacAddressFilter(MacAddress address)
+    {
+        filters.push_back(address);
+    }
+
+    void EthernetMacSimulated::RemoveMacAddressFilter(MacAddress address)
+    {
+        auto filter = std::find(filters.begin(), filters.end(), address);
+        if (filter != filters.end())
+            filters.erase(filter);
+    }
+
+    void EthernetMacSimulated::ReceiveFrame(infra::ConstByteRange frame)
+    {
+        if (!HasObserver() || !Accepts(frame))
+            return;
+
+        receivedFrames.emplace_back(frame.begin(), frame.end());
+
+        // When earlier frames are present, they are waiting for RetryAllocation
+        if (receivedFrames.size() == 1)
+            DeliverReceivedFrames();
+    }
+
+    bool EthernetMacSimulated::Accepts(infra::ConstByteRange frame) const
+    {
+        if (frame.size() < headerSize)
+            return false;
+
+        MacAddress destination;
+        std::copy(frame.begin(), frame.begin() + destination.size(), destination.begin());
+
+        return destination == macAddress || destination == broadcastAddress || std::find(filters.begin(), filters.end(), destination) != filters.end();
+    }
+
+    void EthernetMacSimulated::DeliverReceivedFrames()
+    {
+        while (!receivedFrames.empty() && HasObserver())
+        {
+            const auto& frame = receivedFrames.front();
+
+            while (receivedOffset != frame.size())
+            {
+                auto buffer = GetObserver().RequestReceiveBuffer();
+                if (buffer.empty())
+                    return;
+
+                auto size = std::min(buffer.size(), frame.size() - receivedOffset);
+                std::memcpy(buffer.begin(), frame.data() + receivedOffset, size);
+                receivedOffset += size;
+                ++usedBuffers;
+            }
+
+            auto frameSize = static_cast<uint32_t>(frame.size());
+            auto buffers = usedBuffers;
+            receivedFrames.pop_front();
+            receivedOffset = 0;
+            usedBuffers = 0;
+
+            GetObserver().ReceivedFrame(buffers, frameSize);
+        }
+    }
+}
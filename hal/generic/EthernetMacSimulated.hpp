@@ -0,0 +1,45 @@
+#ifndef HAL_ETHERNET_MAC_SIMULATED_HPP
+#define HAL_ETHERNET_MAC_SIMULATED_HPP
+
+#include "hal/generic/EthernetLinkSimulated.hpp"
+#include "hal/interfaces/Ethernet.hpp"
+#include <deque>
+#include <vector>
+
+namespace hal
+{
+    // EthernetMacSimulated lets a network stack, e.g. LightweightIpOverEthernet, run on a host on an EthernetLinkSimulated.
+    // Received frames are filtered on destination address like a MAC peripheral does, and are handed to the observer in
+    // the receive buffers that it provides. When the observer has no buffer available, received frames are held until
+    // RetryAllocation is invoked.
+    class EthernetMacSimulated
+        : public EthernetMac
+        , public EthernetStationSimulated
+    {
+    public:
+        EthernetMacSimulated(EthernetLinkSimulated& link, MacAddress macAddress);
+
+        // Implementation of EthernetMac
+        void SendBuffer(infra::ConstByteRange data, bool last) override;
+        void RetryAllocation() override;
+        void AddMacAddressFilter(MacAddress address) override;
+        void RemoveMacAddressFilter(MacAddress address) override;
+
+        // Implementation of EthernetStationSimulated
+        void ReceiveFrame(infra::ConstByteRange frame) override;
+
+    private:
+        bool Accepts(infra::ConstByteRange frame) const;
+        void DeliverReceivedFrames();
+
+    private:
+        MacAddress macAddress;
+        std::vector<MacAddress> filters;
+        std::vector<uint8_t> sendFrame;
+        std::deque<std::vector<uint8_t>> receivedFrames;
+        std::size_t receivedOffset = 0;
+        uint32_t usedBuffers = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include "hal/generic/EthernetTapStation.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/if.h>
+#include <linux/if_tun.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace hal
+{
+    TapNotOpened::TapNotOpened(const std::string& interfaceName, const std::string& errstr)
+        : std::runtime_error("Unable to open TAP interface \"" + interfaceName + "\" : \"" + errstr + "\"")
+    {}
+
+    EthernetTapStation::EthernetTapStation(EthernetLinkSimulated& link, const std::string& interfaceName)
+        : EthernetFileDescriptorStation(link, OpenTap(interfaceName))
+    {}
+
+    int EthernetTapStation::OpenTap(const std::string& interfaceName)
+    {
+        auto fileDescriptor = open("/dev/net/tun", O_RDWR);
+        if (fileDescriptor == -1)
+            throw TapNotOpened(interfaceName, strerror(errno));
+
+        ifreq request{};
+        request.ifr_flags = IFF_TAP | IFF_NO_PI;
+        std::strncpy(request.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+
+        if (ioctl(fileDescriptor, TUNSETIFF, &request) == -1)
+        {
+            auto error = errno;
+            close(fileDescriptor);
+            throw TapNotOpened(interfaceName, strerror(error));
+        }
+
+        return fileDescriptor;
+    }
+}
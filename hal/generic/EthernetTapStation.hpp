@@ -0,0 +1,31 @@
+#ifndef HAL_ETHERNET_TAP_STATION_HPP
+#define HAL_ETHERNET_TAP_STATION_HPP
+
+#include "hal/generic/EthernetFileDescriptorStation.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace hal
+{
+    class TapNotOpened
+        : public std::runtime_error
+    {
+    public:
+        TapNotOpened(const std::string& interfaceName, const std::string& errstr);
+    };
+
+    // EthernetTapStation attaches a Linux TAP interface to an EthernetLinkSimulated, so that the host's network stack is
+    // a station on the link. The interface must exist and be up, e.g.:
+    //   ip tuntap add dev emil0 mode tap user $USER && ip addr add 10.10.0.1/24 dev emil0 && ip link set emil0 up
+    class EthernetTapStation
+        : public EthernetFileDescriptorStation
+    {
+    public:
+        EthernetTapStation(EthernetLinkSimulated& link, const std::string& interfaceName);
+
+    private:
+        static int OpenTap(const std::string& interfaceName);
+    };
+}
+
+#endif
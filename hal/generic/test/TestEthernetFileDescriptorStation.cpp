@@ -0,0 +1,69 @@
+#include "hal/generic/EthernetFileDescriptorStation.hpp"
+#include "infra/timer/test_helper/ClockFixture.hpp"
+#include "gmock/gmock.h"
+#include <array>
+#include <chrono>
+#include <sys/socket.h>
+
+namespace
+{
+    class EthernetStationSimulatedMock
+        : public hal::EthernetStationSimulated
+    {
+    public:
+        using hal::EthernetStationSimulated::EthernetStationSimulated;
+        using hal::EthernetStationSimulated::TransmitFrame;
+
+        void ReceiveFrame(infra::ConstByteRange frame) override
+        {
+            ReceiveFrameMock(std::vector<uint8_t>(frame.begin(), frame.end()));
+        }
+
+        MOCK_METHOD(void, ReceiveFrameMock, (std::vector<uint8_t> frame));
+    };
+}
+
+class EthernetFileDescriptorStationTest
+    : public testing::Test
+    , public infra::ClockFixture
+{
+public:
+    static std::array<int, 2> SocketPair()
+    {
+        std::array<int, 2> result;
+        EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, result.data()));
+        return result;
+    }
+
+    // Frames arrive on a separate thread, so keep executing until the expected frame has been received
+    void ExecuteUntilReceived(const bool& received)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!received && std::chrono::steady_clock::now() < deadline)
+            ExecuteAllActions();
+    }
+
+    std::array<int, 2> sockets{ SocketPair() };
+    hal::EthernetLinkSimulated link1;
+    hal::EthernetLinkSimulated link2;
+    hal::EthernetFileDescriptorStation station1{ link1, sockets[0] };
+    hal::EthernetFileDescriptorStation station2{ link2, sockets[1] };
+    const std::vector<uint8_t> frame{ 1, 2, 3, 4 };
+};
+
+TEST_F(EthernetFileDescriptorStationTest, frames_are_transferred_between_links_in_both_directions)
+{
+    testing::StrictMock<EthernetStationSimulatedMock> station1Peer(link1);
+    testing::StrictMock<EthernetStationSimulatedMock> station2Peer(link2);
+    bool received = false;
+
+    station1Peer.TransmitFrame(infra::MakeRange(frame));
+    EXPECT_CALL(station2Peer, ReceiveFrameMock(frame)).WillOnce(testing::Assign(&received, true));
+    ExecuteUntilReceived(received);
+    testing::Mock::VerifyAndClearExpectations(&station2Peer);
+
+    received = false;
+    station2Peer.TransmitFrame(infra::MakeRange(frame));
+    EXPECT_CALL(station1Peer, ReceiveFrameMock(frame)).WillOnce(testing::Assign(&received, true));
+    ExecuteUntilReceived(received);
+}
@@ -0,0 +1,187 @@
+#include "hal/generic/EthernetLinkSimulated.hpp"
+#include "infra/timer/test_helper/ClockFixture.hpp"
+#include "gmock/gmock.h"
+
+namespace
+{
+    class EthernetStationSimulatedMock
+        : public hal::EthernetStationSimulated
+    {
+    public:
+        using hal::EthernetStationSimulated::EthernetStationSimulated;
+        using hal::EthernetStationSimulated::TransmitFrame;
+
+        void ReceiveFrame(infra::ConstByteRange frame) override
+        {
+            ReceiveFrameMock(std::vector<uint8_t>(frame.begin(), frame.end()));
+        }
+
+        MOCK_METHOD(void, ReceiveFrameMock, (std::vector<uint8_t> frame));
+    };
+}
+
+class EthernetLinkSimulatedTest
+    : public testing::Test
+    , public infra::ClockFixture
+{
+public:
+    static hal::EthernetLinkSimulated::Config WithLatency(infra::Duration latency)
+    {
+        hal::EthernetLinkSimulated::Config config;
+        config.latency = latency;
+        return config;
+    }
+
+    static hal::EthernetLinkSimulated::Config WithLossProbability(double lossProbability)
+    {
+        hal::EthernetLinkSimulated::Config config;
+        config.lossProbability = lossProbability;
+        return config;
+    }
+
+    const std::vector<uint8_t> frame{ 1, 2, 3, 4 };
+};
+
+TEST_F(EthernetLinkSimulatedTest, frame_is_delivered_to_all_other_stations)
+{
+    hal::EthernetLinkSimulated link;
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver1(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver2(link);
+
+    sender.TransmitFrame(infra::MakeRange(frame));
+
+    EXPECT_CALL(receiver1, ReceiveFrameMock(frame));
+    EXPECT_CALL(receiver2, ReceiveFrameMock(frame));
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetLinkSimulatedTest, frame_is_copied_on_transmit)
+{
+    hal::EthernetLinkSimulated link;
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver(link);
+
+    std::vector<uint8_t> transmitted = frame;
+    sender.TransmitFrame(infra::MakeRange(transmitted));
+    transmitted.assign(transmitted.size(), 0);
+
+    EXPECT_CALL(receiver, ReceiveFrameMock(frame));
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetLinkSimulatedTest, frames_are_delivered_in_order)
+{
+    hal::EthernetLinkSimulated link;
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver(link);
+
+    const std::vector<uint8_t> otherFrame{ 5, 6 };
+    sender.TransmitFrame(infra::MakeRange(frame));
+    sender.TransmitFrame(infra::MakeRange(otherFrame));
+
+    testing::InSequence s;
+    EXPECT_CALL(receiver, ReceiveFrameMock(frame));
+    EXPECT_CALL(receiver, ReceiveFrameMock(otherFrame));
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetLinkSimulatedTest, frame_is_delivered_after_latency)
+{
+    hal::EthernetLinkSimulated link(WithLatency(std::chrono::milliseconds(10)));
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver(link);
+
+    sender.TransmitFrame(infra::MakeRange(frame));
+
+    ForwardTime(std::chrono::milliseconds(9));
+    testing::Mock::VerifyAndClearExpectations(&receiver);
+
+    EXPECT_CALL(receiver, ReceiveFrameMock(frame)).With(After(std::chrono::milliseconds(1)));
+    ForwardTime(std::chrono::milliseconds(1));
+}
+
+TEST_F(EthernetLinkSimulatedTest, frames_transmitted_while_in_transit_are_each_delayed_by_latency)
+{
+    hal::EthernetLinkSimulated link(WithLatency(std::chrono::milliseconds(10)));
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver(link);
+
+    const std::vector<uint8_t> otherFrame{ 5, 6 };
+    sender.TransmitFrame(infra::MakeRange(frame));
+    ForwardTime(std::chrono::milliseconds(5));
+    sender.TransmitFrame(infra::MakeRange(otherFrame));
+
+    EXPECT_CALL(receiver, ReceiveFrameMock(frame)).With(After(std::chrono::milliseconds(5)));
+    ForwardTime(std::chrono::milliseconds(5));
+
+    EXPECT_CALL(receiver, ReceiveFrameMock(otherFrame)).With(After(std::chrono::milliseconds(5)));
+    ForwardTime(std::chrono::milliseconds(5));
+}
+
+TEST_F(EthernetLinkSimulatedTest, station_may_transmit_while_receiving)
+{
+    hal::EthernetLinkSimulated link;
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver(link);
+
+    const std::vector<uint8_t> reply{ 5, 6 };
+    sender.TransmitFrame(infra::MakeRange(frame));
+
+    EXPECT_CALL(receiver, ReceiveFrameMock(frame)).WillOnce(testing::Invoke([&](std::vector<uint8_t>)
+        {
+            receiver.TransmitFrame(infra::MakeRange(reply));
+        }));
+    EXPECT_CALL(sender, ReceiveFrameMock(reply));
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetLinkSimulatedTest, lost_frames_are_not_delivered_but_counted)
+{
+    hal::EthernetLinkSimulated link(WithLossProbability(1));
+    testing::StrictMock<EthernetStationSimulatedMock> sender(link);
+    testing::StrictMock<EthernetStationSimulatedMock> receiver(link);
+
+    sender.TransmitFrame(infra::MakeRange(frame));
+    sender.TransmitFrame(infra::MakeRange(frame));
+    ExecuteAllActions();
+
+    EXPECT_EQ(2, link.GetStatistics().framesTransmitted);
+    EXPECT_EQ(2, link.GetStatistics().framesLost);
+}
+
+TEST_F(EthernetLinkSimulatedTest, losses_are_repeatable_for_the_same_seed)
+{
+    auto config = WithLossProbability(0.5);
+    config.seed = 42;
+
+    auto deliveries = [this, &config]()
+    {
+        hal::EthernetLinkSimulated link(config);
+        testing::NiceMock<EthernetStationSimulatedMock> sender(link);
+        testing::NiceMock<EthernetStationSimulatedMock> receiver(link);
+
+        std::vector<bool> delivered;
+        ON_CALL(receiver, ReceiveFrameMock(testing::_)).WillByDefault(testing::Invoke([&delivered](std::vector<uint8_t> frame)
+            {
+                delivered[frame[0]] = true;
+            }));
+
+        for (uint8_t i = 0; i != 32; ++i)
+        {
+            delivered.push_back(false);
+            std::array<uint8_t, 1> data{ i };
+            sender.TransmitFrame(data);
+        }
+
+        ExecuteAllActions();
+        EXPECT_EQ(32, link.GetStatistics().framesTransmitted);
+        EXPECT_EQ(static_cast<uint32_t>(std::count(delivered.begin(), delivered.end(), false)), link.GetStatistics().framesLost);
+        return delivered;
+    };
+
+    auto first = deliveries();
+    EXPECT_EQ(first, deliveries());
+    EXPECT_NE(0, std::count(first.begin(), first.end(), true));
+    EXPECT_NE(0, std::count(first.begin(), first.end(), false));
+}
@@ -0,0 +1,167 @@
+#include "hal/generic/EthernetMacSimulated.hpp"
+#include "infra/timer/test_helper/ClockFixture.hpp"
+#include "gmock/gmock.h"
+#include <algorithm>
+
+namespace
+{
+    class EthernetMacObserverMock
+        : public hal::EthernetMacObserver
+    {
+    public:
+        using hal::EthernetMacObserver::EthernetMacObserver;
+
+        MOCK_METHOD(infra::ByteRange, RequestReceiveBuffer, (), (override));
+        MOCK_METHOD(void, ReceivedFrame, (uint32_t usedBuffers, uint32_t frameSize), (override));
+        MOCK_METHOD(void, ReceivedErrorFrame, (uint32_t usedBuffers, uint32_t frameSize), (override));
+        MOCK_METHOD(void, SentFrame, (), (override));
+    };
+
+    class EthernetStationSimulatedMock
+        : public hal::EthernetStationSimulated
+    {
+    public:
+        using hal::EthernetStationSimulated::EthernetStationSimulated;
+        using hal::EthernetStationSimulated::TransmitFrame;
+
+        void ReceiveFrame(infra::ConstByteRange frame) override
+        {
+            ReceiveFrameMock(std::vector<uint8_t>(frame.begin(), frame.end()));
+        }
+
+        MOCK_METHOD(void, ReceiveFrameMock, (std::vector<uint8_t> frame));
+    };
+}
+
+class EthernetMacSimulatedTest
+    : public testing::Test
+    , public infra::ClockFixture
+{
+public:
+    std::vector<uint8_t> Frame(hal::MacAddress destination, std::size_t size = 20)
+    {
+        std::vector<uint8_t> frame(size, 0);
+        std::copy(destination.begin(), destination.end(), frame.begin());
+        for (std::size_t i = destination.size(); i != size; ++i)
+            frame[i] = static_cast<uint8_t>(i);
+        return frame;
+    }
+
+    void ExpectReceivedInBuffers(const std::vector<uint8_t>& frame, uint32_t buffers)
+    {
+        EXPECT_CALL(observer, RequestReceiveBuffer()).Times(buffers).WillRepeatedly(testing::Invoke([this]()
+            {
+                return infra::ByteRange(receiveBuffer.data(), receiveBuffer.data() + receiveBuffer.size());
+            }));
+        EXPECT_CALL(observer, ReceivedFrame(buffers, static_cast<uint32_t>(frame.size())));
+    }
+
+    const hal::MacAddress macAddress{ 2, 0, 0, 0, 0, 1 };
+    const hal::MacAddress otherMacAddress{ 2, 0, 0, 0, 0, 2 };
+    const hal::MacAddress multicastAddress{ 1, 0, 0x5e, 0, 0, 1 };
+    const hal::MacAddress broadcastAddress{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+    hal::EthernetLinkSimulated link;
+    hal::EthernetMacSimulated mac{ link, macAddress };
+    testing::StrictMock<EthernetMacObserverMock> observer{ mac };
+    testing::StrictMock<EthernetStationSimulatedMock> peer{ link };
+    std::array<uint8_t, 32> receiveBuffer{};
+};
+
+TEST_F(EthernetMacSimulatedTest, frame_addressed_to_mac_is_received)
+{
+    auto frame = Frame(macAddress);
+    peer.TransmitFrame(infra::MakeRange(frame));
+
+    ExpectReceivedInBuffers(frame, 1);
+    ExecuteAllActions();
+
+    EXPECT_TRUE(std::equal(frame.begin(), frame.end(), receiveBuffer.begin()));
+}
+
+TEST_F(EthernetMacSimulatedTest, broadcast_frame_is_received)
+{
+    auto frame = Frame(broadcastAddress);
+    peer.TransmitFrame(infra::MakeRange(frame));
+
+    ExpectReceivedInBuffers(frame, 1);
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetMacSimulatedTest, frame_addressed_to_other_mac_is_dropped)
+{
+    auto frame = Frame(otherMacAddress);
+    peer.TransmitFrame(infra::MakeRange(frame));
+
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetMacSimulatedTest, frame_shorter_than_header_is_dropped)
+{
+    auto frame = Frame(macAddress, 13);
+    peer.TransmitFrame(infra::MakeRange(frame));
+
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetMacSimulatedTest, frame_matching_filter_is_received_until_filter_is_removed)
+{
+    auto frame = Frame(multicastAddress);
+
+    mac.AddMacAddressFilter(multicastAddress);
+    peer.TransmitFrame(infra::MakeRange(frame));
+    ExpectReceivedInBuffers(frame, 1);
+    ExecuteAllActions();
+
+    mac.RemoveMacAddressFilter(multicastAddress);
+    peer.TransmitFrame(infra::MakeRange(frame));
+    ExecuteAllActions();
+}
+
+TEST_F(EthernetMacSimulatedTest, frame_larger_than_buffer_is_received_in_multiple_buffers)
+{
+    auto frame = Frame(macAddress, 80);
+    peer.TransmitFrame(infra::MakeRange(frame));
+
+    std::vector<uint8_t> received;
+    EXPECT_CALL(observer, RequestReceiveBuffer()).Times(3).WillRepeatedly(testing::Invoke([this, &received]()
+        {
+            received.insert(received.end(), receiveBuffer.begin(), receiveBuffer.end());
+            return infra::ByteRange(receiveBuffer.data(), receiveBuffer.data() + receiveBuffer.size());
+        }));
+    EXPECT_CALL(observer, ReceivedFrame(3, 80)).WillOnce(testing::Invoke([this, &received](uint32_t, uint32_t)
+        {
+            received.insert(received.end(), receiveBuffer.begin(), receiveBuffer.end());
+        }));
+    ExecuteAllActions();
+
+    EXPECT_TRUE(std::equal(frame.begin() + 64, frame.end(), received.begin() + 96));
+}
+
+TEST_F(EthernetMacSimulatedTest, received_frames_are_held_until_RetryAllocation_when_no_buffer_is_available)
+{
+    auto frame = Frame(macAddress);
+    auto otherFrame = Frame(broadcastAddress, 30);
+    peer.TransmitFrame(infra::MakeRange(frame));
+    peer.TransmitFrame(infra::MakeRange(otherFrame));
+
+    EXPECT_CALL(observer, RequestReceiveBuffer()).WillOnce(testing::Return(infra::ByteRange()));
+    ExecuteAllActions();
+
+    testing::InSequence s;
+    ExpectReceivedInBuffers(frame, 1);
+    ExpectReceivedInBuffers(otherFrame, 1);
+    mac.RetryAllocation();
+}
+
+TEST_F(EthernetMacSimulatedTest, buffers_sent_are_transmitted_as_one_frame)
+{
+    auto frame = Frame(otherMacAddress);
+
+    mac.SendBuffer(infra::ConstByteRange(frame.data(), frame.data() + 6), false);
+    mac.SendBuffer(infra::ConstByteRange(frame.data() + 6, frame.data() + frame.size()), true);
+
+    EXPECT_CALL(peer, ReceiveFrameMock(frame));
+    EXPECT_CALL(observer, SentFrame());
+    ExecuteAllActions();
+}
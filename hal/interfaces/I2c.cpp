@@ -1,4 +1,5 @@
 #include "hal/interfaces/I2c.hpp"
+#include "infra/util/ReallyAssert.hpp"
 
 namespace hal
 {
@@ -11,4 +12,55 @@ namespace hal
     {
         return !(*this == other);
     }
+
+    I2cTransfer I2cTransfer::Send(infra::ConstByteRange data)
+    {
+        return I2cTransfer{ DataDirection::send, data, infra::ByteRange() };
+    }
+
+    I2cTransfer I2cTransfer::Receive(infra::ByteRange data)
+    {
+        return I2cTransfer{ DataDirection::receive, infra::ConstByteRange(), data };
+    }
+
+    void I2cMaster::ExecuteTransfers(I2cAddress address, infra::MemoryRange<const I2cTransfer> transfers, Action nextAction, const infra::Function<void(Result)>& onDone)
+    {
+        really_assert(!transfers.empty());
+
+        transfersAddress = address;
+        this->transfers = transfers;
+        transfersNextAction = nextAction;
+        onTransfersDone = onDone;
+
+        ExecuteNextTransfer();
+    }
+
+    void I2cMaster::ExecuteNextTransfer()
+    {
+        auto transfer = transfers.front();
+        transfers.pop_front();
+
+        auto action = transfersNextAction;
+        if (!transfers.empty())
+            action = transfers.front().direction == transfer.direction ? Action::continueSession : Action::repeatedStart;
+
+        if (transfer.direction == DataDirection::send)
+            SendData(transfersAddress, transfer.sendData, action, [this](Result result, uint32_t)
+                {
+                    TransferDone(result);
+                });
+        else
+            ReceiveData(transfersAddress, transfer.receiveData, action, [this](Result result)
+                {
+                    TransferDone(result);
+                });
+    }
+
+    void I2cMaster::TransferDone(Result result)
+    {
+        if (result != Result::complete || transfers.empty())
+            onTransfersDone(result);
+        else
+            ExecuteNextTransfer();
+    }
 }
@@ -1,6 +1,7 @@
 #ifndef HAL_I2C_HPP
 #define HAL_I2C_HPP
 
+#include "infra/util/AutoResetFunction.hpp"
 #include "infra/util/ByteRange.hpp"
 #include "infra/util/Function.hpp"
 
@@ -39,6 +40,16 @@ namespace hal
         uint16_t address;
     };
 
+    struct I2cTransfer
+    {
+        static I2cTransfer Send(infra::ConstByteRange data);
+        static I2cTransfer Receive(infra::ByteRange data);
+
+        DataDirection direction = DataDirection::send;
+        infra::ConstByteRange sendData;
+        infra::ByteRange receiveData;
+    };
+
     class I2cErrorPolicy
     {
     protected:
@@ -68,6 +79,23 @@ namespace hal
         virtual void ReceiveData(I2cAddress address, infra::ByteRange data, Action nextAction, infra::Function<void(Result)> onReceived) = 0;
         virtual void SetErrorPolicy(I2cErrorPolicy& policy) = 0;
         virtual void ResetErrorPolicy() = 0;
+
+        // Executes a chain of transfers to one address, and invokes onDone once after the last transfer; nextAction
+        // applies to the last transfer. Consecutive transfers in the same direction continue the session, a change of
+        // direction issues a repeated start. A result other than Result::complete ends the chain and is reported to onDone.
+        // The transfers must remain valid until onDone is invoked. The default implementation executes the transfers one
+        // by one with SendData and ReceiveData; a driver that is able to chain transfers overrides it.
+        virtual void ExecuteTransfers(I2cAddress address, infra::MemoryRange<const I2cTransfer> transfers, Action nextAction, const infra::Function<void(Result)>& onDone);
+
+    private:
+        void ExecuteNextTransfer();
+        void TransferDone(Result result);
+
+    private:
+        I2cAddress transfersAddress{ 0 };
+        infra::MemoryRange<const I2cTransfer> transfers;
+        Action transfersNextAction = Action::stop;
+        infra::AutoResetFunction<void(Result)> onTransfersDone;
     };
 
     class I2cSlave
@@ -11,17 +11,13 @@ namespace hal
     template<class T>
     void I2cMasterRegisterAccess<T>::ReadRegister(T dataRegister, infra::ByteRange data, const infra::Function<void()>& onDone)
     {
-
         this->dataRegister = dataRegister;
-        this->readData = data;
         this->onDone = onDone;
 
-        i2cMaster.SendData(address, infra::MakeByteRange(this->dataRegister), hal::Action::repeatedStart, [this](hal::Result, uint32_t numberOfBytesSent)
+        transfers = { I2cTransfer::Send(infra::MakeByteRange(this->dataRegister)), I2cTransfer::Receive(data) };
+        i2cMaster.ExecuteTransfers(address, transfers, hal::Action::stop, [this](hal::Result)
             {
-                i2cMaster.ReceiveData(address, readData, hal::Action::stop, [this](hal::Result)
-                    {
-                        this->onDone();
-                    });
+                this->onDone();
             });
     }
 
@@ -29,15 +25,12 @@ namespace hal
     void I2cMasterRegisterAccess<T>::WriteRegister(T dataRegister, infra::ConstByteRange data, const infra::Function<void()>& onDone)
     {
         this->dataRegister = dataRegister;
-        this->writeData = data;
         this->onDone = onDone;
 
-        i2cMaster.SendData(address, infra::MakeByteRange(this->dataRegister), hal::Action::continueSession, [this](hal::Result, uint32_t)
+        transfers = { I2cTransfer::Send(infra::MakeByteRange(this->dataRegister)), I2cTransfer::Send(data) };
+        i2cMaster.ExecuteTransfers(address, transfers, hal::Action::stop, [this](hal::Result)
             {
-                i2cMaster.SendData(address, writeData, hal::Action::stop, [this](hal::Result, uint32_t)
-                    {
-                        this->onDone();
-                    });
+                this->onDone();
             });
     }
 
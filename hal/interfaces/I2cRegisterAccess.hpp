@@ -3,6 +3,7 @@
 
 #include "hal/interfaces/I2c.hpp"
 #include "infra/util/WithStorage.hpp"
+#include <array>
 
 namespace hal
 {
@@ -27,8 +28,7 @@ namespace hal
         I2cAddress address;
 
         T dataRegister = 0;
-        infra::ByteRange readData;
-        infra::ConstByteRange writeData;
+        std::array<I2cTransfer, 2> transfers;
         infra::Function<void()> onDone;
     };
 }
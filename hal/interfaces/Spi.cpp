@@ -1,4 +1,5 @@
 #include "hal/interfaces/Spi.hpp"
+#include "infra/util/ReallyAssert.hpp"
 
 namespace hal
 {
@@ -11,4 +12,29 @@ namespace hal
     {
         SendAndReceive(infra::ConstByteRange(), data, nextAction, onDone);
     }
+
+    void SpiMaster::ExecuteTransfers(infra::MemoryRange<const SpiTransfer> transfers, SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        really_assert(!transfers.empty());
+
+        this->transfers = transfers;
+        transfersNextAction = nextAction;
+        onTransfersDone = onDone;
+
+        ExecuteNextTransfer();
+    }
+
+    void SpiMaster::ExecuteNextTransfer()
+    {
+        auto transfer = transfers.front();
+        transfers.pop_front();
+
+        SendAndReceive(transfer.sendData, transfer.receiveData, transfers.empty() ? transfersNextAction : continueSession, [this]()
+            {
+                if (transfers.empty())
+                    onTransfersDone();
+                else
+                    ExecuteNextTransfer();
+            });
+    }
 }
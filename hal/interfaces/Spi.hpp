@@ -2,6 +2,7 @@
 #define HAL_SPI_HPP
 
 #include "hal/interfaces/CommunicationConfigurator.hpp"
+#include "infra/util/AutoResetFunction.hpp"
 #include "infra/util/ByteRange.hpp"
 #include "infra/util/Function.hpp"
 #include "infra/util/Observer.hpp"
@@ -27,6 +28,12 @@ namespace hal
         virtual void EndSession() = 0;
     };
 
+    struct SpiTransfer
+    {
+        infra::ConstByteRange sendData;
+        infra::ByteRange receiveData;
+    };
+
     class SpiMaster
     {
     protected:
@@ -42,6 +49,20 @@ namespace hal
         virtual void SetChipSelectConfigurator(ChipSelectConfigurator& configurator) = 0;
         virtual void SetCommunicationConfigurator(CommunicationConfigurator& configurator) = 0;
         virtual void ResetCommunicationConfigurator() = 0;
+
+        // Executes a chain of transfers within one session, and invokes onDone once after the last transfer; nextAction
+        // applies to the last transfer. The transfers must remain valid until onDone is invoked. The default
+        // implementation executes the transfers one by one with SendAndReceive; a driver that is able to chain
+        // transfers, for instance with linked DMA descriptors, overrides it.
+        virtual void ExecuteTransfers(infra::MemoryRange<const SpiTransfer> transfers, SpiAction nextAction, const infra::Function<void()>& onDone);
+
+    private:
+        void ExecuteNextTransfer();
+
+    private:
+        infra::MemoryRange<const SpiTransfer> transfers;
+        SpiAction transfersNextAction = stop;
+        infra::AutoResetFunction<void()> onTransfersDone;
     };
 
     class ChipSelectObserver
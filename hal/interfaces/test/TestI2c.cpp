@@ -0,0 +1,57 @@
+#include "hal/interfaces/I2c.hpp"
+#include "hal/interfaces/test_doubles/I2cMock.hpp"
+#include "infra/util/test_helper/MockCallback.hpp"
+#include "gmock/gmock.h"
+#include <array>
+#include <vector>
+
+class I2cMasterTest
+    : public testing::Test
+{
+public:
+    const hal::I2cAddress address{ 0x5a };
+};
+
+TEST_F(I2cMasterTest, ExecuteTransfers_continues_session_in_same_direction_and_restarts_on_direction_change)
+{
+    testing::StrictMock<hal::I2cMasterMock> i2c;
+
+    std::array<uint8_t, 1> registerAddress{ 3 };
+    std::array<uint8_t, 2> payload{ 4, 5 };
+    std::array<uint8_t, 2> receiveBuffer{};
+    std::array<hal::I2cTransfer, 3> transfers{ hal::I2cTransfer::Send(infra::MakeByteRange(registerAddress)), hal::I2cTransfer::Send(infra::MakeByteRange(payload)), hal::I2cTransfer::Receive(infra::MakeByteRange(receiveBuffer)) };
+
+    testing::InSequence sequence;
+    EXPECT_CALL(i2c, SendDataMock(address, hal::Action::continueSession, std::vector<uint8_t>{ 3 }));
+    EXPECT_CALL(i2c, SendDataMock(address, hal::Action::repeatedStart, std::vector<uint8_t>{ 4, 5 }));
+    EXPECT_CALL(i2c, ReceiveDataMock(address, hal::Action::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 6, 7 }));
+
+    infra::MockCallback<void(hal::Result)> onDone;
+    EXPECT_CALL(onDone, callback(hal::Result::complete));
+    i2c.ExecuteTransfers(address, transfers, hal::Action::stop, [&onDone](hal::Result result)
+        {
+            onDone.callback(result);
+        });
+
+    EXPECT_EQ((std::array<uint8_t, 2>{ 6, 7 }), receiveBuffer);
+}
+
+TEST_F(I2cMasterTest, ExecuteTransfers_stops_chain_on_failed_transfer)
+{
+    testing::StrictMock<hal::I2cMasterMockWithoutAutomaticDone> i2c;
+
+    std::array<uint8_t, 1> registerAddress{ 3 };
+    std::array<uint8_t, 2> receiveBuffer{};
+    std::array<hal::I2cTransfer, 2> transfers{ hal::I2cTransfer::Send(infra::MakeByteRange(registerAddress)), hal::I2cTransfer::Receive(infra::MakeByteRange(receiveBuffer)) };
+
+    EXPECT_CALL(i2c, SendDataMock(address, hal::Action::repeatedStart, std::vector<uint8_t>{ 3 }));
+
+    infra::MockCallback<void(hal::Result)> onDone;
+    i2c.ExecuteTransfers(address, transfers, hal::Action::stop, [&onDone](hal::Result result)
+        {
+            onDone.callback(result);
+        });
+
+    EXPECT_CALL(onDone, callback(hal::Result::busError));
+    i2c.onSent(hal::Result::busError, 0);
+}
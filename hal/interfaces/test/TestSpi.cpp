@@ -0,0 +1,53 @@
+#include "hal/interfaces/Spi.hpp"
+#include "hal/interfaces/test_doubles/SpiMock.hpp"
+#include "infra/event/test_helper/EventDispatcherFixture.hpp"
+#include "infra/util/test_helper/MockCallback.hpp"
+#include "gmock/gmock.h"
+#include <array>
+#include <vector>
+
+class SpiMasterTest
+    : public testing::Test
+    , public infra::EventDispatcherFixture
+{
+public:
+    testing::StrictMock<hal::SpiMock> spi;
+};
+
+TEST_F(SpiMasterTest, ExecuteTransfers_continues_session_until_last_transfer)
+{
+    std::array<uint8_t, 2> command{ 1, 2 };
+    std::array<uint8_t, 2> receiveBuffer{};
+    std::array<hal::SpiTransfer, 2> transfers{ { { infra::MakeByteRange(command), infra::ByteRange() }, { infra::ConstByteRange(), infra::MakeByteRange(receiveBuffer) } } };
+
+    testing::InSequence sequence;
+    EXPECT_CALL(spi, SendDataMock(std::vector<uint8_t>{ 1, 2 }, hal::SpiAction::continueSession));
+    EXPECT_CALL(spi, ReceiveDataMock(hal::SpiAction::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 3, 4 }));
+
+    infra::MockCallback<void()> onDone;
+    spi.ExecuteTransfers(transfers, hal::SpiAction::stop, [&onDone]()
+        {
+            onDone.callback();
+        });
+
+    EXPECT_CALL(onDone, callback());
+    ExecuteAllActions();
+    EXPECT_EQ((std::array<uint8_t, 2>{ 3, 4 }), receiveBuffer);
+}
+
+TEST_F(SpiMasterTest, ExecuteTransfers_applies_next_action_to_last_transfer)
+{
+    std::array<uint8_t, 1> command{ 1 };
+    std::array<hal::SpiTransfer, 1> transfers{ { { infra::MakeByteRange(command), infra::ByteRange() } } };
+
+    EXPECT_CALL(spi, SendDataMock(std::vector<uint8_t>{ 1 }, hal::SpiAction::continueSession));
+
+    infra::MockCallback<void()> onDone;
+    spi.ExecuteTransfers(transfers, hal::SpiAction::continueSession, [&onDone]()
+        {
+            onDone.callback();
+        });
+
+    EXPECT_CALL(onDone, callback());
+    ExecuteAllActions();
+}
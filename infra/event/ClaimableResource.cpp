@@ -4,6 +4,12 @@
 
 namespace infra
 {
+    ClaimableResource::ClaimableResource(const Config& config)
+        : config(config)
+        , directHandoffsRemaining(config.directHandoffBudget)
+        , batchedClaimsRemaining(config.batchBudget)
+    {}
+
     ClaimableResource::~ClaimableResource()
     {
         assert(currentClaim == nullptr);
@@ -15,15 +21,64 @@ namespace infra
         return !pendingClaims.empty();
     }
 
+    ClaimableResource::Statistics ClaimableResource::GetStatistics() const
+    {
+        return statistics;
+    }
+
     void ClaimableResource::ReEvaluateClaim()
     {
         reEvaluateClaimScheduled = false;
+        directHandoffsRemaining = config.directHandoffBudget;
 
         if (currentClaim == nullptr && !pendingClaims.empty())
+            GrantNextClaim();
+    }
+
+    void ClaimableResource::GrantNextClaim()
+    {
+        currentClaim = &NextClaim();
+        pendingClaims.erase(*currentClaim);
+        RecordWaitTime(*currentClaim);
+        currentClaim->ClaimGranted();
+    }
+
+    ClaimableResource::ClaimerBase& ClaimableResource::NextClaim()
+    {
+        auto& first = pendingClaims.front();
+
+        if (lastBatchKey != std::nullopt && !first.isUrgent && first.batchKey != lastBatchKey && batchedClaimsRemaining != 0)
+            for (auto& claimer : pendingClaims)
+            {
+                if (claimer.priority != first.priority)
+                    break;
+
+                if (claimer.batchKey == lastBatchKey)
+                {
+                    --batchedClaimsRemaining;
+                    ++statistics.batchedClaims;
+                    return claimer;
+                }
+            }
+
+        batchedClaimsRemaining = config.batchBudget;
+        return first;
+    }
+
+    void ClaimableResource::RecordWaitTime(const ClaimerBase& claimer)
+    {
+        if (config.timestamp)
         {
-            currentClaim = &pendingClaims.front();
-            pendingClaims.pop_front();
-            currentClaim->ClaimGranted();
+            auto waitTime = config.timestamp() - claimer.claimedAt;
+
+            std::size_t bucket = 0;
+            while (waitTime != 0 && bucket != waitTimeBuckets - 1)
+            {
+                waitTime >>= 1;
+                ++bucket;
+            }
+
+            ++statistics.waitTimeHistogram[bucket];
         }
     }
 
@@ -40,7 +95,16 @@ namespace infra
         if (currentClaim == &claimer)
         {
             currentClaim = nullptr;
-            ScheduleReEvaluateClaim();
+            lastBatchKey = !pendingClaims.empty() ? claimer.batchKey : std::nullopt;
+
+            if (directHandoffsRemaining != 0 && !pendingClaims.empty())
+            {
+                --directHandoffsRemaining;
+                ++statistics.directHandoffs;
+                GrantNextClaim();
+            }
+            else
+                ScheduleReEvaluateClaim();
         }
         else if (!pendingClaims.empty())
             DequeueClaimer(claimer);
@@ -62,10 +126,23 @@ namespace infra
 
     void ClaimableResource::EnqueueClaimer(ClaimerBase& claimer, bool urgent)
     {
+        if (config.timestamp)
+            claimer.claimedAt = config.timestamp();
+
+        claimer.isUrgent = urgent;
+
         if (urgent)
             pendingClaims.push_front(claimer);
-        else
+        else if (pendingClaims.empty() || pendingClaims.back().isUrgent || pendingClaims.back().priority >= claimer.priority)
             pendingClaims.push_back(claimer);
+        else
+        {
+            auto index = pendingClaims.begin();
+            while (index->isUrgent || index->priority >= claimer.priority)
+                ++index;
+
+            pendingClaims.insert(index, claimer);
+        }
     }
 
     void ClaimableResource::DequeueClaimer(ClaimerBase& claimer)
@@ -85,14 +162,19 @@ namespace infra
         }
     }
 
-    ClaimableResource::ClaimerBase::ClaimerBase(ClaimableResource& resource)
+    ClaimableResource::ClaimerBase::ClaimerBase(ClaimableResource& resource, uint8_t priority)
         : resource(resource)
+        , priority(priority)
     {}
 
     ClaimableResource::ClaimerBase::ClaimerBase(ClaimerBase&& other) noexcept
         : resource(other.resource)
+        , priority(other.priority)
         , isGranted(other.isGranted)
         , isQueued(other.isQueued)
+        , isUrgent(other.isUrgent)
+        , batchKey(other.batchKey)
+        , claimedAt(other.claimedAt)
     {
         other.isGranted = false;
         other.isQueued = false;
@@ -106,8 +188,12 @@ namespace infra
         assert(&resource == &other.resource);
         ReleaseAllClaims();
 
+        priority = other.priority;
         isGranted = other.isGranted;
         isQueued = other.isQueued;
+        isUrgent = other.isUrgent;
+        batchKey = other.batchKey;
+        claimedAt = other.claimedAt;
 
         other.isGranted = false;
         other.isQueued = false;
@@ -142,6 +228,11 @@ namespace infra
         return isQueued;
     }
 
+    void ClaimableResource::ClaimerBase::SetBatchKey(std::optional<uintptr_t> key)
+    {
+        batchKey = key;
+    }
+
     void ClaimableResource::ClaimerBase::ReleaseAllClaims()
     {
         if (isGranted)
@@ -4,10 +4,19 @@
 #include "infra/util/AutoResetFunction.hpp"
 #include "infra/util/IntrusiveList.hpp"
 #include "infra/util/ReallyAssert.hpp"
+#include <array>
 #include <cstdint>
+#include <optional>
 
 namespace infra
 {
+    // By default, when a claim is released the next claim is granted from a new event, so that other actions on the
+    // event dispatcher get the chance to run in between. With Config::directHandoffBudget, the next claim is instead
+    // granted from within Release, up to that many times in a row before a new event is used again.
+    //
+    // A claimer may be given a batch key. With Config::batchBudget, after a claim is released, a pending claim with
+    // the same batch key and the same priority as the first pending claim is granted before that first claim, up
+    // to that many times in a row, unless that first claim is urgent. Bus masters use this to execute transfers to the same device back-to-back.
     class ClaimableResource
     {
     private:
@@ -20,15 +29,40 @@ namespace infra
     public:
         using Claimer = ClaimerWithSize<INFRA_DEFAULT_FUNCTION_EXTRA_SIZE>;
 
-        ClaimableResource() = default;
+        static constexpr std::size_t waitTimeBuckets = 16;
+
+        struct Config
+        {
+            Config() {}
+
+            uint8_t directHandoffBudget = 0;
+            uint8_t batchBudget = 0;
+            // When set, the time that claims wait before they are granted is measured
+            infra::Function<uint32_t()> timestamp;
+        };
+
+        struct Statistics
+        {
+            // Bucket 0 counts waits of 0, and bucket n counts waits of [2^(n-1), 2^n) in units of Config::timestamp;
+            // the last bucket also counts all longer waits
+            std::array<uint32_t, waitTimeBuckets> waitTimeHistogram{};
+            uint32_t directHandoffs = 0;
+            uint32_t batchedClaims = 0;
+        };
+
+        explicit ClaimableResource(const Config& config = Config());
         ClaimableResource(const ClaimableResource& other) = delete;
         ClaimableResource& operator=(const ClaimableResource& other) = delete;
         ~ClaimableResource();
 
         bool ClaimsPending() const;
+        Statistics GetStatistics() const;
 
     private:
         void ReEvaluateClaim();
+        void GrantNextClaim();
+        ClaimerBase& NextClaim();
+        void RecordWaitTime(const ClaimerBase& claimer);
         void AddClaim(ClaimerBase& claimer, bool urgent);
         void RemoveClaim(ClaimerBase& claimer);
         void ReplaceClaim(ClaimerBase& claimerOld, ClaimerBase& claimerNew);
@@ -40,13 +74,20 @@ namespace infra
         infra::IntrusiveList<ClaimerBase> pendingClaims;
         ClaimerBase* currentClaim = nullptr;
         bool reEvaluateClaimScheduled = false;
+        Config config;
+        Statistics statistics;
+        uint8_t directHandoffsRemaining;
+        uint8_t batchedClaimsRemaining;
+        std::optional<uintptr_t> lastBatchKey;
     };
 
     class ClaimableResource::ClaimerBase
         : public infra::IntrusiveList<ClaimerBase>::NodeType
     {
     public:
-        explicit ClaimerBase(ClaimableResource& resource);
+        // Non-urgent claims of claimers with a higher priority are granted before those of claimers with a lower priority;
+        // urgent claims are granted before all non-urgent claims, regardless of priority
+        explicit ClaimerBase(ClaimableResource& resource, uint8_t priority = 0);
         ClaimerBase(const ClaimerBase& other) = delete;
         ClaimerBase& operator=(const ClaimerBase& other) = delete;
         ClaimerBase(ClaimerBase&& other) noexcept;
@@ -60,6 +101,9 @@ namespace infra
         bool IsClaimed() const;
         bool IsQueued() const;
 
+        // Takes effect for the next claim
+        void SetBatchKey(std::optional<uintptr_t> key);
+
     private:
         friend class ClaimableResource;
 
@@ -69,8 +113,12 @@ namespace infra
 
     private:
         ClaimableResource& resource;
+        uint8_t priority;
         bool isGranted = false;
         bool isQueued = false;
+        bool isUrgent = false;
+        std::optional<uintptr_t> batchKey;
+        uint32_t claimedAt = 0;
     };
 
     template<std::size_t ExtraSize>
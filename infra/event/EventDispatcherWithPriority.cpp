@@ -0,0 +1,174 @@
+#include "infra/event/EventDispatcherWithPriority.hpp"
+#include "infra/util/ReallyAssert.hpp"
+#include <algorithm>
+
+namespace infra
+{
+    EventDispatcherWithPriorityWorker::EventDispatcherWithPriorityWorker(MemoryRange<ScheduledAction> scheduledActionsStorage, const Config& config)
+        : config(config)
+    {
+        auto laneSize = scheduledActionsStorage.size() / numberOfPriorities;
+        really_assert(laneSize != 0);
+
+        for (auto& lane : lanes)
+        {
+            lane.scheduledActions = infra::Head(scheduledActionsStorage, laneSize);
+            lane.minCapacity = laneSize;
+            scheduledActionsStorage.pop_front(laneSize);
+
+            for (auto& action : lane.scheduledActions)
+                action.present = false;
+        }
+    }
+
+    void EventDispatcherWithPriorityWorker::Schedule(const infra::Function<void()>& action)
+    {
+        Schedule(action, Priority::normal);
+    }
+
+    void EventDispatcherWithPriorityWorker::Schedule(const infra::Function<void()>& action, Priority priority)
+    {
+        auto& lane = lanes[static_cast<std::size_t>(priority)];
+        uint32_t pushIndex = lane.pushIndex;
+        uint32_t newPushIndex;
+
+        do
+        {
+            newPushIndex = (pushIndex + 1) % lane.scheduledActions.size();
+        } while (!lane.pushIndex.compare_exchange_weak(pushIndex, newPushIndex));
+
+        auto& scheduledAction = lane.scheduledActions[pushIndex];
+        scheduledAction.action = action;
+        scheduledAction.scheduledAt = config.timestamp ? config.timestamp() : 0;
+        really_assert(!scheduledAction.present);
+        scheduledAction.present = true;
+
+        lane.minCapacity = std::min<std::size_t>(lane.minCapacity, (lane.scheduledActions.size() + lane.popIndex - pushIndex - 1) % lane.scheduledActions.size() + 1);
+        really_assert(lane.minCapacity >= 1);
+
+        RequestExecution();
+    }
+
+    void EventDispatcherWithPriorityWorker::Run()
+    {
+        while (true)
+        {
+            ExecuteAllActions();
+            Idle();
+        }
+    }
+
+    void EventDispatcherWithPriorityWorker::ExecuteAllActions()
+    {
+        while (TryExecuteAction())
+        {}
+    }
+
+    void EventDispatcherWithPriorityWorker::ExecuteUntil(const infra::Function<bool()>& predicate)
+    {
+        while (!predicate())
+        {
+            ExecuteAllActions();
+
+            if (predicate())
+                break;
+
+            Idle();
+        }
+    }
+
+    void EventDispatcherWithPriorityWorker::ExecuteFirstAction()
+    {
+        auto lane = NextLane();
+
+        if (lane != nullptr)
+        {
+            struct ExceptionSafePop
+            {
+                ExceptionSafePop(Lane& lane)
+                    : lane(lane)
+                {}
+
+                ExceptionSafePop(const ExceptionSafePop&) = delete;
+                ExceptionSafePop& operator=(const ExceptionSafePop&) = delete;
+
+                ~ExceptionSafePop()
+                {
+                    lane.scheduledActions[lane.popIndex].action = nullptr;
+                    lane.scheduledActions[lane.popIndex].present = false;
+                    lane.popIndex = (lane.popIndex + 1) % lane.scheduledActions.size();
+                }
+
+                Lane& lane;
+            };
+
+            if (config.timestamp)
+            {
+                auto& maxQueueingDelay = statistics.maxQueueingDelay[lane - lanes.data()];
+                maxQueueingDelay = std::max(maxQueueingDelay, config.timestamp() - lane->scheduledActions[lane->popIndex].scheduledAt);
+            }
+
+            ExceptionSafePop popAction{ *lane };
+
+            lane->scheduledActions[lane->popIndex].action();
+        }
+    }
+
+    bool EventDispatcherWithPriorityWorker::IsIdle() const
+    {
+        return std::none_of(lanes.begin(), lanes.end(), [](const Lane& lane)
+            {
+                return lane.scheduledActions[lane.popIndex].present.load();
+            });
+    }
+
+    std::size_t EventDispatcherWithPriorityWorker::MinCapacity() const
+    {
+        return std::min_element(lanes.begin(), lanes.end(), [](const Lane& x, const Lane& y)
+            {
+                return x.minCapacity < y.minCapacity;
+            })
+            ->minCapacity;
+    }
+
+    EventDispatcherWithPriorityWorker::Statistics EventDispatcherWithPriorityWorker::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void EventDispatcherWithPriorityWorker::RequestExecution()
+    {}
+
+    void EventDispatcherWithPriorityWorker::Idle()
+    {}
+
+    EventDispatcherWithPriorityWorker::Lane* EventDispatcherWithPriorityWorker::NextLane()
+    {
+        if (config.timestamp)
+            for (std::size_t priority = 0; priority != numberOfPriorities; ++priority)
+                if (DeadlinePassed(lanes[priority], priority))
+                    return &lanes[priority];
+
+        for (auto& lane : lanes)
+            if (lane.scheduledActions[lane.popIndex].present)
+                return &lane;
+
+        return nullptr;
+    }
+
+    bool EventDispatcherWithPriorityWorker::DeadlinePassed(const Lane& lane, std::size_t priority) const
+    {
+        const auto& scheduledAction = lane.scheduledActions[lane.popIndex];
+
+        return config.deadlines[priority] != 0 && scheduledAction.present && config.timestamp() - scheduledAction.scheduledAt > config.deadlines[priority];
+    }
+
+    bool EventDispatcherWithPriorityWorker::TryExecuteAction()
+    {
+        if (IsIdle())
+            return false;
+
+        ExecuteFirstAction();
+        return true;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef INFRA_EVENT_DISPATCHER_WITH_PRIORITY_HPP
+#define INFRA_EVENT_DISPATCHER_WITH_PRIORITY_HPP
+
+#include "infra/event/EventDispatcher.hpp"
+#include <array>
+#include <atomic>
+
+namespace infra
+{
+    // EventDispatcherWithPriorityWorker keeps a separate ring of scheduled actions for each priority, so that a burst of
+    // low priority work does not delay latency-critical actions. Like EventDispatcherWorkerImpl, actions may be scheduled
+    // from interrupts. Schedule without a priority schedules with Priority::normal.
+    //
+    // When a timestamp function is configured, e.g. reading a free-running cycle counter, the maximum time that actions
+    // waited in each lane is measured. A lane may then also be given a deadline: when the oldest action of that lane
+    // waited longer than its deadline, it is executed before actions of higher priority, so that it is not starved.
+    class EventDispatcherWithPriorityWorker
+        : public EventDispatcherWorker
+    {
+    public:
+        enum class Priority : uint8_t
+        {
+            high,
+            normal,
+            low
+        };
+
+        static constexpr std::size_t numberOfPriorities = 3;
+
+        struct ScheduledAction
+        {
+            infra::Function<void()> action;
+            uint32_t scheduledAt = 0;
+            std::atomic<bool> present{ false };
+        };
+
+        struct Config
+        {
+            Config() {}
+
+            // Invoked from Schedule, so it must be callable from interrupts
+            infra::Function<uint32_t()> timestamp;
+            // In units of timestamp, indexed by Priority; 0 means that the lane has no deadline
+            std::array<uint32_t, numberOfPriorities> deadlines{};
+        };
+
+        struct Statistics
+        {
+            // In units of timestamp, indexed by Priority
+            std::array<uint32_t, numberOfPriorities> maxQueueingDelay{};
+        };
+
+        template<std::size_t StorageSizePerPriority, class T = EventDispatcherWithPriorityWorker>
+        using WithSize = infra::WithStorage<T, std::array<ScheduledAction, StorageSizePerPriority * numberOfPriorities>>;
+
+        explicit EventDispatcherWithPriorityWorker(MemoryRange<ScheduledAction> scheduledActionsStorage, const Config& config = Config());
+
+        void Schedule(const infra::Function<void()>& action) override;
+        void Schedule(const infra::Function<void()>& action, Priority priority);
+        void ExecuteFirstAction() override;
+        void ExecuteUntil(const infra::Function<bool()>& predicate) override;
+        std::size_t MinCapacity() const override;
+        bool IsIdle() const override;
+
+        void Run();
+        void ExecuteAllActions();
+
+        Statistics GetStatistics() const;
+
+    protected:
+        virtual void RequestExecution();
+        virtual void Idle();
+
+    private:
+        struct Lane
+        {
+            infra::MemoryRange<ScheduledAction> scheduledActions;
+            std::atomic<uint32_t> pushIndex{ 0 };
+            uint32_t popIndex = 0;
+            std::size_t minCapacity = 0;
+        };
+
+        Lane* NextLane();
+        bool DeadlinePassed(const Lane& lane, std::size_t priority) const;
+        bool TryExecuteAction();
+
+    private:
+        std::array<Lane, numberOfPriorities> lanes;
+        Config config;
+        Statistics statistics;
+    };
+
+    template<class T>
+    class EventDispatcherWithPriorityConnector
+        : public infra::InterfaceConnector<EventDispatcherWorker>
+        , public infra::InterfaceConnector<EventDispatcherWithPriorityWorker>
+        , public T
+    {
+    public:
+        using infra::InterfaceConnector<EventDispatcherWithPriorityWorker>::Instance;
+
+        template<std::size_t StorageSizePerPriority>
+        using WithSize = typename T::template WithSize<StorageSizePerPriority, EventDispatcherWithPriorityConnector<T>>;
+
+        template<class... ConstructionArgs>
+        explicit EventDispatcherWithPriorityConnector(MemoryRange<EventDispatcherWithPriorityWorker::ScheduledAction> scheduledActionsStorage, ConstructionArgs&&... args);
+    };
+
+    using EventDispatcherWithPriority = EventDispatcherWithPriorityConnector<EventDispatcherWithPriorityWorker>;
+
+    ////    Implementation    ////
+
+    template<class T>
+    template<class... ConstructionArgs>
+    EventDispatcherWithPriorityConnector<T>::EventDispatcherWithPriorityConnector(MemoryRange<EventDispatcherWithPriorityWorker::ScheduledAction> scheduledActionsStorage, ConstructionArgs&&... args)
+        : infra::InterfaceConnector<EventDispatcherWorker>(this)
+        , infra::InterfaceConnector<EventDispatcherWithPriorityWorker>(this)
+        , T(scheduledActionsStorage, std::forward<ConstructionArgs>(args)...)
+    {}
+}
+
+#endif
@@ -163,6 +163,67 @@ TEST_F(TestClaimableResource, ClaimUrgentTakesPrecedence)
     EXPECT_EQ(1, claimerB.claimsGranted);
 }
 
+TEST_F(TestClaimableResource, ClaimOfHigherPriorityClaimerTakesPrecedence)
+{
+    TestClaimer claimerHigh(resource, 1);
+
+    claimerA.Claim([this]()
+        {
+            claimerA.GrantedClaim();
+        });
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerA.claimsGranted);
+
+    claimerB.Claim([this]()
+        {
+            claimerB.GrantedClaim();
+        });
+    claimerHigh.Claim([&claimerHigh]()
+        {
+            claimerHigh.GrantedClaim();
+        });
+
+    claimerA.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerHigh.claimsGranted);
+    EXPECT_EQ(0, claimerB.claimsGranted);
+
+    claimerHigh.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerB.claimsGranted);
+    claimerB.Release();
+}
+
+TEST_F(TestClaimableResource, ClaimUrgentTakesPrecedenceOverLaterClaimOfHigherPriorityClaimer)
+{
+    TestClaimer claimerHigh(resource, 1);
+
+    claimerA.Claim([this]()
+        {
+            claimerA.GrantedClaim();
+        });
+    ExecuteAllActions();
+
+    claimerB.ClaimUrgent([this]()
+        {
+            claimerB.GrantedClaim();
+        });
+    claimerHigh.Claim([&claimerHigh]()
+        {
+            claimerHigh.GrantedClaim();
+        });
+
+    claimerA.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerB.claimsGranted);
+    EXPECT_EQ(0, claimerHigh.claimsGranted);
+
+    claimerB.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerHigh.claimsGranted);
+    claimerHigh.Release();
+}
+
 TEST_F(TestClaimableResource, TwoConsecutiveReleasesBeforeReleaseOfClaimIsProcessedResultsInNoAdditionalClaimsGranted)
 {
     claimerA.Claim([this]()
@@ -258,3 +319,153 @@ TEST_F(TestClaimableResource, CopyMoveClaimerAfterGranted)
 
     newClaimer.Release();
 }
+
+class TestClaimableResourceWithConfig
+    : public testing::Test
+    , public infra::EventDispatcherFixture
+{
+public:
+    static infra::ClaimableResource::Config MakeConfig(uint8_t directHandoffBudget, uint8_t batchBudget)
+    {
+        infra::ClaimableResource::Config config;
+        config.directHandoffBudget = directHandoffBudget;
+        config.batchBudget = batchBudget;
+        return config;
+    }
+
+    void Claim(TestClaimer& claimer)
+    {
+        claimer.Claim([&claimer]()
+            {
+                claimer.GrantedClaim();
+            });
+    }
+};
+
+TEST_F(TestClaimableResourceWithConfig, next_claim_is_granted_directly_on_release)
+{
+    infra::ClaimableResource resource(MakeConfig(1, 0));
+    TestClaimer claimerA(resource);
+    TestClaimer claimerB(resource);
+
+    Claim(claimerA);
+    Claim(claimerB);
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerA.claimsGranted);
+
+    claimerA.Release();
+    EXPECT_EQ(1, claimerB.claimsGranted);
+    EXPECT_EQ(1, resource.GetStatistics().directHandoffs);
+
+    claimerB.Release();
+}
+
+TEST_F(TestClaimableResourceWithConfig, direct_handoffs_are_limited_by_budget)
+{
+    infra::ClaimableResource resource(MakeConfig(1, 0));
+    TestClaimer claimerA(resource);
+    TestClaimer claimerB(resource);
+    TestClaimer claimerC(resource);
+
+    Claim(claimerA);
+    Claim(claimerB);
+    Claim(claimerC);
+    ExecuteAllActions();
+
+    claimerA.Release();
+    EXPECT_EQ(1, claimerB.claimsGranted);
+
+    claimerB.Release();
+    EXPECT_EQ(0, claimerC.claimsGranted);
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerC.claimsGranted);
+
+    claimerC.Release();
+}
+
+TEST_F(TestClaimableResourceWithConfig, claims_with_the_same_batch_key_are_granted_back_to_back)
+{
+    infra::ClaimableResource resource(MakeConfig(0, 1));
+    TestClaimer claimerA(resource);
+    TestClaimer claimerB(resource);
+    TestClaimer claimerC(resource);
+    claimerA.SetBatchKey(1);
+    claimerC.SetBatchKey(1);
+
+    Claim(claimerA);
+    ExecuteAllActions();
+    Claim(claimerB);
+    Claim(claimerC);
+
+    claimerA.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(0, claimerB.claimsGranted);
+    EXPECT_EQ(1, claimerC.claimsGranted);
+    EXPECT_EQ(1, resource.GetStatistics().batchedClaims);
+
+    Claim(claimerA);
+    claimerC.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerB.claimsGranted);
+    EXPECT_EQ(1, claimerA.claimsGranted);
+
+    claimerB.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(2, claimerA.claimsGranted);
+    claimerA.Release();
+}
+
+TEST_F(TestClaimableResourceWithConfig, claims_with_the_same_batch_key_are_not_granted_before_urgent_claim)
+{
+    infra::ClaimableResource resource(MakeConfig(0, 1));
+    TestClaimer claimerA(resource);
+    TestClaimer claimerB(resource);
+    TestClaimer claimerC(resource);
+    claimerA.SetBatchKey(1);
+    claimerC.SetBatchKey(1);
+
+    Claim(claimerA);
+    ExecuteAllActions();
+    Claim(claimerC);
+    claimerB.ClaimUrgent([&claimerB]()
+        {
+            claimerB.GrantedClaim();
+        });
+
+    claimerA.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerB.claimsGranted);
+    EXPECT_EQ(0, claimerC.claimsGranted);
+    EXPECT_EQ(0, resource.GetStatistics().batchedClaims);
+
+    claimerB.Release();
+    ExecuteAllActions();
+    EXPECT_EQ(1, claimerC.claimsGranted);
+    claimerC.Release();
+}
+
+TEST_F(TestClaimableResourceWithConfig, wait_times_are_recorded_in_histogram)
+{
+    uint32_t now = 0;
+    infra::ClaimableResource::Config config;
+    config.timestamp = [&now]()
+    {
+        return now;
+    };
+    infra::ClaimableResource resource(config);
+    TestClaimer claimerA(resource);
+    TestClaimer claimerB(resource);
+
+    Claim(claimerA);
+    Claim(claimerB);
+    ExecuteAllActions();
+
+    now = 5;
+    claimerA.Release();
+    ExecuteAllActions();
+    claimerB.Release();
+
+    auto statistics = resource.GetStatistics();
+    EXPECT_EQ(1, statistics.waitTimeHistogram[0]);
+    EXPECT_EQ(1, statistics.waitTimeHistogram[3]);
+}
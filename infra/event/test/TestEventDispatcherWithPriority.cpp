@@ -0,0 +1,133 @@
+#include "infra/event/EventDispatcherWithPriority.hpp"
+#include "infra/util/test_helper/MockCallback.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include <string>
+
+class EventDispatcherWithPriorityTest
+    : public testing::Test
+{
+public:
+    using Priority = infra::EventDispatcherWithPriority::Priority;
+
+    infra::Function<void()> Append(char c)
+    {
+        return [this, c]()
+        {
+            executed += c;
+        };
+    }
+
+    std::string executed;
+};
+
+TEST_F(EventDispatcherWithPriorityTest, scheduled_action_is_executed)
+{
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher;
+    infra::MockCallback<void()> callback;
+    EXPECT_CALL(callback, callback());
+
+    infra::EventDispatcher::Instance().Schedule([&callback]()
+        {
+            callback.callback();
+        });
+    eventDispatcher.ExecuteAllActions();
+}
+
+TEST_F(EventDispatcherWithPriorityTest, actions_of_higher_priority_are_executed_first)
+{
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher;
+
+    eventDispatcher.Schedule(Append('l'), Priority::low);
+    eventDispatcher.Schedule(Append('n'));
+    eventDispatcher.Schedule(Append('h'), Priority::high);
+    eventDispatcher.Schedule(Append('L'), Priority::low);
+    eventDispatcher.Schedule(Append('H'), Priority::high);
+
+    eventDispatcher.ExecuteAllActions();
+    EXPECT_EQ("hHnlL", executed);
+    EXPECT_TRUE(eventDispatcher.IsIdle());
+}
+
+TEST_F(EventDispatcherWithPriorityTest, action_of_higher_priority_scheduled_by_action_executes_next)
+{
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher;
+
+    eventDispatcher.Schedule([this, &eventDispatcher]()
+        {
+            executed += 'l';
+            eventDispatcher.Schedule(Append('h'), Priority::high);
+        },
+        Priority::low);
+    eventDispatcher.Schedule(Append('L'), Priority::low);
+
+    eventDispatcher.ExecuteAllActions();
+    EXPECT_EQ("lhL", executed);
+}
+
+TEST_F(EventDispatcherWithPriorityTest, ExecuteFirstAction_executes_one_action)
+{
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher;
+
+    eventDispatcher.Schedule(Append('n'));
+    eventDispatcher.Schedule(Append('h'), Priority::high);
+
+    eventDispatcher.ExecuteFirstAction();
+    EXPECT_EQ("h", executed);
+    EXPECT_FALSE(eventDispatcher.IsIdle());
+}
+
+TEST_F(EventDispatcherWithPriorityTest, MinCapacity_is_minimum_of_lanes)
+{
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher;
+    EXPECT_EQ(4, eventDispatcher.MinCapacity());
+
+    eventDispatcher.Schedule(Append('l'), Priority::low);
+    eventDispatcher.Schedule(Append('l'), Priority::low);
+    eventDispatcher.Schedule(Append('h'), Priority::high);
+    EXPECT_EQ(3, eventDispatcher.MinCapacity());
+}
+
+TEST_F(EventDispatcherWithPriorityTest, maximum_queueing_delay_is_measured_per_lane)
+{
+    uint32_t now = 0;
+    infra::EventDispatcherWithPriority::Config config;
+    config.timestamp = [&now]()
+    {
+        return now;
+    };
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher(config);
+
+    eventDispatcher.Schedule(Append('l'), Priority::low);
+    now = 5;
+    eventDispatcher.Schedule(Append('h'), Priority::high);
+    now = 7;
+    eventDispatcher.ExecuteAllActions();
+
+    auto statistics = eventDispatcher.GetStatistics();
+    EXPECT_EQ(2, statistics.maxQueueingDelay[static_cast<std::size_t>(Priority::high)]);
+    EXPECT_EQ(0, statistics.maxQueueingDelay[static_cast<std::size_t>(Priority::normal)]);
+    EXPECT_EQ(7, statistics.maxQueueingDelay[static_cast<std::size_t>(Priority::low)]);
+}
+
+TEST_F(EventDispatcherWithPriorityTest, action_past_its_deadline_executes_before_higher_priority)
+{
+    uint32_t now = 0;
+    infra::EventDispatcherWithPriority::Config config;
+    config.timestamp = [&now]()
+    {
+        return now;
+    };
+    config.deadlines[static_cast<std::size_t>(Priority::low)] = 10;
+    infra::EventDispatcherWithPriority::WithSize<4> eventDispatcher(config);
+
+    eventDispatcher.Schedule(Append('l'), Priority::low);
+    eventDispatcher.Schedule(Append('h'), Priority::high);
+    eventDispatcher.ExecuteFirstAction();
+    EXPECT_EQ("h", executed);
+
+    eventDispatcher.Schedule(Append('H'), Priority::high);
+    now = 11;
+    eventDispatcher.ExecuteAllActions();
+    EXPECT_EQ("hlH", executed);
+}
@@ -2,72 +2,6 @@
 
 namespace infra
 {
-    FormatSpec::FormatSpec(const char*& format)
-        : format(format)
-    {
-        if (*format != ':')
-            return;
-
-        ++format;
-        ParseAlign();
-        ParseZero();
-        ParseWidth();
-        ParseType();
-    }
-
-    void FormatSpec::ParseAlign()
-    {
-        auto i = (*format == '\0') ? 0 : 1;
-        do
-        {
-            switch (format[i])
-            {
-                case '<':
-                    align = FormatAlign::left;
-                    break;
-                case '^':
-                    align = FormatAlign::center;
-                    break;
-                case '>':
-                    align = FormatAlign::right;
-                    break;
-                default:
-                    break;
-            }
-
-            if (align != FormatAlign::nothing)
-            {
-                if (i == 1)
-                    fill = *format++;
-                ++format;
-                return;
-            }
-        } while (i-- > 0);
-    }
-
-    void FormatSpec::ParseZero()
-    {
-        if (*format != '0')
-            return;
-
-        if (align == FormatAlign::nothing)
-            fill = '0';
-
-        format++;
-    }
-
-    void FormatSpec::ParseWidth()
-    {
-        while (isdigit(*format))
-            width = 10 * width + *format++ - '0';
-    }
-
-    void FormatSpec::ParseType()
-    {
-        if (*format != '}')
-            type = *format++;
-    }
-
     void FormatterBase::RawFormat(TextOutputStream& stream, const BoundedConstString& text, const FormatSpec& spec) const
     {
         auto width = std::max(spec.width, text.size());
@@ -214,7 +148,7 @@ namespace infra
         RawFormat(stream, str, spec);
     }
 
-    FormatWorker::FormatWorker(TextOutputStream& stream, const char* formatStr, std::vector<FormatterBase*>& formatters)
+    FormatWorker::FormatWorker(TextOutputStream& stream, const char* formatStr, MemoryRange<FormatterBase* const> formatters)
         : format(formatStr)
     {
         do
@@ -2,6 +2,10 @@
 #define INFRA_FORMATTER_HPP
 
 #include "infra/stream/StringOutputStream.hpp"
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace infra
 {
@@ -15,7 +19,8 @@ namespace infra
 
     struct FormatSpec
     {
-        explicit FormatSpec(const char*& format);
+        constexpr FormatSpec() = default;
+        constexpr explicit FormatSpec(const char*& format);
 
         std::size_t width{ 0 };
         char type{ '\0' };
@@ -23,13 +28,13 @@ namespace infra
         FormatAlign align{ FormatAlign::nothing };
 
     private:
-        void ParseAlign();
-        void ParseZero();
-        void ParseWidth();
-        void ParseType();
+        constexpr void ParseAlign();
+        constexpr void ParseZero();
+        constexpr void ParseWidth();
+        constexpr void ParseType();
 
     private:
-        const char*& format;
+        const char* format{ nullptr };
     };
 
     class FormatterBase
@@ -74,7 +79,7 @@ namespace infra
     class FormatWorker
     {
     public:
-        explicit FormatWorker(TextOutputStream& stream, const char* formatStr, std::vector<FormatterBase*>& formatters);
+        explicit FormatWorker(TextOutputStream& stream, const char* formatStr, MemoryRange<FormatterBase* const> formatters);
 
     private:
         bool IsEndFormat() const;
@@ -144,37 +149,35 @@ namespace infra
         explicit FormatHelper(const char* format, Args&&... args)
             : format(format)
             , args(std::forward<Args>(args)...)
-            , formatters{ MakeFormatter() }
         {}
 
         friend TextOutputStream& operator<<(TextOutputStream& stream, FormatHelper&& f)
         {
-            FormatWorker(stream, f.format, f.formatters);
+            f.Write(stream);
             return stream;
         }
 
         friend TextOutputStream& operator<<(TextOutputStream& stream, FormatHelper& f)
         {
-            FormatWorker(stream, f.format, f.formatters);
+            f.Write(stream);
             return stream;
         }
 
     private:
-        template<std::size_t... Is>
-        std::vector<FormatterBase*> Make(std::index_sequence<Is...>)
+        void Write(TextOutputStream& stream)
         {
-            return { &std::get<Is>(args)... };
+            Write(stream, std::index_sequence_for<Args...>{});
         }
 
-        std::vector<FormatterBase*> MakeFormatter()
+        template<std::size_t... Is>
+        void Write(TextOutputStream& stream, std::index_sequence<Is...>)
         {
-            return Make(std::index_sequence_for<Args...>{});
-        };
+            std::array<FormatterBase*, sizeof...(Args)> formatters{ { &std::get<Is>(args)... } };
+            FormatWorker(stream, format, formatters);
+        }
 
         const char* format;
         std::tuple<Args...> args;
-        std::vector<FormatterBase*> formatters{ sizeof...(Args), nullptr };
-        uint32_t autoIndex{};
     };
 
     template<class... Args>
@@ -182,6 +185,240 @@ namespace infra
     {
         return FormatHelper<Formatter<typename DecayFormatType<Args>::type>...>(format, MakeFormatter(std::forward<Args>(args))...);
     }
+
+    namespace detail
+    {
+        struct FormatStringTag
+        {};
+
+        struct CompiledPlaceholder
+        {
+            std::size_t literalBegin{ 0 };
+            std::size_t literalEnd{ 0 };
+            std::size_t index{ 0 };
+            FormatSpec spec;
+        };
+
+        template<std::size_t NumberOfPlaceholders>
+        struct CompiledFormatString
+        {
+            std::array<CompiledPlaceholder, NumberOfPlaceholders> placeholders{};
+            std::size_t trailingBegin{ 0 };
+            std::size_t trailingEnd{ 0 };
+            std::size_t requiredArguments{ 0 };
+            bool valid{ true };
+        };
+
+        constexpr bool IsFormatDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr std::size_t CountPlaceholders(const char* format)
+        {
+            std::size_t count = 0;
+
+            for (; *format != '\0'; ++format)
+                if (*format == '{')
+                    ++count;
+
+            return count;
+        }
+
+        template<std::size_t NumberOfPlaceholders>
+        constexpr CompiledFormatString<NumberOfPlaceholders> CompileFormatString(const char* format)
+        {
+            CompiledFormatString<NumberOfPlaceholders> result{};
+            const char* current = format;
+            std::size_t autoIndex = 0;
+
+            for (auto& placeholder : result.placeholders)
+            {
+                placeholder.literalBegin = current - format;
+                while (*current != '{')
+                    ++current;
+                placeholder.literalEnd = current - format;
+                ++current;
+
+                if (IsFormatDigit(*current))
+                    while (IsFormatDigit(*current))
+                        placeholder.index = 10 * placeholder.index + *current++ - '0';
+                else
+                    placeholder.index = autoIndex++;
+
+                placeholder.spec = FormatSpec(current);
+
+                auto type = placeholder.spec.type;
+                if (*current != '}' || !(type == '\0' || type == 'd' || type == 'x' || type == 'X' || type == 'o' || type == 'b'))
+                {
+                    result.valid = false;
+                    return result;
+                }
+
+                ++current;
+                if (placeholder.index + 1 > result.requiredArguments)
+                    result.requiredArguments = placeholder.index + 1;
+            }
+
+            result.trailingBegin = current - format;
+            while (*current != '\0')
+                ++current;
+            result.trailingEnd = current - format;
+
+            return result;
+        }
+
+        template<class String>
+        struct CompiledFormat
+        {
+            static constexpr auto compiled = CompileFormatString<CountPlaceholders(String::Get())>(String::Get());
+        };
+    }
+
+    template<class String, class... Args>
+    class CompiledFormatHelper
+    {
+    public:
+        explicit CompiledFormatHelper(Args&&... args)
+            : args(std::forward<Args>(args)...)
+        {}
+
+        friend TextOutputStream& operator<<(TextOutputStream& stream, CompiledFormatHelper&& f)
+        {
+            f.Write(stream, std::make_index_sequence<compiled.placeholders.size()>{});
+            return stream;
+        }
+
+        friend TextOutputStream& operator<<(TextOutputStream& stream, CompiledFormatHelper& f)
+        {
+            f.Write(stream, std::make_index_sequence<compiled.placeholders.size()>{});
+            return stream;
+        }
+
+    private:
+        static constexpr const auto& compiled = detail::CompiledFormat<String>::compiled;
+
+        template<std::size_t... Is>
+        void Write(TextOutputStream& stream, std::index_sequence<Is...>)
+        {
+            (WritePlaceholder<Is>(stream), ...);
+            WriteLiteral(stream, compiled.trailingBegin, compiled.trailingEnd);
+        }
+
+        template<std::size_t I>
+        void WritePlaceholder(TextOutputStream& stream)
+        {
+            constexpr const auto& placeholder = compiled.placeholders[I];
+            WriteLiteral(stream, placeholder.literalBegin, placeholder.literalEnd);
+
+            auto spec = placeholder.spec;
+            std::get<placeholder.index>(args).Format(stream, spec);
+        }
+
+        static void WriteLiteral(TextOutputStream& stream, std::size_t begin, std::size_t end)
+        {
+            if (begin != end)
+                stream << BoundedConstString(String::Get() + begin, end - begin);
+        }
+
+        std::tuple<Args...> args;
+    };
+
+    // Creates a format string that is parsed and checked at compile time, for use with infra::Format:
+    //     stream << infra::Format(INFRA_FORMAT_STRING("{}: {:04x}"), name, value);
+    // The literal segments and format specifications are computed by the compiler, so formatting is a fixed
+    // sequence of writes without heap allocation or parsing at runtime.
+#define INFRA_FORMAT_STRING(string)                       \
+    ([] {                                                  \
+        struct FormatString                                \
+            : infra::detail::FormatStringTag               \
+        {                                                  \
+            static constexpr const char* Get()             \
+            {                                              \
+                return string;                             \
+            }                                              \
+        };                                                 \
+        return FormatString{};                             \
+    }())
+
+    template<class String, class... Args, std::enable_if_t<std::is_base_of_v<detail::FormatStringTag, String>, std::nullptr_t> = nullptr>
+    auto Format(String, Args&&... args)
+    {
+        static_assert(detail::CompiledFormat<String>::compiled.valid, "Invalid placeholder in format string");
+        static_assert(detail::CompiledFormat<String>::compiled.requiredArguments <= sizeof...(Args), "Too few arguments for format string");
+
+        return CompiledFormatHelper<String, Formatter<typename DecayFormatType<Args>::type>...>(MakeFormatter(std::forward<Args>(args))...);
+    }
+
+    ////    Implementation    ////
+
+    constexpr FormatSpec::FormatSpec(const char*& format)
+        : format(format)
+    {
+        if (*this->format == ':')
+        {
+            ++this->format;
+            ParseAlign();
+            ParseZero();
+            ParseWidth();
+            ParseType();
+        }
+
+        format = this->format;
+    }
+
+    constexpr void FormatSpec::ParseAlign()
+    {
+        auto i = (*format == '\0') ? 0 : 1;
+        do
+        {
+            switch (format[i])
+            {
+                case '<':
+                    align = FormatAlign::left;
+                    break;
+                case '^':
+                    align = FormatAlign::center;
+                    break;
+                case '>':
+                    align = FormatAlign::right;
+                    break;
+                default:
+                    break;
+            }
+
+            if (align != FormatAlign::nothing)
+            {
+                if (i == 1)
+                    fill = *format++;
+                ++format;
+                return;
+            }
+        } while (i-- > 0);
+    }
+
+    constexpr void FormatSpec::ParseZero()
+    {
+        if (*format != '0')
+            return;
+
+        if (align == FormatAlign::nothing)
+            fill = '0';
+
+        format++;
+    }
+
+    constexpr void FormatSpec::ParseWidth()
+    {
+        while (detail::IsFormatDigit(*format))
+            width = 10 * width + *format++ - '0';
+    }
+
+    constexpr void FormatSpec::ParseType()
+    {
+        if (*format != '}' && *format != '\0')
+            type = *format++;
+    }
 }
 
 #endif
@@ -1,9 +1,274 @@
 #include "infra/stream/OutputStream.hpp"
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <limits>
 
 namespace infra
 {
+    namespace
+    {
+        // Sign plus 64 binary digits
+        constexpr std::size_t maxFormattedIntegerSize = 65;
+
+        constexpr char digitPairs[] = "00010203040506070809"
+                                      "10111213141516171819"
+                                      "20212223242526272829"
+                                      "30313233343536373839"
+                                      "40414243444546474849"
+                                      "50515253545556575859"
+                                      "60616263646566676869"
+                                      "70717273747576777879"
+                                      "80818283848586878889"
+                                      "90919293949596979899";
+
+        // The Format* functions render digits backwards, ending at end, and return the start of the rendered digits
+        char* FormatDecimal(uint32_t v, char* end)
+        {
+            while (v >= 100)
+            {
+                auto pair = (v % 100) * 2;
+                v /= 100;
+                *--end = digitPairs[pair + 1];
+                *--end = digitPairs[pair];
+            }
+
+            if (v >= 10)
+            {
+                *--end = digitPairs[v * 2 + 1];
+                *--end = digitPairs[v * 2];
+            }
+            else
+                *--end = static_cast<char>('0' + v);
+
+            return end;
+        }
+
+        char* FormatDecimal(uint64_t v, char* end)
+        {
+            // Only chunks of eight digits need a 64-bit division, which is expensive on targets without hardware support for it
+            while (v > std::numeric_limits<uint32_t>::max())
+            {
+                auto chunk = static_cast<uint32_t>(v % 100000000);
+                v /= 100000000;
+                auto begin = FormatDecimal(chunk, end);
+                end -= 8;
+                std::fill(end, begin, '0');
+            }
+
+            return FormatDecimal(static_cast<uint32_t>(v), end);
+        }
+
+        char* FormatPowerOfTwo(uint64_t v, char* end, uint32_t bitsPerDigit)
+        {
+            static const char digits[] = "0123456789abcdef";
+            const auto mask = (1u << bitsPerDigit) - 1;
+
+            do
+            {
+                *--end = digits[v & mask];
+                v >>= bitsPerDigit;
+            } while (v != 0);
+
+            return end;
+        }
+
+        // Unsigned integer of fixed size for the exact arithmetic in ShortestSignificand. Six words are enough for
+        // the largest intermediate value, which occurs for the smallest normal floats: about 2^154.
+        class BigUnsigned
+        {
+        public:
+            explicit BigUnsigned(uint32_t value)
+            {
+                words[0] = value;
+            }
+
+            void MultiplyAdd(uint32_t factor, uint32_t addend = 0)
+            {
+                uint64_t carry = addend;
+
+                for (auto& word : words)
+                {
+                    carry += static_cast<uint64_t>(word) * factor;
+                    word = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+            }
+
+            void MultiplyPowerOfTen(uint32_t exponent)
+            {
+                for (; exponent >= 9; exponent -= 9)
+                    MultiplyAdd(1000000000);
+
+                uint32_t factor = 1;
+                for (; exponent != 0; --exponent)
+                    factor *= 10;
+
+                MultiplyAdd(factor);
+            }
+
+            void ShiftLeft(uint32_t bits)
+            {
+                auto wordShift = bits / 32;
+                std::copy_backward(words.begin(), words.end() - wordShift, words.end());
+                std::fill(words.begin(), words.begin() + wordShift, 0);
+
+                if (bits % 32 != 0)
+                    MultiplyAdd(1u << (bits % 32));
+            }
+
+            void Add(const BigUnsigned& other)
+            {
+                uint64_t carry = 0;
+
+                for (std::size_t i = 0; i != words.size(); ++i)
+                {
+                    carry += static_cast<uint64_t>(words[i]) + other.words[i];
+                    words[i] = static_cast<uint32_t>(carry);
+                    carry >>= 32;
+                }
+            }
+
+            // Requires that other is not larger than this
+            void Subtract(const BigUnsigned& other)
+            {
+                uint32_t borrow = 0;
+
+                for (std::size_t i = 0; i != words.size(); ++i)
+                {
+                    auto difference = static_cast<uint64_t>(words[i]) - other.words[i] - borrow;
+                    words[i] = static_cast<uint32_t>(difference);
+                    borrow = static_cast<uint32_t>(difference >> 63);
+                }
+            }
+
+            int Compare(const BigUnsigned& other) const
+            {
+                for (auto i = words.size(); i != 0; --i)
+                    if (words[i - 1] != other.words[i - 1])
+                        return words[i - 1] < other.words[i - 1] ? -1 : 1;
+
+                return 0;
+            }
+
+            friend BigUnsigned operator+(BigUnsigned x, const BigUnsigned& y)
+            {
+                x.Add(y);
+                return x;
+            }
+
+        private:
+            std::array<uint32_t, 6> words{};
+        };
+
+        // floor(exponent * log10(2)), for exponents within the range of float
+        int FloorLog10OfPowerOfTwo(int exponent)
+        {
+            auto scaled = exponent * 78913;
+            return scaled >= 0 ? scaled / 262144 : -((-scaled + 262143) / 262144);
+        }
+
+        // Returns the smallest number of significant digits that converts back to exactly the same float, together with the
+        // decimal exponent of its first digit. This is the free-format algorithm by Steele & White and Burger & Dybvig: the
+        // value and the half-way points to its neighbouring floats are represented exactly as fractions of big integers, and
+        // digits are generated until the digits written so far lie between those half-way points. Only integer arithmetic
+        // is used, so that this works without a floating point unit or libm.
+        uint32_t ShortestSignificand(float v, int& exponent, uint32_t& digits)
+        {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &v, sizeof(bits));
+
+            auto biasedExponent = bits >> 23;
+            auto fraction = bits & 0x7fffff;
+            auto mantissa = biasedExponent == 0 ? fraction : fraction | 0x800000;
+            auto binaryExponent = biasedExponent == 0 ? -149 : static_cast<int>(biasedExponent) - 150;
+            auto even = (mantissa & 1) == 0;
+            // The gap to the lower neighbour is half as large when the mantissa is a power of two
+            auto unequalGaps = fraction == 0 && biasedExponent > 1;
+
+            // v == r / s, the half-way points to the neighbours are at (r - mMinus) / s and (r + mPlus) / s
+            BigUnsigned r(mantissa);
+            BigUnsigned s(1);
+            BigUnsigned mPlus(1);
+            BigUnsigned mMinus(1);
+
+            if (binaryExponent >= 0)
+            {
+                r.ShiftLeft(binaryExponent);
+                mPlus.ShiftLeft(binaryExponent);
+                mMinus.ShiftLeft(binaryExponent);
+            }
+            else
+                s.ShiftLeft(-binaryExponent);
+
+            r.ShiftLeft(unequalGaps ? 2 : 1);
+            s.ShiftLeft(unequalGaps ? 2 : 1);
+            if (unequalGaps)
+                mPlus.ShiftLeft(1);
+
+            auto mantissaBits = 0;
+            for (auto m = mantissa; m != 0; m >>= 1)
+                ++mantissaBits;
+
+            // The estimate is either right or one too small
+            exponent = FloorLog10OfPowerOfTwo(binaryExponent + mantissaBits - 1) + 1;
+            if (exponent >= 0)
+                s.MultiplyPowerOfTen(exponent);
+            else
+            {
+                r.MultiplyPowerOfTen(-exponent);
+                mPlus.MultiplyPowerOfTen(-exponent);
+                mMinus.MultiplyPowerOfTen(-exponent);
+            }
+
+            auto upperComparison = (r + mPlus).Compare(s);
+            if (upperComparison > 0 || (even && upperComparison == 0))
+            {
+                s.MultiplyAdd(10);
+                ++exponent;
+            }
+
+            // Now r / s < 1, so the first digit has decimal exponent exponent - 1
+            --exponent;
+            uint32_t significand = 0;
+
+            for (digits = 1;; ++digits)
+            {
+                r.MultiplyAdd(10);
+                mPlus.MultiplyAdd(10);
+                mMinus.MultiplyAdd(10);
+
+                uint32_t digit = 0;
+                while (r.Compare(s) >= 0)
+                {
+                    r.Subtract(s);
+                    ++digit;
+                }
+
+                auto lowerComparison = r.Compare(mMinus);
+                auto low = lowerComparison < 0 || (even && lowerComparison == 0);
+                upperComparison = (r + mPlus).Compare(s);
+                auto high = upperComparison > 0 || (even && upperComparison == 0);
+
+                if (low && high)
+                {
+                    // Both candidates are within the bounds, take the one closest to v, or the even one on a tie
+                    auto halfComparison = (r + r).Compare(s);
+                    if (halfComparison > 0 || (halfComparison == 0 && digit % 2 != 0))
+                        ++digit;
+                }
+                else if (high)
+                    ++digit;
+
+                if (low || high)
+                    return significand * 10 + digit;
+
+                significand = significand * 10 + digit;
+            }
+        }
+    }
+
     std::size_t StreamWriter::ConstructSaveMarker() const
     {
         std::abort();
@@ -242,67 +507,29 @@ namespace infra
 
     void TextOutputStream::OutputAsDecimal(uint64_t v, bool negative)
     {
-        size_t nofDigits = negative ? 2 : 1;
-        uint64_t mask = 1;
-
-        while (v / mask >= 10)
-        {
-            mask *= 10;
-            ++nofDigits;
-        }
-        OutputOptionalPadding(nofDigits);
-        if (negative)
-            Writer().Insert(MakeByteRange('-'), ErrorPolicy());
-
-        while (mask != 0)
-        {
-            Writer().Insert(MakeByteRange(static_cast<char>(((v / mask) % 10) + '0')), ErrorPolicy());
-            mask /= 10;
-        }
+        std::array<char, maxFormattedIntegerSize> buffer;
+        OutputFormatted(FormatDecimal(v, buffer.data() + buffer.size()), buffer.data() + buffer.size(), negative);
     }
 
     void TextOutputStream::OutputAsBinary(uint64_t v, bool negative)
     {
-        size_t nofDigits = negative ? 2 : 1;
-        uint64_t mask = 1;
-
-        while (v / mask >= 2)
-        {
-            mask *= 2;
-            ++nofDigits;
-        }
-        OutputOptionalPadding(nofDigits);
-        if (negative)
-            Writer().Insert(MakeByteRange('-'), ErrorPolicy());
-
-        while (mask != 0)
-        {
-            Writer().Insert(MakeByteRange(static_cast<char>('0' + ((v / mask) & 1))), ErrorPolicy());
-            mask /= 2;
-        }
+        std::array<char, maxFormattedIntegerSize> buffer;
+        OutputFormatted(FormatPowerOfTwo(v, buffer.data() + buffer.size(), 1), buffer.data() + buffer.size(), negative);
     }
 
     void TextOutputStream::OutputAsHexadecimal(uint64_t v, bool negative)
     {
-        static const char hexChars[] = "0123456789abcdef";
-
-        size_t nofDigits = negative ? 2 : 1;
-        uint64_t mask = 1;
+        std::array<char, maxFormattedIntegerSize> buffer;
+        OutputFormatted(FormatPowerOfTwo(v, buffer.data() + buffer.size(), 4), buffer.data() + buffer.size(), negative);
+    }
 
-        while (v / mask >= 16)
-        {
-            mask *= 16;
-            ++nofDigits;
-        }
-        OutputOptionalPadding(nofDigits);
+    void TextOutputStream::OutputFormatted(char* begin, char* end, bool negative)
+    {
         if (negative)
-            Writer().Insert(MakeByteRange('-'), ErrorPolicy());
+            *--begin = '-';
 
-        while (mask != 0)
-        {
-            Writer().Insert(MakeByteRange(hexChars[(v / mask) % 16]), ErrorPolicy());
-            mask /= 16;
-        }
+        OutputOptionalPadding(end - begin);
+        Writer().Insert(ReinterpretCastByteRange(MakeRange(begin, end)), ErrorPolicy());
     }
 
     void TextOutputStream::FormatArgs(const char* format, MemoryRange<FormatterBase*> formatters)
@@ -338,8 +565,20 @@ namespace infra
 
     void TextOutputStream::OutputOptionalPadding(size_t size)
     {
-        for (auto i = size; i < width.width; ++i)
-            Writer().Insert(MakeByteRange(width.padding), ErrorPolicy());
+        std::array<char, 16> padding;
+
+        if (size < width.width)
+        {
+            auto remaining = width.width - size;
+            padding.fill(width.padding);
+
+            while (remaining != 0)
+            {
+                auto chunk = std::min(remaining, padding.size());
+                Writer().Insert(ReinterpretCastByteRange(MakeRange(padding.data(), padding.data() + chunk)), ErrorPolicy());
+                remaining -= chunk;
+            }
+        }
     }
 
     AsAsciiHelper::AsAsciiHelper(ConstByteRange data)
@@ -362,6 +601,95 @@ namespace infra
         return stream << asAsciiHelper;
     }
 
+    AsShortestHelper::AsShortestHelper(float value)
+        : value(value)
+    {}
+
+    TextOutputStream& operator<<(TextOutputStream& stream, const AsShortestHelper& asShortestHelper)
+    {
+        auto v = asShortestHelper.value;
+
+        if (std::isnan(v))
+            return stream << "nan";
+
+        if (std::signbit(v))
+        {
+            stream << '-';
+            v = -v;
+        }
+
+        if (std::isinf(v))
+            return stream << "inf";
+
+        if (v == 0)
+            return stream << '0';
+
+        int exponent = 0;
+        uint32_t numberOfDigits = 0;
+        auto significand = ShortestSignificand(v, exponent, numberOfDigits);
+
+        std::array<char, 10> digitsBuffer;
+        auto digits = FormatDecimal(significand, digitsBuffer.data() + digitsBuffer.size());
+        auto digitsEnd = digitsBuffer.data() + digitsBuffer.size();
+
+        // A significand that rounded up to the next power of ten has one digit too many
+        if (static_cast<uint32_t>(digitsEnd - digits) > numberOfDigits)
+        {
+            ++exponent;
+            --digitsEnd;
+        }
+
+        while (digitsEnd - digits > 1 && digitsEnd[-1] == '0')
+            --digitsEnd;
+
+        std::array<char, 24> buffer;
+        auto out = buffer.data();
+        auto size = static_cast<int>(digitsEnd - digits);
+
+        if (exponent < -5 || exponent >= 9)
+        {
+            *out++ = *digits;
+            if (size > 1)
+            {
+                *out++ = '.';
+                out = std::copy(digits + 1, digitsEnd, out);
+            }
+
+            *out++ = 'e';
+            if (exponent < 0)
+                *out++ = '-';
+
+            std::array<char, 3> exponentBuffer;
+            auto exponentDigits = FormatDecimal(static_cast<uint32_t>(std::abs(exponent)), exponentBuffer.data() + exponentBuffer.size());
+            out = std::copy(exponentDigits, exponentBuffer.data() + exponentBuffer.size(), out);
+        }
+        else if (exponent < 0)
+        {
+            *out++ = '0';
+            *out++ = '.';
+            out = std::fill_n(out, -exponent - 1, '0');
+            out = std::copy(digits, digitsEnd, out);
+        }
+        else if (exponent + 1 >= size)
+        {
+            out = std::copy(digits, digitsEnd, out);
+            out = std::fill_n(out, exponent + 1 - size, '0');
+        }
+        else
+        {
+            out = std::copy(digits, digits + exponent + 1, out);
+            *out++ = '.';
+            out = std::copy(digits + exponent + 1, digitsEnd, out);
+        }
+
+        return stream << BoundedConstString(buffer.data(), out - buffer.data());
+    }
+
+    TextOutputStream& operator<<(TextOutputStream&& stream, const AsShortestHelper& asShortestHelper)
+    {
+        return stream << asShortestHelper;
+    }
+
     AsHexHelper::AsHexHelper(ConstByteRange data)
         : data(data)
     {}
@@ -472,6 +800,11 @@ namespace infra
         return AsHexHelper(data);
     }
 
+    AsShortestHelper AsShortest(float value)
+    {
+        return AsShortestHelper(value);
+    }
+
     AsBase64Helper AsBase64(ConstByteRange data)
     {
         return AsBase64Helper(data);
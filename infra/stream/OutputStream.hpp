@@ -230,6 +230,7 @@ namespace infra
         void OutputAsDecimal(uint64_t v, bool negative);
         void OutputAsBinary(uint64_t v, bool negative);
         void OutputAsHexadecimal(uint64_t v, bool negative);
+        void OutputFormatted(char* begin, char* end, bool negative);
 
         template<class... Formatters>
         void FormatHelper(const char* format, Formatters&&... formatters);
@@ -272,6 +273,20 @@ namespace infra
         infra::ConstByteRange data;
     };
 
+    // Formats a float with the fewest significant digits that still convert back to the same value,
+    // e.g. 0.1f is formatted as "0.1" and 1e-7f as "1e-7"
+    class AsShortestHelper
+    {
+    public:
+        explicit AsShortestHelper(float value);
+
+        friend infra::TextOutputStream& operator<<(infra::TextOutputStream& stream, const AsShortestHelper& asShortestHelper);
+        friend infra::TextOutputStream& operator<<(TextOutputStream&& stream, const AsShortestHelper& asShortestHelper);
+
+    private:
+        float value;
+    };
+
     class Base64Encoder
     {
     public:
@@ -313,6 +328,7 @@ namespace infra
 
     AsAsciiHelper AsAscii(infra::ConstByteRange data);
     AsHexHelper AsHex(infra::ConstByteRange data);
+    AsShortestHelper AsShortest(float value);
     AsBase64Helper AsBase64(infra::ConstByteRange data);
     AsCombinedBase64Helper AsBase64(std::initializer_list<infra::ConstByteRange> ranges);
 
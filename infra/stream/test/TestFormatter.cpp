@@ -248,3 +248,35 @@ TEST_F(FormatTest, FormatObjectCombined)
 {
     CheckFormatArguments("Hello ..1.. 2 1 v:9,b:true", "Hello {0:.^5} {1} {0} {2}", 1, 2, TestFormatObject());
 }
+
+TEST_F(FormatTest, compiled_format_string)
+{
+    infra::StringOutputStream::WithStorage<60> stream(infra::softFail);
+    stream << infra::Format(INFRA_FORMAT_STRING("Hello {1} {0:~>4} {0:04x}!"), 26, "world");
+    EXPECT_FALSE(stream.ErrorPolicy().Failed());
+    EXPECT_EQ("Hello world ~~26 001a!", stream.Storage());
+}
+
+TEST_F(FormatTest, compiled_format_string_without_placeholders)
+{
+    infra::StringOutputStream::WithStorage<60> stream(infra::softFail);
+    stream << infra::Format(INFRA_FORMAT_STRING("plain"));
+    EXPECT_FALSE(stream.ErrorPolicy().Failed());
+    EXPECT_EQ("plain", stream.Storage());
+}
+
+TEST_F(FormatTest, compiled_format_string_with_object)
+{
+    infra::StringOutputStream::WithStorage<60> stream(infra::softFail);
+    stream << infra::Format(INFRA_FORMAT_STRING("{}|{:^5}"), TestFormatObject(), true);
+    EXPECT_FALSE(stream.ErrorPolicy().Failed());
+    EXPECT_EQ("v:9,b:true|true ", stream.Storage());
+}
+
+TEST(CompiledFormatString, is_validated_at_compile_time)
+{
+    static_assert(infra::detail::CompileFormatString<2>("{} {1:>5}").valid);
+    static_assert(infra::detail::CompileFormatString<2>("{} {1:>5}").requiredArguments == 2);
+    static_assert(!infra::detail::CompileFormatString<1>("{:t}").valid);
+    static_assert(!infra::detail::CompileFormatString<1>("{0").valid);
+}
@@ -3,7 +3,9 @@
 #include "infra/stream/StringOutputStream.hpp"
 #include "infra/util/BoundedString.hpp"
 #include "gtest/gtest.h"
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 
 namespace
@@ -167,6 +169,24 @@ TEST(StringOutputStreamTest, stream_int64_min)
     EXPECT_EQ("-9223372036854775808", stream.Storage());
 }
 
+TEST(StringOutputStreamTest, stream_uint64_with_zeroes_in_lower_digits)
+{
+    infra::StringOutputStream::WithStorage<32> stream;
+
+    stream << uint64_t(10000000000000000001u) << ' ' << uint64_t(4294967296u);
+
+    EXPECT_EQ("10000000000000000001 4294967296", stream.Storage());
+}
+
+TEST(StringOutputStreamTest, stream_with_padding_longer_than_a_chunk)
+{
+    infra::StringOutputStream::WithStorage<24> stream;
+
+    stream << infra::Width(20, '.') << uint8_t(7);
+
+    EXPECT_EQ("...................7", stream.Storage());
+}
+
 TEST(StringOutputStreamTest, stream_float)
 {
     infra::StringOutputStream::WithStorage<20> stream;
@@ -269,6 +289,51 @@ TEST(StringOutputStreamTest, stream_bin_with_leading_zeroes)
     EXPECT_EQ("00011010", stream.Storage());
 }
 
+TEST(StringOutputStreamTest, stream_uint64_max_hex_and_bin)
+{
+    infra::StringOutputStream::WithStorage<90> stream;
+
+    stream << infra::hex << std::numeric_limits<uint64_t>::max() << ' ' << infra::bin << std::numeric_limits<uint64_t>::max();
+    EXPECT_EQ("ffffffffffffffff " + std::string(64, '1'), std::string(stream.Storage().begin(), stream.Storage().end()));
+}
+
+TEST(StringOutputStreamTest, stream_shortest_float)
+{
+    infra::StringOutputStream::WithStorage<128> stream;
+
+    stream << infra::AsShortest(0.1f) << ' ' << infra::AsShortest(-42.125f) << ' ' << infra::AsShortest(100.0f) << ' ' << infra::AsShortest(0.0f) << ' '
+           << infra::AsShortest(1e-7f) << ' ' << infra::AsShortest(3.4028235e38f) << ' ' << infra::AsShortest(16777216.0f) << ' ' << infra::AsShortest(0.3f);
+    EXPECT_EQ("0.1 -42.125 100 0 1e-7 3.4028235e38 16777216 0.3", stream.Storage());
+}
+
+TEST(StringOutputStreamTest, stream_shortest_float_round_trips)
+{
+    for (auto value : { 1.0f / 3.0f, 2.5e-6f, 123456.79f, 1.17549435e-38f, 9.999999e8f, std::nextafter(1.0f, 2.0f) })
+    {
+        infra::StringOutputStream::WithStorage<32> stream;
+        stream << infra::AsShortest(value);
+        std::string formatted(stream.Storage().begin(), stream.Storage().end());
+        EXPECT_EQ(value, std::strtof(formatted.c_str(), nullptr)) << formatted;
+    }
+}
+
+TEST(StringOutputStreamTest, stream_shortest_float_edge_cases)
+{
+    infra::StringOutputStream::WithStorage<128> stream;
+
+    stream << infra::AsShortest(std::numeric_limits<float>::denorm_min()) << ' ' << infra::AsShortest(std::numeric_limits<float>::min()) << ' '
+           << infra::AsShortest(5.7382812f) << ' ' << infra::AsShortest(8388608.0f) << ' ' << infra::AsShortest(1e10f);
+    EXPECT_EQ("1e-45 1.1754944e-38 5.7382812 8388608 1e10", stream.Storage());
+}
+
+TEST(StringOutputStreamTest, stream_shortest_float_special_values)
+{
+    infra::StringOutputStream::WithStorage<32> stream;
+
+    stream << infra::AsShortest(std::numeric_limits<float>::quiet_NaN()) << ' ' << infra::AsShortest(-std::numeric_limits<float>::infinity());
+    EXPECT_EQ("nan -inf", stream.Storage());
+}
+
 TEST(StringOutputStreamTest, overflow)
 {
     infra::StringOutputStream::WithStorage<2> stream(infra::softFail);
@@ -0,0 +1,113 @@
+#include "infra/stream/StringOutputStream.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Measures how fast TextOutputStream formats numbers: 32-bit and 64-bit decimals, hexadecimals, and floats with
+// infra::AsShortest. As a baseline, the same numbers are formatted with snprintf. Each number is written into a
+// fresh StringOutputStream, as a formatter that writes a JSON value or a log line does.
+//
+// Usage: infra.stream_benchmark [count in millions, default 4]
+
+namespace
+{
+    std::vector<uint64_t> GenerateNumbers(std::size_t count)
+    {
+        std::vector<uint64_t> result(count);
+        uint64_t state = 88172645463325252ull;
+
+        for (auto& number : result)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            // Vary the magnitude, so that short and long numbers are both represented
+            number = state >> (state % 64);
+        }
+
+        return result;
+    }
+
+    float AsFloat(uint64_t number)
+    {
+        auto bits = static_cast<uint32_t>(number) & 0x7f7fffff; // Finite floats of both signs
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    template<class Format>
+    void Measure(const char* name, const std::vector<uint64_t>& numbers, Format format)
+    {
+        std::size_t characters = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (auto number : numbers)
+            characters += format(number);
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << seconds * 1e9 / numbers.size() << " ns/number (" << characters / numbers.size() << " characters)" << std::endl;
+    }
+
+    template<class T>
+    std::size_t FormatWithStream(const T& value)
+    {
+        infra::StringOutputStream::WithStorage<32> stream;
+        stream << value;
+        return stream.Storage().size();
+    }
+
+    template<class... Args>
+    std::size_t FormatWithSnprintf(const char* format, Args... args)
+    {
+        char buffer[32];
+        return std::snprintf(buffer, sizeof(buffer), format, args...);
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    std::size_t count = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4) * 1000 * 1000;
+
+    auto numbers = GenerateNumbers(count);
+
+    Measure("uint32_t   stream  ", numbers, [](uint64_t number)
+        {
+            return FormatWithStream(static_cast<uint32_t>(number));
+        });
+    Measure("uint32_t   snprintf", numbers, [](uint64_t number)
+        {
+            return FormatWithSnprintf("%u", static_cast<uint32_t>(number));
+        });
+    Measure("uint64_t   stream  ", numbers, [](uint64_t number)
+        {
+            return FormatWithStream(number);
+        });
+    Measure("uint64_t   snprintf", numbers, [](uint64_t number)
+        {
+            return FormatWithSnprintf("%llu", static_cast<unsigned long long>(number));
+        });
+    Measure("hex        stream  ", numbers, [](uint64_t number)
+        {
+            infra::StringOutputStream::WithStorage<32> stream;
+            stream << infra::hex << number;
+            return stream.Storage().size();
+        });
+    Measure("hex        snprintf", numbers, [](uint64_t number)
+        {
+            return FormatWithSnprintf("%llx", static_cast<unsigned long long>(number));
+        });
+    Measure("AsShortest stream  ", numbers, [](uint64_t number)
+        {
+            return FormatWithStream(infra::AsShortest(AsFloat(number)));
+        });
+    Measure("%.9g       snprintf", numbers, [](uint64_t number)
+        {
+            return FormatWithSnprintf("%.9g", static_cast<double>(AsFloat(number)));
+        });
+
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include "infra/syntax/EscapeCharacterHelper.hpp"
 #include "infra/syntax/Json.hpp"
 #include "infra/util/BoundedVector.hpp"
+#include <cmath>
 #include <variant>
 
 namespace infra
@@ -73,6 +74,15 @@ namespace infra
                 NestedInsert(subObjectFormatter, nextKey, path.substr(nextKey.size() + 1), valueToMerge);
         }
 
+        void InsertFloat(infra::TextOutputStream& stream, float value)
+        {
+            // JSON has no representation for NaN and infinity
+            if (std::isfinite(value))
+                stream << infra::AsShortest(value);
+            else
+                stream << "null";
+        }
+
         constexpr std::size_t milliValueWidth = 3;
         constexpr std::size_t nanoValueWidth = 9;
     }
@@ -297,6 +307,20 @@ namespace infra
         *stream << '"' << tagName.Raw() << R"(":)" << tag;
     }
 
+    void JsonObjectFormatter::Add(const char* tagName, float tag)
+    {
+        InsertSeparation();
+        *stream << '"' << tagName << R"(":)";
+        InsertFloat(*stream, tag);
+    }
+
+    void JsonObjectFormatter::Add(JsonString tagName, float tag)
+    {
+        InsertSeparation();
+        *stream << '"' << tagName.Raw() << R"(":)";
+        InsertFloat(*stream, tag);
+    }
+
     void JsonObjectFormatter::Add(const char* tagName, JsonBiggerInt tag)
     {
         InsertSeparation();
@@ -509,6 +533,12 @@ namespace infra
         *stream << tag;
     }
 
+    void JsonArrayFormatter::Add(float tag)
+    {
+        InsertSeparation();
+        InsertFloat(*stream, tag);
+    }
+
     void JsonArrayFormatter::Add(JsonBiggerInt tag)
     {
         InsertSeparation();
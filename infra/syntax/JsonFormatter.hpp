@@ -46,6 +46,8 @@ namespace infra
         void Add(JsonString tagName, int64_t tag);
         void Add(const char* tagName, uint64_t tag);
         void Add(JsonString tagName, uint64_t tag);
+        void Add(const char* tagName, float tag);
+        void Add(JsonString tagName, float tag);
         void Add(const char* tagName, JsonBiggerInt tag);
         void Add(JsonString tagName, JsonBiggerInt tag);
         void Add(const char* tagName, const char* tag);
@@ -118,6 +120,7 @@ namespace infra
         void Add(int32_t tag);
         void Add(uint32_t tag);
         void Add(int64_t tag);
+        void Add(float tag);
         void Add(JsonBiggerInt tag);
         void Add(const char* tag);
         void Add(infra::BoundedConstString tag);
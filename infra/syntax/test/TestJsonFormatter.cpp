@@ -2,6 +2,7 @@
 #include "infra/syntax/Json.hpp"
 #include "infra/syntax/JsonFormatter.hpp"
 #include "gtest/gtest.h"
+#include <limits>
 
 TEST(BasicUsageTest, format_json_object)
 {
@@ -345,6 +346,18 @@ TEST(JsonObjectFormatter, add_key_jsonstring_nano_value_JsonFloat)
     EXPECT_EQ(R"({ "tag":0.000000005 })", string);
 }
 
+TEST(JsonObjectFormatter, add_float)
+{
+    infra::BoundedString::WithStorage<64> string;
+
+    {
+        infra::JsonObjectFormatter::WithStringStream formatter(std::in_place, string);
+        formatter.Add("tag", 55.3f);
+        formatter.Add(infra::JsonString{ "nan" }, std::numeric_limits<float>::quiet_NaN());
+    }
+    EXPECT_EQ(R"({ "tag":55.3, "nan":null })", string);
+}
+
 TEST(JsonObjectFormatter, add_key_jsonstring_value_JsonString)
 {
     infra::BoundedString::WithStorage<64> string;
@@ -488,6 +501,19 @@ TEST(JsonArrayFormatter, add_int)
     EXPECT_EQ(R"([ 0, 5, -10, -4 ])", string);
 }
 
+TEST(JsonArrayFormatter, add_float)
+{
+    infra::BoundedString::WithStorage<64> string;
+
+    {
+        infra::JsonArrayFormatter::WithStringStream formatter(std::in_place, string);
+        formatter.Add(-0.25f);
+        formatter.Add(1e10f);
+    }
+
+    EXPECT_EQ(R"([ -0.25, 1e10 ])", string);
+}
+
 TEST(JsonArrayFormatter, add_const_char_ptr)
 {
     infra::BoundedString::WithStorage<64> string;
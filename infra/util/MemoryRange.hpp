@@ -6,6 +6,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <type_traits>
 #include <vector>
 
@@ -466,7 +467,18 @@ namespace infra
     template<class T>
     std::pair<MemoryRange<T>, MemoryRange<T>> FindAndSplit(MemoryRange<T> range, typename std::decay<T>::type search)
     {
-        auto position = std::find(range.begin(), range.end(), search);
+        auto position = range.end();
+
+        if constexpr (sizeof(T) == 1 && std::is_integral<typename std::decay<T>::type>::value)
+        {
+            // memchr searches a machine word at a time, or uses SIMD instructions, on most platforms
+            if (!range.empty())
+                if (auto found = static_cast<const unsigned char*>(std::memchr(range.begin(), static_cast<unsigned char>(search), range.size())))
+                    position = range.begin() + (found - reinterpret_cast<const unsigned char*>(range.begin()));
+        }
+        else
+            position = std::find(range.begin(), range.end(), search);
+
         return std::make_pair(MemoryRange<T>(range.begin(), position), MemoryRange<T>(position, range.end()));
     }
 
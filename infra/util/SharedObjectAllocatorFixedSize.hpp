@@ -42,18 +42,23 @@ namespace infra
         void OnAllocatable(infra::AutoResetFunction<void()>&& callback) override;
         bool NoneAllocated() const override;
 
+        // Number of objects currently allocated, and the largest number of objects that were allocated at the same time.
+        // The high-water mark indicates how large the storage of this allocator must be in practice.
+        std::size_t Allocated() const;
+        std::size_t HighWaterMark() const;
+
     private:
         // Implementation of SharedObjectDeleter
         void Destruct(const void* object) override;
         void Deallocate(void* control) override;
 
     private:
-        std::size_t FreeListSize() const;
         Node* AllocateNode();
 
     private:
         infra::BoundedVector<Node>& elements;
         Node* freeList = nullptr;
+        std::size_t allocated = 0;
         infra::AutoResetFunction<void()> onAllocatable;
     };
 
@@ -92,7 +97,20 @@ namespace infra
     template<class T, class... ConstructionArgs>
     bool SharedObjectAllocatorFixedSize<T, void(ConstructionArgs...)>::NoneAllocated() const
     {
-        return FreeListSize() == elements.size();
+        return allocated == 0;
+    }
+
+    template<class T, class... ConstructionArgs>
+    std::size_t SharedObjectAllocatorFixedSize<T, void(ConstructionArgs...)>::Allocated() const
+    {
+        return allocated;
+    }
+
+    template<class T, class... ConstructionArgs>
+    std::size_t SharedObjectAllocatorFixedSize<T, void(ConstructionArgs...)>::HighWaterMark() const
+    {
+        // Nodes are only added to elements when the free list is exhausted
+        return elements.size();
     }
 
     template<class T, class... ConstructionArgs>
@@ -108,26 +126,12 @@ namespace infra
 
         node->next = freeList;
         freeList = node;
+        --allocated;
 
         if (onAllocatable != nullptr)
             onAllocatable();
     }
 
-    template<class T, class... ConstructionArgs>
-    std::size_t SharedObjectAllocatorFixedSize<T, void(ConstructionArgs...)>::FreeListSize() const
-    {
-        Node* node = freeList;
-        std::size_t result = 0;
-
-        while (node)
-        {
-            node = node->next;
-            ++result;
-        }
-
-        return result;
-    }
-
     template<class T, class... ConstructionArgs>
     typename SharedObjectAllocatorFixedSize<T, void(ConstructionArgs...)>::Node* SharedObjectAllocatorFixedSize<T, void(ConstructionArgs...)>::AllocateNode()
     {
@@ -135,6 +139,7 @@ namespace infra
         {
             Node* result = freeList;
             freeList = freeList->next;
+            ++allocated;
             return result;
         }
         else
@@ -143,6 +148,7 @@ namespace infra
                 return nullptr;
 
             elements.emplace_back(static_cast<SharedObjectDeleter*>(this));
+            ++allocated;
             return &elements.back();
         }
     }
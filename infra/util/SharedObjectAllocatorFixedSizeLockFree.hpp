@@ -0,0 +1,212 @@
+#ifndef INFRA_SHARED_OBJECT_ALLOCATOR_FIXED_SIZE_LOCK_FREE_HPP
+#define INFRA_SHARED_OBJECT_ALLOCATOR_FIXED_SIZE_LOCK_FREE_HPP
+
+#include "infra/util/BoundedVector.hpp"
+#include "infra/util/SharedObjectAllocator.hpp"
+#include "infra/util/StaticStorage.hpp"
+#include "infra/util/WithStorage.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace infra
+{
+    // SharedObjectAllocatorFixedSizeLockFree may be used to allocate and release objects from multiple threads at the same time.
+    // Free nodes are kept on a lock-free stack, of which the head is tagged with a counter to prevent the ABA problem.
+    // This needs a lock-free 64-bit atomic, so this allocator is intended for host builds.
+    // The reference counts of SharedPtr are not atomic, so an individual object must still be shared within a single thread only.
+    // OnAllocatable is not thread safe: only use it when objects are released on a single thread, on which the callback is then invoked.
+    template<class T, class ConstructionArgs>
+    class SharedObjectAllocatorFixedSizeLockFree;
+
+    template<class T, class... ConstructionArgs>
+    class SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>
+        : public SharedObjectAllocator<T, void(ConstructionArgs...)>
+        , private SharedObjectDeleter
+    {
+        static_assert(sizeof(T) == sizeof(StaticStorage<T>), "sizeof(StaticStorage) must be equal to sizeof(T) else reinterpret_cast will fail");
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "SharedObjectAllocatorFixedSizeLockFree requires lock-free 64-bit atomics");
+
+    private:
+        struct Node
+            : public detail::SharedPtrControl
+        {
+            explicit Node(SharedObjectDeleter* allocator);
+
+            std::atomic<uint32_t> next{ noNode };
+            infra::StaticStorage<T> object{};
+        };
+
+    public:
+        template<std::size_t NumberOfElements>
+        using WithStorage = infra::WithStorage<SharedObjectAllocatorFixedSizeLockFree, typename infra::BoundedVector<Node>::template WithMaxSize<NumberOfElements>>;
+
+        explicit SharedObjectAllocatorFixedSizeLockFree(infra::BoundedVector<Node>& elements);
+        SharedObjectAllocatorFixedSizeLockFree(const SharedObjectAllocatorFixedSizeLockFree& other) = delete;
+        SharedObjectAllocatorFixedSizeLockFree& operator=(const SharedObjectAllocatorFixedSizeLockFree& other) = delete;
+        ~SharedObjectAllocatorFixedSizeLockFree();
+
+        // Implementation of SharedObjectAllocator
+        SharedPtr<T> Allocate(ConstructionArgs... args) override;
+        void OnAllocatable(infra::AutoResetFunction<void()>&& callback) override;
+        bool NoneAllocated() const override;
+
+        std::size_t Allocated() const;
+        std::size_t HighWaterMark() const;
+
+    private:
+        // Implementation of SharedObjectDeleter
+        void Destruct(const void* object) override;
+        void Deallocate(void* control) override;
+
+    private:
+        static constexpr uint32_t noNode = 0xffffffff;
+
+        static uint64_t Tagged(uint32_t index, uint64_t previous);
+        static uint32_t Index(uint64_t tagged);
+
+        Node* AllocateNode();
+        void UpdateHighWaterMark(std::size_t allocatedNow);
+
+    private:
+        infra::BoundedVector<Node>& elements;
+        std::atomic<uint64_t> freeList{ Tagged(noNode, 0) };
+        std::atomic<std::size_t> allocated{ 0 };
+        std::atomic<std::size_t> highWaterMark{ 0 };
+        infra::AutoResetFunction<void()> onAllocatable;
+    };
+
+    ////    Implementation    ////
+
+    template<class T, class... ConstructionArgs>
+    SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::SharedObjectAllocatorFixedSizeLockFree(infra::BoundedVector<Node>& elements)
+        : elements(elements)
+    {
+        // All nodes are created up front, so that elements is never modified while other threads access it
+        while (!elements.full())
+            elements.emplace_back(static_cast<SharedObjectDeleter*>(this));
+
+        for (uint32_t index = static_cast<uint32_t>(elements.size()); index != 0; --index)
+        {
+            elements[index - 1].next.store(Index(freeList.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            freeList.store(Tagged(index - 1, 0), std::memory_order_relaxed);
+        }
+    }
+
+    template<class T, class... ConstructionArgs>
+    SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::~SharedObjectAllocatorFixedSizeLockFree()
+    {
+        assert(NoneAllocated());
+    }
+
+    template<class T, class... ConstructionArgs>
+    SharedPtr<T> SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Allocate(ConstructionArgs... args)
+    {
+        Node* node = AllocateNode();
+        if (node)
+        {
+            node->object.Construct(std::forward<ConstructionArgs>(args)...);
+            return SharedPtr<T>(node, &*node->object);
+        }
+        else
+            return nullptr;
+    }
+
+    template<class T, class... ConstructionArgs>
+    void SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::OnAllocatable(infra::AutoResetFunction<void()>&& callback)
+    {
+        onAllocatable = std::move(callback);
+    }
+
+    template<class T, class... ConstructionArgs>
+    bool SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::NoneAllocated() const
+    {
+        return allocated.load(std::memory_order_acquire) == 0;
+    }
+
+    template<class T, class... ConstructionArgs>
+    std::size_t SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Allocated() const
+    {
+        return allocated.load(std::memory_order_relaxed);
+    }
+
+    template<class T, class... ConstructionArgs>
+    std::size_t SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::HighWaterMark() const
+    {
+        return highWaterMark.load(std::memory_order_relaxed);
+    }
+
+    template<class T, class... ConstructionArgs>
+    void SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Destruct(const void* object)
+    {
+        reinterpret_cast<const StaticStorage<T>*>(object)->Destruct();
+    }
+
+    template<class T, class... ConstructionArgs>
+    void SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Deallocate(void* control)
+    {
+        Node* node = static_cast<Node*>(control);
+        auto index = static_cast<uint32_t>(node - &elements.front());
+
+        // Decrease the count before the node becomes available, so that allocated never exceeds the number of nodes
+        allocated.fetch_sub(1, std::memory_order_release);
+
+        auto head = freeList.load(std::memory_order_relaxed);
+        do
+        {
+            node->next.store(Index(head), std::memory_order_relaxed);
+        } while (!freeList.compare_exchange_weak(head, Tagged(index, head), std::memory_order_release, std::memory_order_relaxed));
+
+        if (onAllocatable != nullptr)
+            onAllocatable();
+    }
+
+    template<class T, class... ConstructionArgs>
+    uint64_t SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Tagged(uint32_t index, uint64_t previous)
+    {
+        return (((previous >> 32) + 1) << 32) | index;
+    }
+
+    template<class T, class... ConstructionArgs>
+    uint32_t SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Index(uint64_t tagged)
+    {
+        return static_cast<uint32_t>(tagged);
+    }
+
+    template<class T, class... ConstructionArgs>
+    typename SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Node* SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::AllocateNode()
+    {
+        auto head = freeList.load(std::memory_order_acquire);
+        while (Index(head) != noNode)
+        {
+            auto next = elements[Index(head)].next.load(std::memory_order_relaxed);
+
+            if (freeList.compare_exchange_weak(head, Tagged(next, head), std::memory_order_acquire, std::memory_order_acquire))
+            {
+                UpdateHighWaterMark(allocated.fetch_add(1, std::memory_order_relaxed) + 1);
+                return &elements[Index(head)];
+            }
+        }
+
+        return nullptr;
+    }
+
+    template<class T, class... ConstructionArgs>
+    void SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::UpdateHighWaterMark(std::size_t allocatedNow)
+    {
+        auto mark = highWaterMark.load(std::memory_order_relaxed);
+        while (allocatedNow > mark && !highWaterMark.compare_exchange_weak(mark, allocatedNow, std::memory_order_relaxed))
+        {}
+    }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+    template<class T, class... ConstructionArgs>
+    SharedObjectAllocatorFixedSizeLockFree<T, void(ConstructionArgs...)>::Node::Node(SharedObjectDeleter* allocator)
+        : detail::SharedPtrControl(&*object, allocator) //NOSONAR
+    {}
+
+#pragma GCC diagnostic pop
+}
+
+#endif
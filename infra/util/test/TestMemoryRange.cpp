@@ -2,6 +2,7 @@
 #include "infra/util/ByteRange.hpp"
 #include "infra/util/MemoryRange.hpp"
 #include "gtest/gtest.h"
+#include <string>
 
 TEST(MemoryRangeTest, TestConstructedEmpty)
 {
@@ -258,6 +259,37 @@ TEST(MemoryRangeTest, FindAndSplit)
     EXPECT_EQ(infra::ByteRange(range.data() + 2, range.data() + 4), second);
 }
 
+TEST(MemoryRangeTest, FindAndSplit_without_match)
+{
+    std::array<uint8_t, 4> range{ 1, 2, 3, 4 };
+    infra::ConstByteRange first, second;
+    std::tie(first, second) = infra::FindAndSplit(infra::MakeRange(range), 5);
+    EXPECT_EQ(infra::ByteRange(range), first);
+    EXPECT_TRUE(second.empty());
+    EXPECT_EQ(range.data() + 4, second.begin());
+
+    std::tie(first, second) = infra::FindAndSplit(infra::ConstByteRange(), 0);
+    EXPECT_TRUE(first.empty());
+    EXPECT_TRUE(second.empty());
+}
+
+TEST(MemoryRangeTest, FindAndSplit_on_non_byte_range)
+{
+    std::array<uint16_t, 4> range{ 1, 0x302, 3, 4 };
+    auto [first, second] = infra::FindAndSplit(infra::MakeRange(range), 3);
+    EXPECT_EQ(2, first.size());
+    EXPECT_EQ(2, second.size());
+}
+
+TEST(MemoryRangeTest, FindAndSplit_on_char_range)
+{
+    std::string text = "ab\x80"
+                       "c";
+    auto [first, second] = infra::FindAndSplit(infra::MemoryRange<const char>(text.data(), text.data() + text.size()), '\x80');
+    EXPECT_EQ(2, first.size());
+    EXPECT_EQ(2, second.size());
+}
+
 TEST(MemoryRangeTest, Convert)
 {
     std::array<uint8_t, 4> range{ 1, 2, 3, 4 };
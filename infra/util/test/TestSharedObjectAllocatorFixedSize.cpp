@@ -38,6 +38,22 @@ TEST_F(SharedObjectAllocatorFixedSizeTest, when_allocation_fails_empty_SharedPtr
     EXPECT_FALSE(static_cast<bool>(object));
 }
 
+TEST_F(SharedObjectAllocatorFixedSizeTest, Allocated_and_HighWaterMark_count_allocated_objects)
+{
+    infra::SharedObjectAllocatorFixedSize<int, void()>::WithStorage<4> allocator;
+
+    {
+        infra::SharedPtr<int> object1 = allocator.Allocate();
+        infra::SharedPtr<int> object2 = allocator.Allocate();
+        EXPECT_EQ(2, allocator.Allocated());
+    }
+
+    infra::SharedPtr<int> object = allocator.Allocate();
+    EXPECT_EQ(1, allocator.Allocated());
+    EXPECT_EQ(2, allocator.HighWaterMark());
+    EXPECT_FALSE(allocator.NoneAllocated());
+}
+
 TEST_F(SharedObjectAllocatorFixedSizeTest, object_is_destructed_but_not_deallocated_while_WeakPtr_has_a_reference)
 {
     infra::SharedObjectAllocatorFixedSize<infra::MonitoredConstructionObject, void(infra::ConstructionMonitorMock&)>::WithStorage<1> allocator;
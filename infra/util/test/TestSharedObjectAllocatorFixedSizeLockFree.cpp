@@ -0,0 +1,109 @@
+#include "infra/util/SharedObjectAllocatorFixedSizeLockFree.hpp"
+#include "infra/util/SharedPtr.hpp"
+#include "infra/util/test_helper/MockCallback.hpp"
+#include "infra/util/test_helper/MonitoredConstructionObject.hpp"
+#include "gmock/gmock.h"
+#include <thread>
+#include <vector>
+
+class SharedObjectAllocatorFixedSizeLockFreeTest
+    : public testing::Test
+{
+public:
+    testing::StrictMock<infra::ConstructionMonitorMock> objectConstructionMock;
+};
+
+TEST_F(SharedObjectAllocatorFixedSizeLockFreeTest, allocate_one_object)
+{
+    infra::SharedObjectAllocatorFixedSizeLockFree<infra::MonitoredConstructionObject, void(infra::ConstructionMonitorMock&)>::WithStorage<2> allocator;
+
+    EXPECT_TRUE(allocator.NoneAllocated());
+
+    void* savedObject;
+    EXPECT_CALL(objectConstructionMock, Construct(testing::_)).WillOnce(testing::SaveArg<0>(&savedObject));
+    infra::SharedPtr<infra::MonitoredConstructionObject> object = allocator.Allocate(objectConstructionMock);
+    EXPECT_TRUE(static_cast<bool>(object));
+
+    EXPECT_FALSE(allocator.NoneAllocated());
+    EXPECT_EQ(1, allocator.Allocated());
+    EXPECT_CALL(objectConstructionMock, Destruct(savedObject));
+    object = nullptr;
+    EXPECT_TRUE(allocator.NoneAllocated());
+}
+
+TEST_F(SharedObjectAllocatorFixedSizeLockFreeTest, when_allocation_fails_empty_SharedPtr_is_returned)
+{
+    infra::SharedObjectAllocatorFixedSizeLockFree<int, void()>::WithStorage<1> allocator;
+
+    infra::SharedPtr<int> object1 = allocator.Allocate();
+    infra::SharedPtr<int> object2 = allocator.Allocate();
+    EXPECT_TRUE(static_cast<bool>(object1));
+    EXPECT_FALSE(static_cast<bool>(object2));
+}
+
+TEST_F(SharedObjectAllocatorFixedSizeLockFreeTest, released_object_is_reused)
+{
+    infra::SharedObjectAllocatorFixedSizeLockFree<int, void()>::WithStorage<1> allocator;
+
+    allocator.Allocate();
+    EXPECT_TRUE(static_cast<bool>(allocator.Allocate()));
+}
+
+TEST_F(SharedObjectAllocatorFixedSizeLockFreeTest, high_water_mark_holds_the_largest_number_of_allocated_objects)
+{
+    infra::SharedObjectAllocatorFixedSizeLockFree<int, void()>::WithStorage<4> allocator;
+
+    {
+        infra::SharedPtr<int> object1 = allocator.Allocate();
+        infra::SharedPtr<int> object2 = allocator.Allocate();
+        infra::SharedPtr<int> object3 = allocator.Allocate();
+    }
+
+    infra::SharedPtr<int> object = allocator.Allocate();
+
+    EXPECT_EQ(1, allocator.Allocated());
+    EXPECT_EQ(3, allocator.HighWaterMark());
+}
+
+TEST_F(SharedObjectAllocatorFixedSizeLockFreeTest, invoke_on_allocatable_when_object_is_released)
+{
+    infra::SharedObjectAllocatorFixedSizeLockFree<int, void()>::WithStorage<1> allocator;
+
+    infra::SharedPtr<int> object = allocator.Allocate();
+
+    testing::StrictMock<infra::MockCallback<void()>> callback;
+    allocator.OnAllocatable([&]()
+        {
+            callback.callback();
+        });
+
+    EXPECT_CALL(callback, callback());
+    object = nullptr;
+}
+
+TEST_F(SharedObjectAllocatorFixedSizeLockFreeTest, objects_are_allocated_and_released_from_multiple_threads)
+{
+    static constexpr std::size_t numberOfThreads = 4;
+    infra::SharedObjectAllocatorFixedSizeLockFree<int, void(int)>::WithStorage<numberOfThreads * 2> allocator;
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i != numberOfThreads; ++i)
+        threads.emplace_back([&allocator, i]()
+            {
+                for (int iteration = 0; iteration != 10000; ++iteration)
+                {
+                    infra::SharedPtr<int> object1 = allocator.Allocate(iteration);
+                    infra::SharedPtr<int> object2 = allocator.Allocate(static_cast<int>(i));
+                    ASSERT_TRUE(static_cast<bool>(object1));
+                    ASSERT_TRUE(static_cast<bool>(object2));
+                    EXPECT_EQ(iteration, *object1);
+                    EXPECT_EQ(static_cast<int>(i), *object2);
+                }
+            });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_TRUE(allocator.NoneAllocated());
+    EXPECT_GE(numberOfThreads * 2, allocator.HighWaterMark());
+}
@@ -0,0 +1,80 @@
+#include "infra/util/ByteRange.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Measures the throughput of infra::FindAndSplit on the access pattern of the COBS encoders in SesameCobs and
+// MessageCommunicationCobs: the data is scanned for the next zero byte in chunks of at most 254 bytes. As a baseline,
+// the same scan is done with std::find, which is what FindAndSplit used before it searched byte ranges with memchr.
+//
+// Usage: infra.util_benchmark [size in MiB, default 64] [repetitions, default 10]
+
+namespace
+{
+    const std::size_t maxChunkSize = 254;
+
+    std::vector<uint8_t> GenerateData(std::size_t size)
+    {
+        std::vector<uint8_t> result(size);
+        uint32_t state = 2463534242u;
+
+        for (auto& byte : result)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            byte = static_cast<uint8_t>(state);
+        }
+
+        return result;
+    }
+
+    template<class Find>
+    std::size_t Scan(infra::ConstByteRange data, Find find)
+    {
+        std::size_t chunks = 0;
+
+        while (!data.empty())
+        {
+            auto length = find(infra::Head(data, maxChunkSize));
+            data = infra::DiscardHead(data, length + 1);
+            ++chunks;
+        }
+
+        return chunks;
+    }
+
+    template<class Find>
+    void Measure(const char* name, infra::ConstByteRange data, std::size_t repetitions, Find find)
+    {
+        std::size_t chunks = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i != repetitions; ++i)
+            chunks += Scan(data, find);
+
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << data.size() * repetitions / seconds / 1e6 << " MB/s (" << chunks / repetitions << " chunks)" << std::endl;
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    std::size_t size = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64) * 1024 * 1024;
+    std::size_t repetitions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+    auto data = GenerateData(size);
+
+    Measure("std::find   ", infra::MakeRange(data), repetitions, [](infra::ConstByteRange chunk)
+        {
+            return static_cast<std::size_t>(std::find(chunk.begin(), chunk.end(), 0) - chunk.begin());
+        });
+    Measure("FindAndSplit", infra::MakeRange(data), repetitions, [](infra::ConstByteRange chunk)
+        {
+            return infra::FindAndSplit(chunk, 0).first.size();
+        });
+
+    return 0;
+}
@@ -0,0 +1,531 @@
+#include "args.hxx"
+#include "hal/generic/EthernetFileDescriptorStation.hpp"
+#include "hal/generic/EthernetMacSimulated.hpp"
+#include "hal/generic/EthernetTapStation.hpp"
+#include "hal/generic/SynchronousRandomDataGeneratorGeneric.hpp"
+#include "hal/generic/TimerServiceGeneric.hpp"
+#include "infra/util/SharedOptional.hpp"
+#include "lwip/lwip_cpp/LightweightIp.hpp"
+#include "lwip/lwip_cpp/LightweightIpOverEthernet.hpp"
+#include "services/network/HttpServer.hpp"
+#include "services/network/SingleConnectionListener.hpp"
+#include "services/network_instantiations/NetworkAdapter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs the lwIP stack in this process on an EthernetLinkSimulated, and measures the throughput of an echo server or an
+// HTTP server running on lwIP. The link adds latency and loss between lwIP and its peer, so that lwIP options can be
+// compared under repeatable conditions. The peer is either the host's network stack through an EthernetTapStation,
+// which needs a TAP interface, or a second lwIP stack in a child process, joined through a socketpair, which needs no
+// privileges. lwIP has global state, so each stack runs in its own process.
+
+namespace
+{
+    const services::IPv4Address lwIpAddress{ 10, 10, 0, 2 };
+    const hal::MacAddress lwIpMacAddress{ 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+    const services::IPv4Address peerAddress{ 10, 10, 0, 1 };
+    const hal::MacAddress peerMacAddress{ 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+    constexpr uint16_t echoPort = 7;
+    constexpr uint16_t httpPort = 80;
+
+    class EchoConnection
+        : public services::ConnectionObserver
+    {
+    public:
+        void SendStreamAvailable(infra::SharedPtr<infra::StreamWriter>&& writer) override
+        {
+            {
+                auto reader = Subject().ReceiveStream();
+                infra::DataInputStream::WithErrorPolicy input(*reader);
+                infra::DataOutputStream::WithErrorPolicy output(*writer);
+
+                while (!input.Empty() && output.Available() != 0)
+                    output << input.ContiguousRange(output.Available());
+
+                Subject().AckReceived();
+            }
+
+            writer = nullptr;
+            sending = false;
+
+            DataReceived();
+        }
+
+        void DataReceived() override
+        {
+            if (!sending && !Subject().ReceiveStream()->Empty())
+            {
+                sending = true;
+                Subject().RequestSendStream(Subject().MaxSendStreamSize());
+            }
+        }
+
+    private:
+        bool sending = false;
+    };
+
+    class Benchmark
+        : public services::ClientConnectionObserverFactory
+    {
+    public:
+        explicit Benchmark(uint16_t port)
+            : port(port)
+        {}
+
+        void Start(services::ConnectionFactory& connectionFactory)
+        {
+            this->connectionFactory = &connectionFactory;
+            start = std::chrono::steady_clock::now();
+            connectionFactory.Connect(*this);
+        }
+
+        bool Done() const
+        {
+            return done;
+        }
+
+        // Implementation of ClientConnectionObserverFactory
+        services::IPAddress Address() const override
+        {
+            return lwIpAddress;
+        }
+
+        uint16_t Port() const override
+        {
+            return port;
+        }
+
+        void ConnectionFailed(ConnectFailReason reason) override
+        {
+            throw std::runtime_error("Connecting to lwIP failed");
+        }
+
+    protected:
+        void Finish(const std::string& result)
+        {
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            std::cout << result << " in " << duration.count() << " us" << std::endl;
+            done = true;
+        }
+
+        std::chrono::duration<double> Elapsed() const
+        {
+            return std::chrono::steady_clock::now() - start;
+        }
+
+    protected:
+        services::ConnectionFactory* connectionFactory = nullptr;
+
+    private:
+        uint16_t port;
+        std::chrono::steady_clock::time_point start;
+        bool done = false;
+    };
+
+    class EchoBenchmark
+        : public Benchmark
+    {
+    public:
+        explicit EchoBenchmark(std::size_t size)
+            : Benchmark(echoPort)
+            , size(size)
+        {}
+
+        void ConnectionEstablished(infra::AutoResetFunction<void(infra::SharedPtr<services::ConnectionObserver> connectionObserver)>&& createdObserver) override
+        {
+            createdObserver(connection.Emplace(*this));
+        }
+
+    private:
+        class Connection
+            : public services::ConnectionObserver
+        {
+        public:
+            explicit Connection(EchoBenchmark& benchmark)
+                : benchmark(benchmark)
+            {}
+
+            void Attached() override
+            {
+                RequestSendStream();
+            }
+
+            void SendStreamAvailable(infra::SharedPtr<infra::StreamWriter>&& writer) override
+            {
+                infra::DataOutputStream::WithErrorPolicy stream(*writer);
+
+                while (stream.Available() != 0 && sent != benchmark.size)
+                {
+                    auto chunk = std::min({ stream.Available(), benchmark.size - sent, pattern.size() });
+                    stream << infra::Head(infra::MakeRange(pattern), chunk);
+                    sent += chunk;
+                }
+
+                writer = nullptr;
+                RequestSendStream();
+            }
+
+            void DataReceived() override
+            {
+                {
+                    auto reader = Subject().ReceiveStream();
+                    infra::DataInputStream::WithErrorPolicy stream(*reader);
+
+                    while (!stream.Empty())
+                        received += stream.ContiguousRange().size();
+
+                    Subject().AckReceived();
+                }
+
+                if (received == benchmark.size)
+                {
+                    benchmark.Report();
+                    Subject().CloseAndDestroy();
+                }
+            }
+
+        private:
+            void RequestSendStream()
+            {
+                if (sent != benchmark.size)
+                    Subject().RequestSendStream(std::min(benchmark.size - sent, Subject().MaxSendStreamSize()));
+            }
+
+        private:
+            EchoBenchmark& benchmark;
+            std::array<uint8_t, 256> pattern{};
+            std::size_t sent = 0;
+            std::size_t received = 0;
+        };
+
+        void Report()
+        {
+            Finish("Echoed " + std::to_string(size) + " bytes (" + std::to_string(static_cast<uint64_t>(size / Elapsed().count())) + " bytes/s)");
+        }
+
+    private:
+        std::size_t size;
+        infra::SharedOptional<Connection> connection;
+    };
+
+    class HttpBenchmark
+        : public Benchmark
+    {
+    public:
+        HttpBenchmark(std::size_t pageSize, std::size_t requests)
+            : Benchmark(httpPort)
+            , pageSize(pageSize)
+            , requests(requests)
+        {}
+
+        void ConnectionEstablished(infra::AutoResetFunction<void(infra::SharedPtr<services::ConnectionObserver> connectionObserver)>&& createdObserver) override
+        {
+            createdObserver(connection.Emplace(*this));
+        }
+
+    private:
+        class Connection
+            : public services::ConnectionObserver
+        {
+        public:
+            explicit Connection(HttpBenchmark& benchmark)
+                : benchmark(benchmark)
+            {}
+
+            void Attached() override
+            {
+                Subject().RequestSendStream(request.size());
+            }
+
+            void SendStreamAvailable(infra::SharedPtr<infra::StreamWriter>&& writer) override
+            {
+                infra::TextOutputStream::WithErrorPolicy stream(*writer);
+                stream << request;
+                writer = nullptr;
+            }
+
+            void DataReceived() override
+            {
+                {
+                    auto reader = Subject().ReceiveStream();
+                    infra::DataInputStream::WithErrorPolicy stream(*reader);
+
+                    while (!stream.Empty())
+                    {
+                        auto range = stream.ContiguousRange();
+                        response.append(range.begin(), range.end());
+                    }
+
+                    Subject().AckReceived();
+                }
+
+                auto headerEnd = response.find("\r\n\r\n");
+                if (headerEnd != std::string::npos && response.size() - headerEnd - 4 >= benchmark.pageSize)
+                {
+                    ++benchmark.completed;
+                    Subject().CloseAndDestroy();
+                }
+            }
+
+        private:
+            HttpBenchmark& benchmark;
+            const std::string request = "GET / HTTP/1.1\r\nHost: lwip\r\n\r\n";
+            std::string response;
+        };
+
+        void ConnectionReleased()
+        {
+            if (completed != requests)
+                connectionFactory->Connect(*this);
+            else
+                Finish("Served " + std::to_string(requests) + " requests (" + std::to_string(static_cast<uint64_t>(requests / Elapsed().count())) + " requests/s)");
+        }
+
+    private:
+        std::size_t pageSize;
+        std::size_t requests;
+        std::size_t completed = 0;
+        infra::NotifyingSharedOptional<Connection> connection{ [this]()
+            {
+                ConnectionReleased();
+            } };
+    };
+
+    class Started
+        : public services::Stoppable
+    {
+    public:
+        void Stop(const infra::Function<void()>& onDone) override
+        {
+            onDone();
+        }
+    };
+
+    // An lwIP stack on the link, configured with a fixed address
+    class LwIpStation
+    {
+    public:
+        LwIpStation(hal::EthernetLinkSimulated& link, hal::MacAddress macAddress, services::IPv4Address address,
+            infra::CreatorBase<services::Stoppable, void(services::LightweightIp& lightweightIp)>& connectedCreator)
+            : mac(link, macAddress)
+            , lightweightIp(randomDataGenerator, connectedCreator)
+            , ethernet(macAddress, EthernetConfig(address))
+        {
+            ethernet.Create(mac);
+        }
+
+        services::LightweightIp& LightweightIp()
+        {
+            return lightweightIp;
+        }
+
+    private:
+        static services::LightweightIpOverEthernetFactory::Config EthernetConfig(services::IPv4Address address)
+        {
+            services::LightweightIpOverEthernetFactory::Config config;
+            config.hostName = "lwip-benchmark";
+            config.hostName.push_back('\0');
+            config.ipConfig = { false, { address, { 255, 255, 255, 0 }, peerAddress } };
+            return config;
+        }
+
+    private:
+        hal::SynchronousRandomDataGeneratorGeneric randomDataGenerator;
+        hal::EthernetMacSimulated mac;
+        services::LightweightIp::WithFixedAllocator<2, 1, 2> lightweightIp;
+        services::LightweightIpOverEthernetFactory ethernet;
+    };
+
+    // The echo server or the HTTP server that is measured
+    class Server
+    {
+    public:
+        Server(services::ConnectionFactory& connectionFactory, bool http, const std::string& page)
+        {
+            if (http)
+            {
+                httpServer.emplace(connectionFactory, httpPort);
+                httpPage.emplace("", page, "text/plain");
+                httpServer->AddPage(*httpPage);
+            }
+            else
+                echoServer.emplace(connectionFactory, echoPort, services::SingleConnectionListener::Creators{ echoCreator });
+        }
+
+    private:
+        infra::Creator<services::ConnectionObserver, EchoConnection, void(services::IPAddress address)> echoCreator{ [](std::optional<EchoConnection>& value, services::IPAddress address)
+            {
+                value.emplace();
+            } };
+        std::optional<services::SingleConnectionListener> echoServer;
+        std::optional<services::DefaultHttpServer::WithBuffer<2048>> httpServer;
+        std::optional<services::HttpPageWithContent> httpPage;
+    };
+
+    // Starts a child process with the lwIP stack that serves, joined to the link of this process through a socketpair
+    pid_t StartServerProcess(bool http, const std::string& page, int& fileDescriptor)
+    {
+        int sockets[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets) != 0)
+            throw std::runtime_error("Creating socketpair failed");
+
+        auto server = fork();
+        if (server == -1)
+            throw std::runtime_error("Starting server process failed");
+
+        if (server == 0)
+        {
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            close(sockets[0]);
+
+            static main_::NetworkAdapter network;
+            static hal::TimerServiceGeneric timerService;
+            static hal::EthernetLinkSimulated link;
+            static hal::EthernetFileDescriptorStation client(link, sockets[1]);
+            static infra::Creator<services::Stoppable, Started, void(services::LightweightIp& lightweightIp)> connectedCreator([](std::optional<Started>& value, services::LightweightIp& lightweightIp)
+                {
+                    value.emplace();
+                });
+            static LwIpStation lwIp(link, lwIpMacAddress, lwIpAddress, connectedCreator);
+            static Server server(lwIp.LightweightIp(), http, page);
+
+            // Runs until terminated by the parent
+            network.Run();
+        }
+
+        close(sockets[1]);
+        fileDescriptor = sockets[0];
+        return server;
+    }
+
+    void ReportStatistics(const hal::EthernetLinkSimulated& link, const services::NetworkStatistics& network)
+    {
+        auto linkStatistics = link.GetStatistics();
+        std::cout << "Link: " << linkStatistics.framesTransmitted << " frames transmitted, " << linkStatistics.framesLost << " lost" << std::endl;
+
+        // These remain zero unless lwip.lwip_conf is compiled with LWIP_STATS=1
+        auto statistics = network.GetStatistics();
+        std::cout << "TCP: " << statistics.tcp.transmitted << " transmitted, " << statistics.tcp.received << " received, "
+                  << statistics.tcp.dropped << " dropped, " << statistics.tcp.errors << " errors" << std::endl;
+        std::cout << "Memory errors: " << statistics.memoryErrors << std::endl;
+    }
+}
+
+int main(int argc, const char* argv[], const char* env[])
+{
+    args::ArgumentParser parser("Measures throughput of lwIP on a simulated Ethernet link.");
+    args::HelpFlag help(parser, "help", "Display this help menu.", { 'h', "help" });
+    args::ValueFlag<std::string> peer(parser, "peer", "Peer of lwIP: host, through a TAP interface, or lwip, in a child process.", { "peer" }, "host");
+    args::ValueFlag<std::string> tap(parser, "interface", "TAP interface that connects the link to the host.", { "tap" }, "emil0");
+    args::ValueFlag<std::string> mode(parser, "mode", "Traffic: echo or http.", { "mode" }, "echo");
+    args::ValueFlag<std::size_t> size(parser, "bytes", "Bytes to echo, or size of the HTTP page.", { "size" }, 1000000);
+    args::ValueFlag<std::size_t> requests(parser, "count", "Number of HTTP requests.", { "requests" }, 100);
+    args::ValueFlag<uint32_t> latency(parser, "ms", "Latency of the link in milliseconds.", { "latency" }, 0);
+    args::ValueFlag<double> loss(parser, "probability", "Probability that a frame is lost.", { "loss" }, 0);
+    args::ValueFlag<uint32_t> seed(parser, "seed", "Seed for frame loss.", { "seed" }, 0);
+
+    try
+    {
+        parser.ParseCLI(argc, argv);
+
+        if (args::get(mode) != "echo" && args::get(mode) != "http")
+            throw std::runtime_error("Unknown mode " + args::get(mode));
+        if (args::get(peer) != "host" && args::get(peer) != "lwip")
+            throw std::runtime_error("Unknown peer " + args::get(peer));
+
+        bool http = args::get(mode) == "http";
+        bool peerIsHost = args::get(peer) == "host";
+        static std::string page(http ? args::get(size) : 0, 'x');
+
+        // The server process is started before anything else is created, so that it starts from a clean state
+        int serverFileDescriptor = -1;
+        pid_t serverProcess = peerIsHost ? 0 : StartServerProcess(http, page, serverFileDescriptor);
+
+        static main_::NetworkAdapter network;
+        static hal::TimerServiceGeneric timerService;
+
+        hal::EthernetLinkSimulated::Config linkConfig;
+        linkConfig.latency = std::chrono::milliseconds(args::get(latency));
+        linkConfig.lossProbability = args::get(loss);
+        linkConfig.seed = args::get(seed);
+        static hal::EthernetLinkSimulated link(linkConfig);
+
+        static std::optional<EchoBenchmark> echoBenchmark;
+        static std::optional<HttpBenchmark> httpBenchmark;
+        static Benchmark* benchmark = nullptr;
+        if (http)
+            benchmark = &httpBenchmark.emplace(page.size(), args::get(requests));
+        else
+            benchmark = &echoBenchmark.emplace(args::get(size));
+
+        static std::optional<hal::EthernetTapStation> host;
+        static std::optional<hal::EthernetFileDescriptorStation> server;
+        static std::optional<LwIpStation> lwIp;
+        static std::optional<Server> lwIpServer;
+
+        if (peerIsHost)
+        {
+            // lwIP serves, and the host connects to it as soon as lwIP is up
+            static infra::Creator<services::Stoppable, Started, void(services::LightweightIp& lightweightIp)> connectedCreator([](std::optional<Started>& value, services::LightweightIp& lightweightIp)
+                {
+                    value.emplace();
+                    benchmark->Start(network.ConnectionFactory());
+                });
+
+            host.emplace(link, args::get(tap));
+            lwIp.emplace(link, lwIpMacAddress, lwIpAddress, connectedCreator);
+            lwIpServer.emplace(lwIp->LightweightIp(), http, page);
+        }
+        else
+        {
+            // lwIP in the child process serves, and lwIP in this process connects to it
+            static infra::Creator<services::Stoppable, Started, void(services::LightweightIp& lightweightIp)> connectedCreator([](std::optional<Started>& value, services::LightweightIp& lightweightIp)
+                {
+                    value.emplace();
+                    benchmark->Start(lightweightIp);
+                });
+
+            server.emplace(link, serverFileDescriptor);
+            lwIp.emplace(link, peerMacAddress, peerAddress, connectedCreator);
+        }
+
+        network.ExecuteUntil([]()
+            {
+                return benchmark->Done();
+            });
+
+        ReportStatistics(link, lwIp->LightweightIp());
+
+        if (!peerIsHost)
+        {
+            kill(serverProcess, SIGTERM);
+            waitpid(serverProcess, nullptr, 0);
+        }
+    }
+    catch (const args::Help&)
+    {
+        std::cout << parser;
+        return 0;
+    }
+    catch (const args::Error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
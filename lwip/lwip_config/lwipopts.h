@@ -23,11 +23,18 @@ extern "C"
 uint32_t StaticLwIpRand();
 #define LWIP_RAND() StaticLwIpRand()
 #define MEM_ALIGNMENT 4
+
+// Products tune memory and throughput by defining these for lwip.lwip_conf, e.g. target_compile_definitions(lwip.lwip_conf PUBLIC MEM_SIZE=16000 TCP_MSS=1460).
+// The TCP window and send buffer sizes (TCP_MSS, TCP_WND, TCP_SND_BUF, TCP_SND_QUEUELEN) default to the values of lwip/opt.h and can be defined in the same way.
+#ifndef LWIP_STATS
 #define LWIP_STATS 0
+#endif
 
 #define LWIP_DNS_SECURE 0
 
+#ifndef MEM_SIZE
 #define MEM_SIZE 3200
+#endif
 
 #define CHECKSUM_GEN_IP 0
 #define CHECKSUM_GEN_UDP 0
@@ -0,0 +1,7 @@
+#include <chrono>
+#include <cstdint>
+
+extern "C" std::uint32_t sys_now()
+{
+    return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
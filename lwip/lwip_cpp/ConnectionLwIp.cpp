@@ -64,15 +64,15 @@ namespace services
 
         while (!sendBuffers.empty())
         {
-            RemoveFromPool(sendBuffers.front());
+            Release(sendBuffers.front());
             sendBuffers.pop_front();
         }
 
         if (!sendBufferForStream.empty())
-            RemoveFromPool(sendBufferForStream);
+            Release({ sendBufferForStream, sendPbufForStream });
 
-        if (!sendBuffer.empty())
-            RemoveFromPool(sendBuffer);
+        if (!sendBuffer.range.empty())
+            Release(sendBuffer);
 
         if (sendMemoryPoolWaiting.has_element(*this))
             sendMemoryPoolWaiting.erase(*this);
@@ -170,17 +170,17 @@ namespace services
 
     bool ConnectionLwIp::PendingSend() const
     {
-        return !(sendBuffers.empty() && sendBufferForStream.empty() && sendBuffer.empty());
+        return !(sendBuffers.empty() && sendBufferForStream.empty() && sendBuffer.range.empty());
     }
 
-    void ConnectionLwIp::SendBuffer(infra::ConstByteRange buffer)
+    void ConnectionLwIp::SendBuffer(QueuedBuffer buffer)
     {
-        err_t result = tcp_write(control, buffer.begin(), static_cast<uint16_t>(buffer.size()), 0);
+        err_t result = tcp_write(control, buffer.range.begin(), static_cast<uint16_t>(buffer.range.size()), 0);
         if (result == ERR_OK)
         {
             tcp_output(control);
             sendBuffers.push_back(buffer);
-            sendBuffer.clear();
+            sendBuffer = QueuedBuffer{};
 
             if (closing)
                 CloseAndDestroy();
@@ -198,17 +198,16 @@ namespace services
     void ConnectionLwIp::TryAllocateSendStream()
     {
         assert(streamWriter.Allocatable());
-        if (!sendBuffers.full() && !sendMemoryPool.full() && sendBuffer.empty())
+        if (!SendQueueFull() && sendBuffer.range.empty() && AllocateSendBuffer())
         {
             if (sendMemoryPoolWaiting.has_element(*this))
                 sendMemoryPoolWaiting.erase(*this);
 
-            sendMemoryPool.emplace_back();
-            sendBufferForStream = infra::Head(infra::ByteRange(sendMemoryPool.back()), requestedSendSize);
             infra::EventDispatcherWithWeakPtr::Instance().Schedule([](const infra::SharedPtr<ConnectionLwIp>& self)
                 {
-                    infra::SharedPtr<infra::StreamWriter> stream = self->streamWriter.Emplace(*self, self->sendBufferForStream);
+                    infra::SharedPtr<infra::StreamWriter> stream = self->streamWriter.Emplace(*self, self->sendBufferForStream, self->sendPbufForStream);
                     self->sendBufferForStream = infra::ByteRange();
+                    self->sendPbufForStream = nullptr;
                     if (self->IsAttached())
                         self->Observer().SendStreamAvailable(std::move(stream));
                     if (self->closing)
@@ -218,13 +217,50 @@ namespace services
 
             requestedSendSize = 0;
         }
-        else if (sendMemoryPool.full())
+        else if (factory.config.sendFromPbufs && !SendQueueFull() && sendBuffer.range.empty())
+        {
+            // The lwIP heap is exhausted, and there may be no pending acknowledgements that trigger a new attempt
+            retryAllocationTimer.Start(std::chrono::milliseconds(50), [this]()
+                {
+                    if (requestedSendSize != 0)
+                        TryAllocateSendStream();
+                });
+        }
+        else if (!factory.config.sendFromPbufs && sendMemoryPool.full())
         {
             if (!sendMemoryPoolWaiting.has_element(*this))
                 sendMemoryPoolWaiting.push_back(*this);
         }
     }
 
+    bool ConnectionLwIp::AllocateSendBuffer()
+    {
+        if (factory.config.sendFromPbufs)
+        {
+            sendPbufForStream = pbuf_alloc(PBUF_RAW, static_cast<uint16_t>(requestedSendSize), PBUF_RAM);
+            if (sendPbufForStream == nullptr)
+                return false;
+
+            auto payload = static_cast<uint8_t*>(sendPbufForStream->payload);
+            sendBufferForStream = infra::ByteRange(payload, payload + requestedSendSize);
+        }
+        else
+        {
+            if (sendMemoryPool.full())
+                return false;
+
+            sendMemoryPool.emplace_back();
+            sendBufferForStream = infra::Head(infra::ByteRange(sendMemoryPool.back()), requestedSendSize);
+        }
+
+        return true;
+    }
+
+    bool ConnectionLwIp::SendQueueFull() const
+    {
+        return sendBuffers.size() >= factory.config.sendQueueLength;
+    }
+
     void ConnectionLwIp::AbortControl()
     {
         DisableCallbacks();
@@ -311,16 +347,16 @@ namespace services
         while (len != 0)
         {
             really_assert(!sendBuffers.empty());
-            if (sendBuffers.front().size() <= len)
+            if (sendBuffers.front().range.size() <= len)
             {
-                len -= static_cast<uint16_t>(sendBuffers.front().size());
+                len -= static_cast<uint16_t>(sendBuffers.front().range.size());
 
-                RemoveFromPool(sendBuffers.front());
+                Release(sendBuffers.front());
                 sendBuffers.pop_front();
             }
             else
             {
-                sendBuffers.front().pop_front(len);
+                sendBuffers.front().range.pop_front(len);
                 len = 0;
             }
         }
@@ -354,19 +390,28 @@ namespace services
             sendMemoryPoolWaiting.front().TryAllocateSendStream();
     }
 
-    ConnectionLwIp::StreamWriterLwIp::StreamWriterLwIp(ConnectionLwIp& connection, infra::ByteRange sendBuffer)
+    void ConnectionLwIp::Release(QueuedBuffer buffer)
+    {
+        if (buffer.buffer != nullptr)
+            pbuf_free(buffer.buffer);
+        else
+            RemoveFromPool(buffer.range);
+    }
+
+    ConnectionLwIp::StreamWriterLwIp::StreamWriterLwIp(ConnectionLwIp& connection, infra::ByteRange sendBuffer, pbuf* buffer)
         : infra::ByteOutputStreamWriter(sendBuffer)
         , connection(connection)
+        , buffer(buffer)
     {}
 
     ConnectionLwIp::StreamWriterLwIp::~StreamWriterLwIp()
     {
         if (!Processed().empty() && connection.control != nullptr)
-            connection.SendBuffer(Processed());
+            connection.SendBuffer({ Processed(), buffer });
         else if (!Processed().empty())
-            connection.RemoveFromPool(Processed());
+            connection.Release({ Processed(), buffer });
         else
-            connection.RemoveFromPool(Remaining());
+            connection.Release({ Remaining(), buffer });
     }
 
     ConnectionLwIp::StreamReaderLwIp::StreamReaderLwIp(ConnectionLwIp& connection)
@@ -724,11 +769,14 @@ namespace services
         control = nullptr;
     }
 
-    ConnectionFactoryLwIp::ConnectionFactoryLwIp(AllocatorListenerLwIp& listenerAllocator, infra::BoundedList<ConnectorLwIp>& connectors, AllocatorConnectionLwIp& connectionAllocator)
+    ConnectionFactoryLwIp::ConnectionFactoryLwIp(AllocatorListenerLwIp& listenerAllocator, infra::BoundedList<ConnectorLwIp>& connectors, AllocatorConnectionLwIp& connectionAllocator, const Config& config)
         : listenerAllocator(listenerAllocator)
         , connectors(connectors)
         , connectionAllocator(connectionAllocator)
-    {}
+        , config(config)
+    {
+        assert(config.sendQueueLength != 0 && config.sendQueueLength <= tcpSndQueueLen);
+    }
 
     infra::SharedPtr<void> ConnectionFactoryLwIp::Listen(uint16_t port, ServerConnectionObserverFactory& factory, IPVersions versions)
     {
@@ -52,8 +52,16 @@ namespace services
         bool PendingSend() const;
 
     private:
-        void SendBuffer(infra::ConstByteRange buffer);
+        struct QueuedBuffer
+        {
+            infra::ConstByteRange range;
+            pbuf* buffer; // Owns range when sending from pbufs, nullptr when range is taken from sendMemoryPool
+        };
+
+        void SendBuffer(QueuedBuffer buffer);
         void TryAllocateSendStream();
+        bool AllocateSendBuffer();
+        bool SendQueueFull() const;
         void AbortControl();
         void DisableCallbacks();
 
@@ -67,17 +75,19 @@ namespace services
         err_t Sent(uint16_t len);
         void Destroy();
         void RemoveFromPool(infra::ConstByteRange range);
+        void Release(QueuedBuffer buffer);
 
     private:
         class StreamWriterLwIp
             : public infra::ByteOutputStreamWriter
         {
         public:
-            StreamWriterLwIp(ConnectionLwIp& connection, infra::ByteRange sendBuffer);
+            StreamWriterLwIp(ConnectionLwIp& connection, infra::ByteRange sendBuffer, pbuf* buffer);
             ~StreamWriterLwIp();
 
         private:
             ConnectionLwIp& connection;
+            pbuf* buffer;
         };
 
         class StreamReaderLwIp
@@ -117,10 +127,12 @@ namespace services
         infra::NotifyingSharedOptional<StreamReaderLwIp> streamReader;
         infra::SharedPtr<void> keepAliveForReader;
 
-        infra::ConstByteRange sendBuffer;
+        QueuedBuffer sendBuffer{};
         infra::TimerSingleShot retrySendTimer;
-        infra::BoundedDeque<infra::ConstByteRange>::WithMaxSize<tcpSndQueueLen> sendBuffers;
+        infra::TimerSingleShot retryAllocationTimer;
+        infra::BoundedDeque<QueuedBuffer>::WithMaxSize<tcpSndQueueLen> sendBuffers;
         infra::ByteRange sendBufferForStream;
+        pbuf* sendPbufForStream = nullptr;
         static infra::BoundedList<std::array<uint8_t, TCP_MSS>>::WithMaxSize<tcpSndQueueLen> sendMemoryPool;
         static infra::IntrusiveList<ConnectionLwIp> sendMemoryPoolWaiting;
 
@@ -193,6 +205,20 @@ namespace services
         : public ConnectionFactory
     {
     public:
+        struct Config
+        {
+            Config()
+            {}
+
+            // Maximum number of send streams of a connection that are not yet acknowledged, at most tcpSndQueueLen
+            std::size_t sendQueueLength = tcpSndQueueLen;
+
+            // When false, send streams are taken from a pool of tcpSndQueueLen buffers of TCP_MSS bytes, shared by all connections.
+            // When true, send streams are pbufs of the requested size, allocated from the lwIP heap (MEM_SIZE).
+            // In both cases, tcp_write refers to the written data without copying it.
+            bool sendFromPbufs = false;
+        };
+
         template<std::size_t MaxListeners, std::size_t MaxConnectors, std::size_t MaxConnections>
         using WithFixedAllocator = infra::WithStorage<infra::WithStorage<infra::WithStorage<ConnectionFactoryLwIp,
                                                                              AllocatorListenerLwIp::UsingAllocator<infra::SharedObjectAllocatorFixedSize>::WithStorage<MaxListeners>>,
@@ -200,7 +226,7 @@ namespace services
             AllocatorConnectionLwIp::UsingAllocator<infra::SharedObjectAllocatorFixedSize>::WithStorage<MaxConnections>>;
 
     public:
-        ConnectionFactoryLwIp(AllocatorListenerLwIp& listenerAllocator, infra::BoundedList<ConnectorLwIp>& connectors, AllocatorConnectionLwIp& connectionAllocator);
+        ConnectionFactoryLwIp(AllocatorListenerLwIp& listenerAllocator, infra::BoundedList<ConnectorLwIp>& connectors, AllocatorConnectionLwIp& connectionAllocator, const Config& config = Config());
 
         infra::SharedPtr<void> Listen(uint16_t port, ServerConnectionObserverFactory& factory, IPVersions versions = IPVersions::both) override;
         void Connect(ClientConnectionObserverFactory& factory) override;
@@ -219,6 +245,7 @@ namespace services
         infra::IntrusiveList<ClientConnectionObserverFactory> waitingConnectors;
         infra::BoundedList<ConnectorLwIp>& connectors;
         AllocatorConnectionLwIp& connectionAllocator;
+        Config config;
         infra::IntrusiveForwardList<ConnectionLwIp> connections;
     };
 }
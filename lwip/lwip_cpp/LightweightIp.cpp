@@ -1,5 +1,6 @@
 #include "lwip/lwip_cpp/LightweightIp.hpp"
 #include "lwip/init.h"
+#include "lwip/stats.h"
 #include "services/network/Address.hpp"
 #ifndef ESP_PLATFORM
 #include "lwip/timeouts.h"
@@ -57,14 +58,27 @@ namespace services
                     return {};
             }
         }
+
+#if LWIP_STATS
+        [[maybe_unused]] NetworkStatistics::Protocol Convert(const stats_proto& statistics)
+        {
+            return {
+                statistics.xmit,
+                statistics.recv,
+                statistics.drop,
+                static_cast<uint32_t>(statistics.chkerr + statistics.lenerr + statistics.memerr + statistics.rterr + statistics.proterr + statistics.opterr + statistics.err)
+            };
+        }
+#endif
     }
 
     infra::IntrusiveList<LightweightIp> LightweightIp::instances;
     netif_ext_callback_t LightweightIp::instanceCallback;
 
     LightweightIp::LightweightIp(AllocatorListenerLwIp& listenerAllocator, infra::BoundedList<ConnectorLwIp>& connectors, AllocatorConnectionLwIp& connectionAllocator,
-        hal::SynchronousRandomDataGenerator& randomDataGenerator, infra::CreatorBase<services::Stoppable, void(LightweightIp& lightweightIp)>& connectedCreator)
-        : ConnectionFactoryLwIp(listenerAllocator, connectors, connectionAllocator)
+        hal::SynchronousRandomDataGenerator& randomDataGenerator, infra::CreatorBase<services::Stoppable, void(LightweightIp& lightweightIp)>& connectedCreator,
+        const ConnectionFactoryLwIp::Config& config)
+        : ConnectionFactoryLwIp(listenerAllocator, connectors, connectionAllocator, config)
         , connectedCreator(connectedCreator)
     {
         ::randomDataGenerator = &randomDataGenerator;
@@ -109,6 +123,34 @@ namespace services
         return {};
     }
 
+    NetworkStatistics::Statistics LightweightIp::GetStatistics() const
+    {
+        Statistics statistics;
+
+#if LWIP_STATS
+#if LINK_STATS
+        statistics.link = Convert(lwip_stats.link);
+#endif
+#if IP_STATS
+        statistics.ipv4 = Convert(lwip_stats.ip);
+#endif
+#if IP6_STATS
+        statistics.ipv6 = Convert(lwip_stats.ip6);
+#endif
+#if TCP_STATS
+        statistics.tcp = Convert(lwip_stats.tcp);
+#endif
+#if UDP_STATS
+        statistics.udp = Convert(lwip_stats.udp);
+#endif
+#if MEM_STATS
+        statistics.memoryErrors = lwip_stats.mem.err;
+#endif
+#endif
+
+        return statistics;
+    }
+
     void LightweightIp::RegisterInstance()
     {
         if (instances.empty())
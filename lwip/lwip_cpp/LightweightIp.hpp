@@ -8,6 +8,7 @@
 #include "lwip/lwip_cpp/MulticastLwIp.hpp"
 #include "services/network/Address.hpp"
 #include "services/network/ConnectionStatus.hpp"
+#include "services/network/NetworkStatistics.hpp"
 #include "services/util/Stoppable.hpp"
 
 namespace services
@@ -18,6 +19,7 @@ namespace services
         , public MulticastLwIp
         , public IPInfo
         , public ConnectionStatus
+        , public NetworkStatistics
         , public infra::IntrusiveList<LightweightIp>::NodeType
     {
     public:
@@ -28,7 +30,8 @@ namespace services
             AllocatorConnectionLwIp::UsingAllocator<infra::SharedObjectAllocatorFixedSize>::WithStorage<MaxConnections>>;
 
         LightweightIp(AllocatorListenerLwIp& listenerAllocator, infra::BoundedList<ConnectorLwIp>& connectors, AllocatorConnectionLwIp& connectionAllocator,
-            hal::SynchronousRandomDataGenerator& randomDataGenerator, infra::CreatorBase<services::Stoppable, void(LightweightIp& lightweightIp)>& connectedCreator);
+            hal::SynchronousRandomDataGenerator& randomDataGenerator, infra::CreatorBase<services::Stoppable, void(LightweightIp& lightweightIp)>& connectedCreator,
+            const ConnectionFactoryLwIp::Config& config = ConnectionFactoryLwIp::Config());
         ~LightweightIp() override;
 
         // Implementation of ConnectionStatus
@@ -39,6 +42,9 @@ namespace services
         IPv4InterfaceAddresses GetIPv4InterfaceAddresses() const override;
         IPv6Address LinkLocalAddress() const override;
 
+        // Implementation of NetworkStatistics, which reports zeroes when LWIP_STATS is disabled
+        Statistics GetStatistics() const override;
+
     private:
         void RegisterInstance();
         void DeregisterInstance();
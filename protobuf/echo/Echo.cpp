@@ -4,7 +4,7 @@ namespace services
 {
     void Service::MethodDone()
     {
-        Rpc().ServiceDone();
+        Rpc().MethodDone(*this);
     }
 
     Echo& Service::Rpc()
@@ -12,6 +12,11 @@ namespace services
         return Subject();
     }
 
+    void Echo::MethodDone(Service& service)
+    {
+        ServiceDone();
+    }
+
     ServiceProxy::ServiceProxy(Echo& echo, uint32_t maxMessageSize)
         : echo(echo)
         , maxMessageSize(maxMessageSize)
@@ -69,6 +69,7 @@ namespace services
     public:
         virtual void RequestSend(ServiceProxy& serviceProxy) = 0;
         virtual void ServiceDone() = 0;
+        virtual void MethodDone(Service& service);
         virtual void CancelRequestSend(ServiceProxy& serviceProxy) = 0;
         virtual services::MethodSerializerFactory& SerializerFactory() = 0;
     };
@@ -32,12 +32,33 @@ namespace services
 
     void EchoOnStreams::ServiceDone()
     {
+        if (!activeMethods.empty())
+        {
+            // Only the dummy deserializer invokes ServiceDone directly, services invoke MethodDone
+            ActiveMethodDone(nullptr);
+            return;
+        }
+
         ReleaseDeserializer();
 
         if (readerPtr != nullptr)
             DataReceived();
     }
 
+    void EchoOnStreams::MethodDone(Service& service)
+    {
+        if (!activeMethods.empty())
+            ActiveMethodDone(&service);
+        else
+            ServiceDone();
+    }
+
+    void EchoOnStreams::EnableConcurrentMethods(infra::MemoryRange<ActiveMethod> activeMethods)
+    {
+        really_assert(!activeMethods.empty());
+        this->activeMethods = activeMethods;
+    }
+
     void EchoOnStreams::CancelRequestSend(ServiceProxy& serviceProxy)
     {
         if (sendRequesters.has_element(serviceProxy))
@@ -86,6 +107,7 @@ namespace services
         ReleaseReader();
         limitedReader.reset();
         ReleaseDeserializer();
+        waitingForActiveMethod = false;
     }
 
     void EchoOnStreams::ReleaseDeserializer()
@@ -146,7 +168,7 @@ namespace services
         if (limitedReader != std::nullopt && readerPtr != nullptr)
             ContinueReceiveMessage();
 
-        while (readerPtr != nullptr && methodDeserializer == nullptr && !limitedReaderAccess.Referenced())
+        while (readerPtr != nullptr && methodDeserializer == nullptr && !limitedReaderAccess.Referenced() && !waitingForActiveMethod)
         {
             if (limitedReader == std::nullopt)
                 StartReceiveMessage();
@@ -181,6 +203,12 @@ namespace services
         }
         else if (formatErrorPolicy.Failed() || !std::holds_alternative<infra::PartialProtoLengthDelimited>(contents))
             errorPolicy.MessageFormatError();
+        else if (!activeMethods.empty() && !CanStartMethod(serviceId))
+        {
+            // The message is parsed again once an active method is done
+            bufferedReader->Rewind(start);
+            waitingForActiveMethod = true;
+        }
         else
         {
             limitedReader.emplace(*bufferedReader, std::get<infra::PartialProtoLengthDelimited>(contents).length);
@@ -220,6 +248,7 @@ namespace services
                 {
                     if (service.AcceptsService(serviceId))
                     {
+                        receivingService = &service;
                         methodDeserializer = StartingMethod(serviceId, methodId, service.StartMethod(serviceId, methodId, size, errorPolicy));
                         return true;
                     }
@@ -228,6 +257,7 @@ namespace services
                 }))
         {
             errorPolicy.ServiceNotFound(serviceId);
+            receivingService = nullptr;
             methodDeserializer = StartingMethod(serviceId, methodId, deserializerDummy.Emplace(*this));
         }
     }
@@ -246,6 +276,13 @@ namespace services
                 errorPolicy.MessageFormatError();
                 ReleaseDeserializer();
             }
+            else if (!activeMethods.empty())
+            {
+                auto activeMethod = FindFreeActiveMethod();
+                activeMethod->service = receivingService;
+                activeMethod->deserializer = std::move(methodDeserializer);
+                activeMethod->deserializer->ExecuteMethod();
+            }
             else
                 methodDeserializer->ExecuteMethod();
         }
@@ -257,4 +294,64 @@ namespace services
             DataReceived();
         }
     }
+
+    Service* EchoOnStreams::FindService(uint32_t serviceId)
+    {
+        Service* result = nullptr;
+
+        NotifyObservers([&result, serviceId](auto& service)
+            {
+                if (service.AcceptsService(serviceId))
+                {
+                    result = &service;
+                    return true;
+                }
+
+                return false;
+            });
+
+        return result;
+    }
+
+    EchoOnStreams::ActiveMethod* EchoOnStreams::FindActiveMethod(Service* service)
+    {
+        for (auto& activeMethod : activeMethods)
+            if (activeMethod.deserializer != nullptr && activeMethod.service == service)
+                return &activeMethod;
+
+        return nullptr;
+    }
+
+    EchoOnStreams::ActiveMethod* EchoOnStreams::FindFreeActiveMethod()
+    {
+        for (auto& activeMethod : activeMethods)
+            if (activeMethod.deserializer == nullptr)
+                return &activeMethod;
+
+        return nullptr;
+    }
+
+    bool EchoOnStreams::CanStartMethod(uint32_t serviceId)
+    {
+        // A service executes one method at a time, so a second message for the same service waits
+        auto service = FindService(serviceId);
+        return FindFreeActiveMethod() != nullptr && (service == nullptr || FindActiveMethod(service) == nullptr);
+    }
+
+    void EchoOnStreams::ActiveMethodDone(Service* service)
+    {
+        auto activeMethod = FindActiveMethod(service);
+
+        really_assert(activeMethod != nullptr);
+        activeMethod->service = nullptr;
+        activeMethod->deserializer = nullptr;
+
+        if (waitingForActiveMethod)
+        {
+            waitingForActiveMethod = false;
+
+            if (readerPtr != nullptr)
+                DataReceived();
+        }
+    }
 }
@@ -6,6 +6,7 @@
 #include "infra/util/Function.hpp"
 #include "protobuf/echo/Echo.hpp"
 #include "protobuf/echo/Serialization.hpp"
+#include <array>
 #include <optional>
 
 namespace services
@@ -14,6 +15,15 @@ namespace services
         : public EchoWithPolicy
     {
     public:
+        struct ActiveMethod
+        {
+            Service* service = nullptr;
+            infra::SharedPtr<MethodDeserializer> deserializer;
+        };
+
+        template<std::size_t MaxConcurrentMethods>
+        using ActiveMethods = std::array<ActiveMethod, MaxConcurrentMethods>;
+
         explicit EchoOnStreams(services::MethodSerializerFactory& serializerFactory, const EchoErrorPolicy& errorPolicy = echoErrorPolicyAbortOnMessageFormatError);
         ~EchoOnStreams();
 
@@ -23,6 +33,13 @@ namespace services
         void ServiceDone() override;
         void CancelRequestSend(ServiceProxy& serviceProxy) override;
         services::MethodSerializerFactory& SerializerFactory() override;
+        void MethodDone(Service& service) override;
+
+        // By default, a method must be done before the next message is processed. After enabling concurrent methods, up to
+        // activeMethods.size() methods of different services execute concurrently, while messages for a service that is still
+        // executing a method are held back. The serializer factory must provide memory for that many deserializers at the same time,
+        // see MethodSerializerFactory::ForServices<...>::Concurrent<...>. Tracing of deserializers is not supported in this mode.
+        void EnableConcurrentMethods(infra::MemoryRange<ActiveMethod> activeMethods);
 
     protected:
         virtual infra::SharedPtr<MethodSerializer> GrantSend(ServiceProxy& proxy);
@@ -45,6 +62,12 @@ namespace services
         void StartMethod(uint32_t serviceId, uint32_t methodId, uint32_t size);
         void LimitedReaderDone();
 
+        Service* FindService(uint32_t serviceId);
+        ActiveMethod* FindActiveMethod(Service* service);
+        ActiveMethod* FindFreeActiveMethod();
+        bool CanStartMethod(uint32_t serviceId);
+        void ActiveMethodDone(Service* service);
+
     private:
         static EchoPolicy defaultPolicy;
 
@@ -69,6 +92,10 @@ namespace services
 
         bool delayDataReceived = false;
         bool delayedDataReceived = false;
+
+        infra::MemoryRange<ActiveMethod> activeMethods;
+        Service* receivingService = nullptr;
+        bool waitingForActiveMethod = false;
     };
 }
 
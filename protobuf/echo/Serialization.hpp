@@ -5,6 +5,8 @@
 #include "infra/util/SharedOptional.hpp"
 #include "protobuf/echo/ProtoMessageReceiver.hpp"
 #include "protobuf/echo/ProtoMessageSender.hpp"
+#include <algorithm>
+#include <array>
 
 namespace services
 {
@@ -192,6 +194,15 @@ namespace services
     public:
         template<class... ServiceProxies>
         class AndProxies;
+
+        // Provides memory for up to MaxConcurrentMethods deserializers at the same time, for use with concurrently executing methods
+        template<std::size_t MaxConcurrentMethods>
+        class Concurrent
+        {
+        public:
+            template<class... ServiceProxies>
+            class AndProxies;
+        };
     };
 
     template<class... Services>
@@ -212,6 +223,30 @@ namespace services
         infra::AccessedBySharedPtr deserializerAccess{ infra::emptyFunction };
     };
 
+    template<class... Services>
+    template<std::size_t MaxConcurrentMethods>
+    template<class... ServiceProxies>
+    class MethodSerializerFactory::ForServices<Services...>::Concurrent<MaxConcurrentMethods>::AndProxies
+        : public MethodSerializerFactory
+    {
+    public:
+        infra::SharedPtr<infra::ByteRange> SerializerMemory(uint32_t size) override;
+        infra::SharedPtr<infra::ByteRange> DeserializerMemory(uint32_t size) override;
+
+    private:
+        struct DeserializerSlot
+        {
+            alignas(std::max_align_t) std::array<uint8_t, MaxServiceSize<Services...>::maxSize> storage;
+            infra::ByteRange memory;
+            infra::AccessedBySharedPtr access{ infra::emptyFunction };
+        };
+
+        alignas(std::max_align_t) std::array<uint8_t, MaxServiceProxySize<ServiceProxies...>::maxSize> serializerStorage;
+        infra::ByteRange serializerMemory;
+        infra::AccessedBySharedPtr serializerAccess{ infra::emptyFunction };
+        std::array<DeserializerSlot, MaxConcurrentMethods> deserializerSlots;
+    };
+
     class MethodSerializerFactory::OnHeap
         : public MethodSerializerFactory
     {
@@ -343,6 +378,32 @@ namespace services
         deserializerMemory = infra::Head(infra::MakeRange(deserializerStorage), size);
         return deserializerAccess.MakeShared(deserializerMemory);
     }
+
+    template<class... Services>
+    template<std::size_t MaxConcurrentMethods>
+    template<class... ServiceProxies>
+    infra::SharedPtr<infra::ByteRange> MethodSerializerFactory::ForServices<Services...>::Concurrent<MaxConcurrentMethods>::AndProxies<ServiceProxies...>::SerializerMemory(uint32_t size)
+    {
+        really_assert(size <= serializerStorage.size());
+        serializerMemory = infra::Head(infra::MakeRange(serializerStorage), size);
+        return serializerAccess.MakeShared(serializerMemory);
+    }
+
+    template<class... Services>
+    template<std::size_t MaxConcurrentMethods>
+    template<class... ServiceProxies>
+    infra::SharedPtr<infra::ByteRange> MethodSerializerFactory::ForServices<Services...>::Concurrent<MaxConcurrentMethods>::AndProxies<ServiceProxies...>::DeserializerMemory(uint32_t size)
+    {
+        auto slot = std::find_if(deserializerSlots.begin(), deserializerSlots.end(), [](const DeserializerSlot& slot)
+            {
+                return !slot.access.Referenced();
+            });
+
+        really_assert(slot != deserializerSlots.end());
+        really_assert(size <= slot->storage.size());
+        slot->memory = infra::Head(infra::MakeRange(slot->storage), size);
+        return slot->access.MakeShared(slot->memory);
+    }
 }
 
 #endif
@@ -0,0 +1,131 @@
+#include "args.hxx"
+#include "infra/stream/IoOutputStream.hpp"
+#include "services/tracer/BinaryTraceDecoder.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    template<class T>
+    T Read(const std::vector<uint8_t>& file, std::size_t offset)
+    {
+        if (offset + sizeof(T) > file.size())
+            throw std::runtime_error("ELF file is truncated");
+
+        T result;
+        std::memcpy(&result, file.data() + offset, sizeof(T));
+        return result;
+    }
+
+    // Returns the contents of the section with the given name from a little-endian ELF32 or ELF64 file
+    std::vector<uint8_t> ElfSection(const std::vector<uint8_t>& file, const std::string& name)
+    {
+        if (file.size() < 6 || file[0] != 0x7f || file[1] != 'E' || file[2] != 'L' || file[3] != 'F' || file[5] != 1)
+            throw std::runtime_error("Not a little-endian ELF file");
+
+        bool elf64 = file[4] == 2;
+        auto sectionHeaderOffset = elf64 ? Read<uint64_t>(file, 0x28) : Read<uint32_t>(file, 0x20);
+        auto sectionHeaderSize = Read<uint16_t>(file, elf64 ? 0x3a : 0x2e);
+        auto numberOfSections = Read<uint16_t>(file, elf64 ? 0x3c : 0x30);
+        auto stringTableIndex = Read<uint16_t>(file, elf64 ? 0x3e : 0x32);
+
+        auto sectionOffset = [&](std::size_t index)
+        {
+            auto header = sectionHeaderOffset + index * sectionHeaderSize;
+            return elf64 ? Read<uint64_t>(file, header + 0x18) : Read<uint32_t>(file, header + 0x10);
+        };
+
+        auto sectionSize = [&](std::size_t index)
+        {
+            auto header = sectionHeaderOffset + index * sectionHeaderSize;
+            return elf64 ? Read<uint64_t>(file, header + 0x20) : Read<uint32_t>(file, header + 0x14);
+        };
+
+        auto names = sectionOffset(stringTableIndex);
+
+        for (std::size_t index = 0; index != numberOfSections; ++index)
+        {
+            auto nameOffset = names + Read<uint32_t>(file, sectionHeaderOffset + index * sectionHeaderSize);
+            if (nameOffset + name.size() < file.size() && std::memcmp(file.data() + nameOffset, name.c_str(), name.size() + 1) == 0)
+            {
+                auto offset = sectionOffset(index);
+                auto size = sectionSize(index);
+                if (offset + size > file.size())
+                    throw std::runtime_error("ELF file is truncated");
+
+                return std::vector<uint8_t>(file.begin() + offset, file.begin() + offset + size);
+            }
+        }
+
+        throw std::runtime_error("Section " + name + " not found; no binary traces are interned in this ELF file");
+    }
+
+    void Decode(const std::vector<uint8_t>& formats, std::istream& input)
+    {
+        infra::IoOutputStream output;
+        services::BinaryTraceDecoder decoder(infra::MakeRange(formats), output);
+
+        std::vector<uint8_t> pending;
+        std::vector<char> chunk(4096);
+
+        while (input.read(chunk.data(), chunk.size()) || input.gcount() != 0)
+        {
+            pending.insert(pending.end(), chunk.begin(), chunk.begin() + input.gcount());
+
+            infra::ConstByteRange data = infra::MakeRange(pending);
+            decoder.Decode(data);
+            pending.erase(pending.begin(), pending.end() - data.size());
+            std::cout.flush();
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char* argv[], const char* env[])
+{
+    std::string toolname = argv[0];
+    args::ArgumentParser parser(toolname + " converts records emitted by services::BinaryTracer into text.");
+    args::Positional<std::string> elf(parser, "elf", "ELF file of the firmware which emitted the trace records", args::Options::Required);
+    args::Positional<std::string> trace(parser, "trace", "File holding the trace records. When absent, records are read from standard input");
+    args::HelpFlag h(parser, "help", "help", { 'h', "help" });
+
+    try
+    {
+        parser.Prog(toolname);
+        parser.ParseCLI(argc, argv);
+
+        std::ifstream elfFile(args::get(elf), std::ios::binary);
+        if (!elfFile)
+            throw std::runtime_error("Cannot open " + args::get(elf));
+
+        auto formats = ElfSection(std::vector<uint8_t>(std::istreambuf_iterator<char>(elfFile), std::istreambuf_iterator<char>()), "emil_trace_formats");
+
+        if (trace)
+        {
+            std::ifstream traceFile(args::get(trace), std::ios::binary);
+            if (!traceFile)
+                throw std::runtime_error("Cannot open " + args::get(trace));
+
+            Decode(formats, traceFile);
+        }
+        else
+            Decode(formats, std::cin);
+    }
+    catch (const args::Help&)
+    {
+        std::cout << parser;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include "infra/util/BoundedString.hpp"
 #include "infra/util/IntrusiveList.hpp"
 #include "services/cucumber/CucumberContext.hpp"
+#include <array>
 
 namespace services
 {
@@ -31,8 +32,25 @@ namespace services
         services::CucumberContext& Context();
 
     private:
+        friend class CucumberStepStorage;
+
+        // A node in the step-pattern trie of CucumberStepStorage. Adding a step to the trie creates at most two nodes,
+        // so each step carries the nodes that it adds; the trie needs no further storage
+        struct IndexNode
+        {
+            infra::BoundedConstString label;
+            IndexNode* firstChild = nullptr;
+            IndexNode* nextSibling = nullptr;
+            CucumberStep* steps = nullptr;
+        };
+
         infra::BoundedConstString stepName;
         infra::BoundedConstString sourceLocation;
+
+        std::array<IndexNode, 2> indexNodes;
+        std::size_t indexNodesUsed = 0;
+        CucumberStep* nextStepWithSamePattern = nullptr;
+        uint32_t id = 0;
     };
 
     class CucumberStepArguments
@@ -60,6 +60,96 @@ namespace
 
         return skippedSize;
     }
+
+    // A pattern is a sequence of tokens: literal characters and placeholders. A placeholder is followed by any marker
+    // characters that MatchesStepName skips, and the string placeholder includes its opening quote, so that each token
+    // is matched without looking back into the pattern.
+    struct Token
+    {
+        enum class Kind
+        {
+            literal,
+            stringArgument,
+            integerArgument,
+            booleanArgument
+        };
+
+        Kind kind;
+        char character;
+        std::size_t size;
+
+        bool operator==(const Token& other) const
+        {
+            return kind == other.kind && character == other.character;
+        }
+
+        bool operator!=(const Token& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    Token NextToken(infra::BoundedConstString pattern)
+    {
+        if (pattern.starts_with(R"('%s')"))
+        {
+            auto marker = pattern.substr(1).begin();
+            return { Token::Kind::stringArgument, 0, 1 + SkipMarker(marker, pattern.end()) };
+        }
+
+        auto marker = pattern.begin();
+        if (pattern.starts_with("%d"))
+            return { Token::Kind::integerArgument, 0, SkipMarker(marker, pattern.end()) };
+        if (pattern.starts_with("%b"))
+            return { Token::Kind::booleanArgument, 0, SkipMarker(marker, pattern.end()) };
+
+        return { Token::Kind::literal, pattern.front(), 1 };
+    }
+
+    // Returns the number of characters at the start of nameToMatch that are matched by token, or npos
+    std::size_t MatchToken(const Token& token, infra::BoundedConstString nameToMatch)
+    {
+        auto iterator = nameToMatch.begin();
+
+        switch (token.kind)
+        {
+            case Token::Kind::literal:
+                return !nameToMatch.empty() && nameToMatch.front() == token.character ? 1 : infra::BoundedConstString::npos;
+            case Token::Kind::stringArgument:
+                if (nameToMatch.empty() || nameToMatch.front() != '\'')
+                    return infra::BoundedConstString::npos;
+                ++iterator;
+                return 1 + SkipStringArgument(iterator, nameToMatch.end());
+            case Token::Kind::integerArgument:
+                return SkipIntegerArgument(iterator, nameToMatch.end());
+            case Token::Kind::booleanArgument:
+                if (nameToMatch.starts_with("true"))
+                    return 4;
+                if (nameToMatch.starts_with("false"))
+                    return 5;
+                return 0;
+            default:
+                return infra::BoundedConstString::npos;
+        }
+    }
+
+    std::size_t MatchLabel(infra::BoundedConstString label, infra::BoundedConstString nameToMatch)
+    {
+        std::size_t matchedSize = 0;
+
+        while (!label.empty())
+        {
+            auto token = NextToken(label);
+            auto tokenMatchedSize = MatchToken(token, nameToMatch.substr(matchedSize));
+            if (tokenMatchedSize == infra::BoundedConstString::npos)
+                return infra::BoundedConstString::npos;
+
+            matchedSize += tokenMatchedSize;
+            label = label.substr(token.size);
+        }
+
+        return matchedSize;
+    }
 }
 
 namespace services
@@ -113,27 +203,29 @@ namespace services
     {
         Match matchResult{};
         uint32_t nrStepMatches = 0;
-        uint32_t count = 0;
 
-        for (auto& step : stepList)
-        {
-            if (MatchesStepName(step, nameToMatch))
-            {
-                matchResult.id = count;
-                nrStepMatches++;
-            }
-            count++;
-        }
+        // MatchesStepName matches a marker in a step name literally when the name to match contains it,
+        // which the trie does not model; such names are matched against each step
+        if (nameToMatch.find('%') == infra::BoundedConstString::npos)
+            MatchIndexNode(indexRoot, nameToMatch, matchResult, nrStepMatches);
+        else
+            for (auto& step : stepList)
+                if (MatchesStepName(step, nameToMatch))
+                {
+                    matchResult.id = step.id;
+                    matchResult.step = &step;
+                    nrStepMatches++;
+                }
 
         if (nrStepMatches >= 2)
             matchResult.result = StepMatchResult::Duplicate;
         else if (nrStepMatches == 0)
             matchResult.result = StepMatchResult::Fail;
         else
-        {
             matchResult.result = StepMatchResult::Success;
-            matchResult.step = &GetStep(matchResult.id);
-        }
+
+        if (matchResult.result != StepMatchResult::Success)
+            matchResult.step = nullptr;
 
         return matchResult;
     }
@@ -146,16 +238,118 @@ namespace services
 
     void CucumberStepStorage::AddStep(CucumberStep& step)
     {
+        step.id = stepList.size();
         stepList.push_back(step);
+        Index(step);
     }
 
     void CucumberStepStorage::DeleteStep(CucumberStep& step)
     {
         stepList.erase(step);
+        Reindex();
     }
 
     void CucumberStepStorage::ClearStorage()
     {
         stepList.clear();
+        indexRoot = IndexNode();
+    }
+
+    void CucumberStepStorage::Index(CucumberStep& step)
+    {
+        step.indexNodes.fill(IndexNode());
+        step.indexNodesUsed = 0;
+
+        auto pattern = step.StepName();
+        auto node = &indexRoot;
+
+        while (!pattern.empty())
+        {
+            auto token = NextToken(pattern);
+            auto child = node->firstChild;
+            while (child != nullptr && NextToken(child->label) != token)
+                child = child->nextSibling;
+
+            if (child == nullptr)
+            {
+                auto& leaf = NewIndexNode(step);
+                leaf.label = pattern;
+                leaf.nextSibling = node->firstChild;
+                node->firstChild = &leaf;
+                node = &leaf;
+                break;
+            }
+
+            auto label = child->label;
+            std::size_t commonSize = 0;
+            while (commonSize != label.size() && !pattern.empty())
+            {
+                auto labelToken = NextToken(label.substr(commonSize));
+                auto patternToken = NextToken(pattern);
+                if (labelToken != patternToken)
+                    break;
+
+                commonSize += labelToken.size;
+                pattern = pattern.substr(patternToken.size);
+            }
+
+            if (commonSize != label.size())
+            {
+                auto& branch = NewIndexNode(step);
+                branch.label = label.substr(0, commonSize);
+                branch.firstChild = child;
+                branch.nextSibling = child->nextSibling;
+
+                auto link = &node->firstChild;
+                while (*link != child)
+                    link = &(*link)->nextSibling;
+                *link = &branch;
+
+                child->label = label.substr(commonSize);
+                child->nextSibling = nullptr;
+                child = &branch;
+            }
+
+            node = child;
+        }
+
+        step.nextStepWithSamePattern = node->steps;
+        node->steps = &step;
+    }
+
+    void CucumberStepStorage::Reindex()
+    {
+        indexRoot = IndexNode();
+
+        uint32_t id = 0;
+        for (auto& step : stepList)
+        {
+            step.id = id++;
+            Index(step);
+        }
+    }
+
+    CucumberStepStorage::IndexNode& CucumberStepStorage::NewIndexNode(CucumberStep& step)
+    {
+        really_assert(step.indexNodesUsed != step.indexNodes.size());
+        return step.indexNodes[step.indexNodesUsed++];
+    }
+
+    void CucumberStepStorage::MatchIndexNode(const IndexNode& node, infra::BoundedConstString nameToMatch, Match& matchResult, uint32_t& nrStepMatches) const
+    {
+        if (nameToMatch.empty())
+            for (auto step = node.steps; step != nullptr; step = step->nextStepWithSamePattern)
+            {
+                matchResult.id = step->id;
+                matchResult.step = step;
+                nrStepMatches++;
+            }
+
+        for (auto child = node.firstChild; child != nullptr; child = child->nextSibling)
+        {
+            auto matchedSize = MatchLabel(child->label, nameToMatch);
+            if (matchedSize != infra::BoundedConstString::npos)
+                MatchIndexNode(*child, nameToMatch.substr(matchedSize), matchResult, nrStepMatches);
+        }
     }
 }
@@ -6,6 +6,9 @@
 
 namespace services
 {
+    // Steps are matched through a trie over their patterns, in which literal characters and the '%s', %d and %b
+    // placeholders are edges. A name is matched by walking the trie, so that matching does not depend on the number
+    // of registered steps. The trie is built when a step is added, and rebuilt when a step is deleted.
     class CucumberStepStorage
     {
     public:
@@ -38,8 +41,17 @@ namespace services
         void DeleteStep(CucumberStep& step);
         void ClearStorage();
 
+    private:
+        using IndexNode = CucumberStep::IndexNode;
+
+        void Index(CucumberStep& step);
+        void Reindex();
+        IndexNode& NewIndexNode(CucumberStep& step);
+        void MatchIndexNode(const IndexNode& node, infra::BoundedConstString nameToMatch, Match& matchResult, uint32_t& nrStepMatches) const;
+
     private:
         infra::IntrusiveList<CucumberStep> stepList;
+        IndexNode indexRoot;
     };
 }
 
@@ -320,3 +320,64 @@ TEST(CucumberStepStorageTest, MatchStep_duplicate_parameterized_matches)
     auto duplicateMatch = storage.MatchStep("Given I have 'test' parameter");
     EXPECT_EQ(services::CucumberStepStorage::StepMatchResult::Duplicate, duplicateMatch.result);
 }
+
+TEST(CucumberStepStorageTest, MatchStep_distinguishes_steps_with_a_common_prefix)
+{
+    services::CucumberStepStorage storage;
+    StepStub step1("Given I have %d items", "test.cpp:10");
+    StepStub step2("Given I have %b flag", "test.cpp:20");
+    StepStub step3("Given I have '%s' as name", "test.cpp:30");
+    StepStub step4("Given I have items", "test.cpp:40");
+    StepStub step5("Given I have items in stock", "test.cpp:50");
+
+    storage.AddStep(step1);
+    storage.AddStep(step2);
+    storage.AddStep(step3);
+    storage.AddStep(step4);
+    storage.AddStep(step5);
+
+    EXPECT_EQ(&step1, storage.MatchStep("Given I have 42 items").step);
+    EXPECT_EQ(&step2, storage.MatchStep("Given I have true flag").step);
+    EXPECT_EQ(&step3, storage.MatchStep("Given I have 'hello' as name").step);
+    EXPECT_EQ(&step4, storage.MatchStep("Given I have items").step);
+    EXPECT_EQ(&step5, storage.MatchStep("Given I have items in stock").step);
+    EXPECT_EQ(4u, storage.MatchStep("Given I have items in stock").id);
+
+    EXPECT_EQ(services::CucumberStepStorage::StepMatchResult::Fail, storage.MatchStep("Given I have items in").result);
+    EXPECT_EQ(services::CucumberStepStorage::StepMatchResult::Fail, storage.MatchStep("Given I have 42 flag").result);
+}
+
+TEST(CucumberStepStorageTest, MatchStep_after_DeleteStep_returns_updated_id)
+{
+    services::CucumberStepStorage storage;
+    StepStub step1("Given first step", "test.cpp:10");
+    StepStub step2("Given %d step", "test.cpp:20");
+
+    storage.AddStep(step1);
+    storage.AddStep(step2);
+    storage.DeleteStep(step1);
+
+    auto match = storage.MatchStep("Given 2 step");
+    EXPECT_EQ(services::CucumberStepStorage::StepMatchResult::Success, match.result);
+    EXPECT_EQ(&step2, match.step);
+    EXPECT_EQ(0u, match.id);
+
+    storage.AddStep(step1);
+    EXPECT_EQ(1u, storage.MatchStep("Given first step").id);
+}
+
+TEST(CucumberStepStorageTest, MatchStep_name_with_percent_sign)
+{
+    services::CucumberStepStorage storage;
+    StepStub step1("Given a '%s' value", "test.cpp:10");
+    StepStub step2("Given a %d value", "test.cpp:20");
+
+    storage.AddStep(step1);
+    storage.AddStep(step2);
+
+    auto match = storage.MatchStep("Given a '100%' value");
+    EXPECT_EQ(services::CucumberStepStorage::StepMatchResult::Success, match.result);
+    EXPECT_EQ(&step1, match.step);
+
+    EXPECT_EQ(services::CucumberStepStorage::StepMatchResult::Fail, storage.MatchStep("Given a 100% value").result);
+}
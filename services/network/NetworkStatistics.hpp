@@ -0,0 +1,39 @@
+#ifndef SERVICES_NETWORK_STATISTICS_HPP
+#define SERVICES_NETWORK_STATISTICS_HPP
+
+#include <cstdint>
+
+namespace services
+{
+    class NetworkStatistics
+    {
+    protected:
+        NetworkStatistics() = default;
+        NetworkStatistics(const NetworkStatistics& other) = delete;
+        NetworkStatistics& operator=(const NetworkStatistics& other) = delete;
+        ~NetworkStatistics() = default;
+
+    public:
+        struct Protocol
+        {
+            uint32_t transmitted = 0;
+            uint32_t received = 0;
+            uint32_t dropped = 0;
+            uint32_t errors = 0;
+        };
+
+        struct Statistics
+        {
+            Protocol link;
+            Protocol ipv4;
+            Protocol ipv6;
+            Protocol tcp;
+            Protocol udp;
+            uint32_t memoryErrors = 0;
+        };
+
+        virtual Statistics GetStatistics() const = 0;
+    };
+}
+
+#endif
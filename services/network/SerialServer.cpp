@@ -2,17 +2,26 @@
 
 namespace services
 {
-    SerialServerConnectionObserver::SerialServerConnectionObserver(const infra::ByteRange receiveBuffer, hal::SerialCommunication& serialCommunication)
+    SerialServerConnectionObserver::SerialServerConnectionObserver(const infra::ByteRange receiveBuffer, infra::BoundedDeque<uint8_t>& sendBuffer, hal::SerialCommunication& serialCommunication, Statistics& statistics, const Config& config)
         : receiveBuffer(receiveBuffer)
         , receiveQueue(receiveBuffer, [this]
               {
                   SerialDataReceived();
               })
+        , sendBuffer(sendBuffer)
         , serialCommunication(serialCommunication)
+        , statistics(statistics)
+        , config(config)
     {
+        sendBuffer.clear();
+
         serialCommunication.ReceiveData([this](infra::ConstByteRange buffer)
             {
-                receiveQueue.AddFromInterrupt(buffer);
+                auto size = std::min(buffer.size(), receiveQueue.EmptySize() - receiveQueue.Size());
+                this->statistics.serialOverruns += buffer.size() - size;
+
+                if (size != 0)
+                    receiveQueue.AddFromInterrupt(infra::Head(buffer, size));
             });
     }
 
@@ -25,40 +34,101 @@ namespace services
             auto data = infra::Head(receiveQueue.ContiguousRange(), stream.Available());
             stream << data;
             receiveQueue.Consume(data.size());
+            statistics.bytesToConnection += data.size();
         }
 
         writer = nullptr;
         pendingSend = false;
+
+        SerialDataReceived();
     }
 
     void SerialServerConnectionObserver::DataReceived()
     {
-        streamReader = ConnectionObserver::Subject().ReceiveStream();
+        if (receivePending && sendBuffer.size() > config.sendBufferLowWatermark)
+            return;
+
+        auto streamReader = ConnectionObserver::Subject().ReceiveStream();
         infra::DataInputStream::WithErrorPolicy stream(*streamReader);
 
-        serialCommunication.SendData(stream.ContiguousRange(), [this]
+        while (!stream.Empty() && sendBuffer.size() < HighWatermark())
+        {
+            auto data = stream.ContiguousRange(HighWatermark() - sendBuffer.size());
+            sendBuffer.insert(sendBuffer.end(), data.begin(), data.end());
+        }
+
+        receivePending = !stream.Empty();
+        ConnectionObserver::Subject().AckReceived();
+        streamReader = nullptr;
+
+        SendToSerial();
+    }
+
+    void SerialServerConnectionObserver::SerialDataReceived()
+    {
+        if (receiveQueue.Empty() || pendingSend)
+            return;
+
+        if (receiveQueue.Size() >= config.sendThreshold || config.sendDelay == infra::Duration::zero())
+            SendToConnection();
+        else if (!sendDelayTimer.Armed())
+            sendDelayTimer.Start(config.sendDelay, [this]()
+                {
+                    SendToConnection();
+                });
+    }
+
+    void SerialServerConnectionObserver::SendToConnection()
+    {
+        sendDelayTimer.Cancel();
+        pendingSend = true;
+        ConnectionObserver::Subject().RequestSendStream(ConnectionObserver::Subject().MaxSendStreamSize());
+    }
+
+    void SerialServerConnectionObserver::SendToSerial()
+    {
+        if (sendingToSerial || sendBuffer.empty())
+            return;
+
+        sendingToSerial = true;
+        auto data = sendBuffer.contiguous_range(sendBuffer.begin());
+        serialCommunication.SendData(data, [this, size = data.size()]()
             {
-                ConnectionObserver::Subject().AckReceived();
-                streamReader = nullptr;
+                SerialDataSent(size);
             });
     }
 
-    void SerialServerConnectionObserver::SerialDataReceived()
+    void SerialServerConnectionObserver::SerialDataSent(std::size_t size)
     {
-        if (!receiveQueue.Empty() && !pendingSend)
-        {
-            pendingSend = true;
-            ConnectionObserver::Subject().RequestSendStream(ConnectionObserver::Subject().MaxSendStreamSize());
-        }
+        sendingToSerial = false;
+        sendBuffer.erase(sendBuffer.begin(), sendBuffer.begin() + size);
+        statistics.bytesToSerial += size;
+
+        if (receivePending && sendBuffer.size() <= config.sendBufferLowWatermark)
+            DataReceived();
+        else
+            SendToSerial();
+    }
+
+    std::size_t SerialServerConnectionObserver::HighWatermark() const
+    {
+        return std::min(config.sendBufferHighWatermark, sendBuffer.max_size());
     }
 
-    SerialServer::SerialServer(const infra::ByteRange receiveBuffer, hal::SerialCommunication& serialCommunication, services::ConnectionFactory& connectionFactory, uint16_t port)
+    SerialServer::SerialServer(const infra::ByteRange receiveBuffer, infra::BoundedDeque<uint8_t>& sendBuffer, hal::SerialCommunication& serialCommunication, services::ConnectionFactory& connectionFactory, uint16_t port, const Config& config)
         : SingleConnectionListener(connectionFactory, port, { connectionCreator })
         , receiveBuffer(receiveBuffer)
+        , sendBuffer(sendBuffer)
         , serialCommunication(serialCommunication)
+        , config(config)
         , connectionCreator([this](std::optional<SerialServerConnectionObserver>& value, services::IPAddress address)
               {
-                  value.emplace(this->receiveBuffer, this->serialCommunication);
+                  value.emplace(this->receiveBuffer, this->sendBuffer, this->serialCommunication, statistics, this->config);
               })
     {}
+
+    SerialServer::Statistics SerialServer::GetStatistics() const
+    {
+        return statistics;
+    }
 }
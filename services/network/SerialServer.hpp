@@ -3,16 +3,44 @@
 
 #include "hal/interfaces/SerialCommunication.hpp"
 #include "infra/event/QueueForOneReaderOneIrqWriter.hpp"
+#include "infra/timer/Timer.hpp"
 #include "infra/util/BoundedDeque.hpp"
 #include "services/network/SingleConnectionListener.hpp"
+#include <limits>
 
 namespace services
 {
+    // Data received from the serial port is queued in receiveBuffer, and written to the connection when config.sendThreshold
+    // bytes are queued, or when config.sendDelay has passed since data was first queued. Coalescing small chunks this way
+    // results in fewer and larger TCP writes. Data received from the connection is acknowledged as soon as it is copied into
+    // sendBuffer, and sendBuffer is written to the serial port chunk by chunk, so that the serial port is kept busy while
+    // the connection receives more data. Once sendBuffer holds config.sendBufferHighWatermark bytes, no more data is taken
+    // from the connection, so that TCP flow control throttles the peer; taking data resumes when the serial port has
+    // drained sendBuffer to config.sendBufferLowWatermark bytes. The serial port cannot be throttled, so in that direction
+    // config.sendThreshold is the only watermark, and data that does not fit in receiveBuffer is counted as overrun.
     class SerialServerConnectionObserver
         : public services::ConnectionObserver
     {
     public:
-        SerialServerConnectionObserver(const infra::ByteRange receiveBuffer, hal::SerialCommunication& serialCommunication);
+        struct Config
+        {
+            Config() {}
+
+            std::size_t sendThreshold = 1;
+            infra::Duration sendDelay = infra::Duration::zero();
+            std::size_t sendBufferHighWatermark = std::numeric_limits<std::size_t>::max();
+            std::size_t sendBufferLowWatermark = std::numeric_limits<std::size_t>::max();
+        };
+
+        struct Statistics
+        {
+            uint64_t bytesToConnection = 0;
+            uint64_t bytesToSerial = 0;
+            // Bytes received from the serial port that were dropped because receiveBuffer was full
+            uint32_t serialOverruns = 0;
+        };
+
+        SerialServerConnectionObserver(const infra::ByteRange receiveBuffer, infra::BoundedDeque<uint8_t>& sendBuffer, hal::SerialCommunication& serialCommunication, Statistics& statistics, const Config& config = Config());
 
         // Implementation of ConnectionObserver
         void SendStreamAvailable(infra::SharedPtr<infra::StreamWriter>&& writer) override;
@@ -21,26 +49,46 @@ namespace services
     protected:
         virtual void SerialDataReceived();
 
+    private:
+        void SendToConnection();
+        void SendToSerial();
+        void SerialDataSent(std::size_t size);
+        std::size_t HighWatermark() const;
+
     private:
         const infra::ByteRange receiveBuffer;
         infra::QueueForOneReaderOneIrqWriter<uint8_t> receiveQueue;
+        infra::BoundedDeque<uint8_t>& sendBuffer;
         bool pendingSend = false;
+        bool sendingToSerial = false;
+        bool receivePending = false;
         hal::SerialCommunication& serialCommunication;
-        infra::SharedPtr<infra::StreamReader> streamReader = nullptr;
+        Statistics& statistics;
+        Config config;
+        infra::TimerSingleShot sendDelayTimer;
     };
 
     class SerialServer
         : public services::SingleConnectionListener
     {
     public:
-        template<size_t BufferSize>
-        using WithBuffer = infra::WithStorage<SerialServer, std::array<uint8_t, BufferSize>>;
+        using Config = SerialServerConnectionObserver::Config;
+        using Statistics = SerialServerConnectionObserver::Statistics;
+
+        // ReceiveBufferSize bytes hold data from the serial port, SendBufferSize bytes hold data for the serial port
+        template<size_t ReceiveBufferSize, size_t SendBufferSize>
+        using WithBuffers = infra::WithStorage<infra::WithStorage<SerialServer, std::array<uint8_t, ReceiveBufferSize>>, infra::BoundedDeque<uint8_t>::WithMaxSize<SendBufferSize>>;
+
+        SerialServer(const infra::ByteRange receiveBuffer, infra::BoundedDeque<uint8_t>& sendBuffer, hal::SerialCommunication& serialCommunication, services::ConnectionFactory& connectionFactory, uint16_t port, const Config& config = Config());
 
-        SerialServer(const infra::ByteRange receiveBuffer, hal::SerialCommunication& serialCommunication, services::ConnectionFactory& connectionFactory, uint16_t port);
+        Statistics GetStatistics() const;
 
     private:
         const infra::ByteRange receiveBuffer;
+        infra::BoundedDeque<uint8_t>& sendBuffer;
         hal::SerialCommunication& serialCommunication;
+        Config config;
+        Statistics statistics;
         infra::Creator<services::ConnectionObserver, SerialServerConnectionObserver, void(services::IPAddress address)> connectionCreator;
     };
 }
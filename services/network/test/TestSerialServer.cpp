@@ -15,7 +15,8 @@ class SerialServerTest
     , public infra::ClockFixture
 {
 public:
-    SerialServerTest()
+    explicit SerialServerTest(const services::SerialServer::Config& config = services::SerialServer::Config())
+        : config(config)
     {
         connectionFactoryMock.NewConnection(*serverConnectionObserverFactory, *connection, services::IPv4AddressLocalHost());
     }
@@ -29,6 +30,7 @@ public:
         }
     }
 
+    services::SerialServer::Config config;
     infra::SharedOptional<testing::StrictMock<services::ConnectionStub>> connection;
     infra::SharedPtr<services::Connection> connectionPtr{ connection.Emplace() };
     testing::StrictMock<services::ConnectionFactoryMock> connectionFactoryMock;
@@ -38,7 +40,41 @@ public:
         {
             EXPECT_CALL(connectionFactoryMock, Listen(9000, testing::_, services::IPVersions::both)).WillOnce(testing::DoAll(infra::SaveRef<1>(&serverConnectionObserverFactory), testing::Return(nullptr)));
         } };
-    services::SerialServer::WithBuffer<128> serialServer{ serialCommunicationMock, connectionFactoryMock, 9000 };
+    services::SerialServer::WithBuffers<128, 128> serialServer{ serialCommunicationMock, connectionFactoryMock, 9000, config };
+};
+
+class SerialServerCoalescingTest
+    : public SerialServerTest
+{
+public:
+    SerialServerCoalescingTest()
+        : SerialServerTest(CoalescingConfig())
+    {}
+
+    static services::SerialServer::Config CoalescingConfig()
+    {
+        services::SerialServer::Config config;
+        config.sendThreshold = 4;
+        config.sendDelay = std::chrono::milliseconds(10);
+        return config;
+    }
+};
+
+class SerialServerWatermarkTest
+    : public SerialServerTest
+{
+public:
+    SerialServerWatermarkTest()
+        : SerialServerTest(WatermarkConfig())
+    {}
+
+    static services::SerialServer::Config WatermarkConfig()
+    {
+        services::SerialServer::Config config;
+        config.sendBufferHighWatermark = 64;
+        config.sendBufferLowWatermark = 16;
+        return config;
+    }
 };
 
 TEST_F(SerialServerTest, forward_data_from_serial_to_socket)
@@ -54,3 +90,92 @@ TEST_F(SerialServerTest, forward_data_from_socket_to_serial)
     EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>{ 'C', 'B', 'A' }));
     connection->SimulateDataReceived(std::vector<uint8_t>{ 'C', 'B', 'A' });
 }
+
+TEST_F(SerialServerTest, data_from_socket_is_acknowledged_before_serial_send_completes)
+{
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>{ 'A', 'B' }));
+    connection->SimulateDataReceived(std::vector<uint8_t>{ 'A', 'B' });
+    connection->SimulateDataReceived(std::vector<uint8_t>{ 'C', 'D' });
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>{ 'C', 'D' }));
+    serialCommunicationMock.actionOnCompletion();
+
+    serialCommunicationMock.actionOnCompletion();
+    EXPECT_EQ(4, serialServer.GetStatistics().bytesToSerial);
+}
+
+TEST_F(SerialServerTest, data_from_socket_that_does_not_fit_is_received_after_serial_send_completes)
+{
+    std::vector<uint8_t> data(200, 'A');
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(128, 'A')));
+    connection->SimulateDataReceived(data);
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(72, 'A')));
+    serialCommunicationMock.actionOnCompletion();
+
+    serialCommunicationMock.actionOnCompletion();
+    EXPECT_EQ(200, serialServer.GetStatistics().bytesToSerial);
+}
+
+TEST_F(SerialServerTest, serial_data_that_does_not_fit_is_counted_as_overrun)
+{
+    serialCommunicationMock.dataReceived(std::vector<uint8_t>(200, 'A'));
+    ExecuteAllActions();
+
+    EXPECT_EQ(std::string(127, 'A'), connection->SentDataAsString());
+    EXPECT_EQ(127, serialServer.GetStatistics().bytesToConnection);
+    EXPECT_EQ(73, serialServer.GetStatistics().serialOverruns);
+}
+
+TEST_F(SerialServerCoalescingTest, serial_data_is_sent_when_threshold_is_reached)
+{
+    serialCommunicationMock.dataReceived(std::vector<uint8_t>{ 'A', 'B' });
+    ExecuteAllActions();
+    EXPECT_EQ("", connection->SentDataAsString());
+
+    serialCommunicationMock.dataReceived(std::vector<uint8_t>{ 'C', 'D' });
+    ExecuteAllActions();
+    EXPECT_EQ("ABCD", connection->SentDataAsString());
+}
+
+TEST_F(SerialServerCoalescingTest, serial_data_is_sent_after_delay)
+{
+    serialCommunicationMock.dataReceived(std::vector<uint8_t>{ 'A', 'B' });
+    ForwardTime(std::chrono::milliseconds(9));
+    EXPECT_EQ("", connection->SentDataAsString());
+
+    ForwardTime(std::chrono::milliseconds(1));
+    EXPECT_EQ("AB", connection->SentDataAsString());
+}
+
+TEST_F(SerialServerWatermarkTest, data_from_socket_is_taken_up_to_high_watermark)
+{
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(64, 'A')));
+    connection->SimulateDataReceived(std::vector<uint8_t>(100, 'A'));
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(36, 'A')));
+    serialCommunicationMock.actionOnCompletion();
+
+    serialCommunicationMock.actionOnCompletion();
+    EXPECT_EQ(100, serialServer.GetStatistics().bytesToSerial);
+}
+
+TEST_F(SerialServerWatermarkTest, data_from_socket_is_taken_again_below_low_watermark)
+{
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(40, 'A')));
+    connection->SimulateDataReceived(std::vector<uint8_t>(40, 'A'));
+    connection->SimulateDataReceived(std::vector<uint8_t>(100, 'B'));
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(24, 'B')));
+    serialCommunicationMock.actionOnCompletion();
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(64, 'B')));
+    serialCommunicationMock.actionOnCompletion();
+
+    EXPECT_CALL(serialCommunicationMock, SendDataMock(std::vector<uint8_t>(12, 'B')));
+    serialCommunicationMock.actionOnCompletion();
+
+    serialCommunicationMock.actionOnCompletion();
+    EXPECT_EQ(140, serialServer.GetStatistics().bytesToSerial);
+}
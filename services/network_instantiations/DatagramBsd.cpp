@@ -1,6 +1,6 @@
 #include "services/network_instantiations/DatagramBsd.hpp"
-#include "infra/stream/StdVectorInputStream.hpp"
 #include "services/network_instantiations/EventDispatcherWithNetworkBsd.hpp"
+#include <cstring>
 #include <errno.h>
 #include <fcntl.h>
 #include <sys/socket.h>
@@ -8,62 +8,62 @@
 
 namespace services
 {
-    DatagramBsd::DatagramBsd(uint16_t port, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(uint16_t port, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(Udpv4Socket{ IPv4Address{}, port });
     }
 
-    DatagramBsd::DatagramBsd(DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(Udpv4Socket{ IPv4Address{}, 0 });
     }
 
-    DatagramBsd::DatagramBsd(const UdpSocket& remote, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(Udpv4Socket{ IPv4Address{}, 0 });
         BindRemote(remote);
     }
 
-    DatagramBsd::DatagramBsd(uint16_t localPort, const UdpSocket& remote, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(uint16_t localPort, const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(Udpv4Socket{ IPv4Address{}, localPort });
         BindRemote(remote);
     }
 
-    DatagramBsd::DatagramBsd(IPAddress localAddress, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(IPAddress localAddress, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(MakeUdpSocket(localAddress, 0));
     }
 
-    DatagramBsd::DatagramBsd(IPAddress localAddress, uint16_t localPort, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(IPAddress localAddress, uint16_t localPort, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(MakeUdpSocket(localAddress, localPort));
     }
 
-    DatagramBsd::DatagramBsd(IPAddress localAddress, const UdpSocket& remote, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(IPAddress localAddress, const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(MakeUdpSocket(localAddress, 0));
         BindRemote(remote);
     }
 
-    DatagramBsd::DatagramBsd(const UdpSocket& local, const UdpSocket& remote, DatagramExchangeObserver& observer)
+    DatagramBsd::DatagramBsd(const UdpSocket& local, const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config)
     {
         observer.Attach(*this);
-        InitSocket();
+        InitSocket(config);
         BindLocal(local);
         BindRemote(remote);
     }
@@ -93,28 +93,19 @@ namespace services
 
     void DatagramBsd::Receive()
     {
-        infra::BoundedVector<uint8_t>::WithMaxSize<508> receiveBuffer;
-        receiveBuffer.resize(receiveBuffer.max_size());
+        auto received = ReceiveBatch(PrepareReceive());
 
-        sockaddr_in fromAddress{};
-        socklen_t fromAddressSize = sizeof(fromAddress);
-
-        auto received = recvfrom(socket, reinterpret_cast<char*>(receiveBuffer.data()), receiveBuffer.size(), 0, reinterpret_cast<sockaddr*>(&fromAddress), &fromAddressSize);
-        if (received == -1)
+        for (std::size_t index = 0; index != received; ++index)
         {
-            if (errno != EWOULDBLOCK && errno != EMSGSIZE)
-                std::abort();
-            return;
-        }
-        else if (fromAddressSize == sizeof(fromAddress) && fromAddress.sin_family == AF_INET)
-        {
-            receiveBuffer.resize(received);
-            auto reader = infra::MakeSharedOnHeap<infra::StdVectorInputStreamReader::WithStorage>();
-            reader->Storage() = std::vector<uint8_t>(receiveBuffer.begin(), receiveBuffer.end());
-
-            auto from = Udpv4Socket{ services::ConvertFromUint32(htonl(fromAddress.sin_addr.s_addr)), htons(fromAddress.sin_port) };
-
-            GetObserver().DataReceived(std::move(reader), from);
+#ifdef __linux__
+            const auto& header = receiveHeaders[index].msg_hdr;
+            std::size_t size = receiveHeaders[index].msg_len;
+#else
+            const auto& header = receiveHeaders[index];
+            std::size_t size = receivingSlots[index]->data.iov_len;
+#endif
+
+            Deliver(*receivingSlots[index], header, size);
         }
     }
 
@@ -171,7 +162,12 @@ namespace services
         setsockopt(socket, IPPROTO_IP, IP_DROP_MEMBERSHIP, reinterpret_cast<char*>(&multicastRequest), sizeof(multicastRequest));
     }
 
-    void DatagramBsd::InitSocket()
+    DatagramBsd::Statistics DatagramBsd::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void DatagramBsd::InitSocket(const Config& config)
     {
         assert(socket != -1);
 
@@ -179,6 +175,20 @@ namespace services
         if (setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag)) == -1)
             std::abort();
 
+        if (config.receiveBufferSize != 0 && setsockopt(socket, SOL_SOCKET, SO_RCVBUF, &config.receiveBufferSize, sizeof(config.receiveBufferSize)) == -1)
+            std::abort();
+
+#ifdef SO_RXQ_OVFL
+        if (setsockopt(socket, SOL_SOCKET, SO_RXQ_OVFL, &flag, sizeof(flag)) == -1)
+            std::abort();
+#endif
+
+        assert(config.receiveBatchSize != 0);
+        for (std::size_t index = 0; index != config.receiveBatchSize; ++index)
+            receiveSlots.emplace_back(config.maxDatagramSize);
+        receivingSlots.reserve(config.receiveBatchSize);
+        receiveHeaders.resize(config.receiveBatchSize);
+
         if (fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK) == -1)
             std::abort();
     }
@@ -222,6 +232,100 @@ namespace services
         }
     }
 
+    std::size_t DatagramBsd::PrepareReceive()
+    {
+        // Slots of which the reader is still held by an observer are skipped; when all are held, nothing is received
+        receivingSlots.clear();
+
+        for (std::size_t index = 0; index != receiveSlots.size(); ++index)
+        {
+            auto& slot = receiveSlots[(nextReceiveSlot + index) % receiveSlots.size()];
+            if (!slot.reader.Allocatable())
+                continue;
+
+#ifdef __linux__
+            auto& header = receiveHeaders[receivingSlots.size()].msg_hdr;
+#else
+            auto& header = receiveHeaders[receivingSlots.size()];
+#endif
+            slot.data = iovec{ slot.buffer.data(), slot.buffer.size() };
+            header = msghdr{};
+            header.msg_name = &slot.from;
+            header.msg_namelen = sizeof(slot.from);
+            header.msg_iov = &slot.data;
+            header.msg_iovlen = 1;
+            header.msg_control = slot.control.data();
+            header.msg_controllen = slot.control.size();
+
+            receivingSlots.push_back(&slot);
+        }
+
+        nextReceiveSlot = (nextReceiveSlot + receivingSlots.size()) % receiveSlots.size();
+        return receivingSlots.size();
+    }
+
+    std::size_t DatagramBsd::ReceiveBatch(std::size_t count)
+    {
+        if (count == 0)
+            return 0;
+
+#ifdef __linux__
+        auto received = recvmmsg(socket, receiveHeaders.data(), count, MSG_DONTWAIT, nullptr);
+        if (received == -1)
+        {
+            if (errno != EWOULDBLOCK)
+                std::abort();
+            return 0;
+        }
+
+        return received;
+#else
+        std::size_t received = 0;
+
+        for (; received != count; ++received)
+        {
+            auto size = recvmsg(socket, &receiveHeaders[received], MSG_DONTWAIT);
+            if (size == -1)
+            {
+                if (errno != EWOULDBLOCK)
+                    std::abort();
+                break;
+            }
+
+            receivingSlots[received]->data.iov_len = size;
+        }
+
+        return received;
+#endif
+    }
+
+    void DatagramBsd::Deliver(ReceiveSlot& slot, const msghdr& header, std::size_t size)
+    {
+#ifdef SO_RXQ_OVFL
+        // The socket reports the total number of datagrams that it dropped so far
+        for (auto message = CMSG_FIRSTHDR(&header); message != nullptr; message = CMSG_NXTHDR(const_cast<msghdr*>(&header), message))
+            if (message->cmsg_level == SOL_SOCKET && message->cmsg_type == SO_RXQ_OVFL)
+                std::memcpy(&statistics.droppedBySocket, CMSG_DATA(message), sizeof(statistics.droppedBySocket));
+#endif
+
+        if ((header.msg_flags & MSG_TRUNC) != 0)
+        {
+            ++statistics.droppedTooLarge;
+            return;
+        }
+
+        if (header.msg_namelen == sizeof(slot.from) && slot.from.sin_family == AF_INET && HasObserver())
+        {
+            auto from = Udpv4Socket{ services::ConvertFromUint32(htonl(slot.from.sin_addr.s_addr)), htons(slot.from.sin_port) };
+
+            GetObserver().DataReceived(slot.reader.Emplace(infra::ConstByteRange(slot.buffer.data(), slot.buffer.data() + size)), from);
+        }
+    }
+
+    DatagramBsd::ReceiveSlot::ReceiveSlot(std::size_t size)
+        : buffer(size)
+    {}
+
     DatagramBsd::StreamWriterBsd::StreamWriterBsd(DatagramBsd& connection)
         : infra::ByteOutputStreamWriter(infra::MakeRange(*connection.sendBuffer))
         , connection(connection)
@@ -2,15 +2,19 @@
 #define SERVICES_DATAGRAM_BSD_HPP
 
 #include "infra/event/EventDispatcherWithWeakPtr.hpp"
+#include "infra/stream/ByteInputStream.hpp"
 #include "infra/stream/ByteOutputStream.hpp"
 #include "infra/util/BoundedVector.hpp"
 #include "infra/util/IntrusiveList.hpp"
 #include "infra/util/SharedObjectAllocator.hpp"
 #include "infra/util/SharedOptional.hpp"
 #include "services/network/Datagram.hpp"
+#include <array>
+#include <deque>
 #include <list>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <vector>
 
 namespace services
 {
@@ -19,14 +23,34 @@ namespace services
         , public infra::EnableSharedFromThis<DatagramBsd>
     {
     public:
-        DatagramBsd(uint16_t port, DatagramExchangeObserver& observer);
-        explicit DatagramBsd(DatagramExchangeObserver& observer);
-        DatagramBsd(const UdpSocket& remote, DatagramExchangeObserver& observer);
-        DatagramBsd(uint16_t localPort, const UdpSocket& remote, DatagramExchangeObserver& observer);
-        DatagramBsd(IPAddress localAddress, DatagramExchangeObserver& observer);
-        DatagramBsd(IPAddress localAddress, uint16_t localPort, DatagramExchangeObserver& observer);
-        DatagramBsd(IPAddress localAddress, const UdpSocket& remote, DatagramExchangeObserver& observer);
-        DatagramBsd(const UdpSocket& local, const UdpSocket& remote, DatagramExchangeObserver& observer);
+        struct Config
+        {
+            Config() {}
+
+            // Received datagrams are read into a ring of this many buffers with a single system call where the
+            // platform supports it, and are all delivered in one dispatcher iteration
+            std::size_t receiveBatchSize = 16;
+            std::size_t maxDatagramSize = 1472;
+            // Size of the socket's receive buffer (SO_RCVBUF); 0 keeps the system default
+            int receiveBufferSize = 0;
+        };
+
+        struct Statistics
+        {
+            // Datagrams dropped by the socket because its receive buffer was full; only counted on Linux
+            uint32_t droppedBySocket = 0;
+            // Datagrams dropped because they are larger than maxDatagramSize
+            uint32_t droppedTooLarge = 0;
+        };
+
+        DatagramBsd(uint16_t port, DatagramExchangeObserver& observer, const Config& config = Config());
+        explicit DatagramBsd(DatagramExchangeObserver& observer, const Config& config = Config());
+        DatagramBsd(const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config = Config());
+        DatagramBsd(uint16_t localPort, const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config = Config());
+        DatagramBsd(IPAddress localAddress, DatagramExchangeObserver& observer, const Config& config = Config());
+        DatagramBsd(IPAddress localAddress, uint16_t localPort, DatagramExchangeObserver& observer, const Config& config = Config());
+        DatagramBsd(IPAddress localAddress, const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config = Config());
+        DatagramBsd(const UdpSocket& local, const UdpSocket& remote, DatagramExchangeObserver& observer, const Config& config = Config());
         ~DatagramBsd();
 
         void RequestSendStream(std::size_t sendSize) override;
@@ -39,11 +63,28 @@ namespace services
         void JoinMulticastGroup(IPv4Address multicastAddress);
         void LeaveMulticastGroup(IPv4Address multicastAddress);
 
+        Statistics GetStatistics() const;
+
     private:
-        void InitSocket();
+        struct ReceiveSlot
+        {
+            explicit ReceiveSlot(std::size_t size);
+
+            std::vector<uint8_t> buffer;
+            sockaddr_in from{};
+            iovec data{};
+            alignas(cmsghdr) std::array<uint8_t, CMSG_SPACE(sizeof(uint32_t))> control{};
+            infra::SharedOptional<infra::ByteInputStreamReader> reader;
+        };
+
+    private:
+        void InitSocket(const Config& config);
         void BindLocal(const UdpSocket& local);
         void BindRemote(const UdpSocket& remote);
         void TryAllocateSendStream();
+        std::size_t PrepareReceive();
+        std::size_t ReceiveBatch(std::size_t count);
+        void Deliver(ReceiveSlot& slot, const msghdr& header, std::size_t size);
 
     private:
         class StreamWriterBsd
@@ -71,6 +112,16 @@ namespace services
         UdpSocket requestedTo;
         bool trySend = false;
         infra::SharedPtr<DatagramBsd> self;
+
+        std::deque<ReceiveSlot> receiveSlots;
+        std::size_t nextReceiveSlot = 0;
+        std::vector<ReceiveSlot*> receivingSlots;
+#ifdef __linux__
+        std::vector<mmsghdr> receiveHeaders;
+#else
+        std::vector<msghdr> receiveHeaders;
+#endif
+        Statistics statistics;
     };
 
     using AllocatorDatagramBsd = infra::SharedObjectAllocator<DatagramBsd, void(int)>;
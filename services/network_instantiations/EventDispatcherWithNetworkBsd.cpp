@@ -17,7 +17,8 @@ namespace
 
 namespace services
 {
-    EventDispatcherWithNetwork::EventDispatcherWithNetwork()
+    EventDispatcherWithNetwork::EventDispatcherWithNetwork(const DatagramBsd::Config& datagramConfig)
+        : datagramConfig(datagramConfig)
     {
         if (pipe(wakeUpEvent) == -1)
             std::abort();
@@ -69,6 +70,23 @@ namespace services
         return !connectors.empty() || !connections.empty();
     }
 
+    DatagramBsd::Statistics EventDispatcherWithNetwork::DatagramStatistics() const
+    {
+        DatagramBsd::Statistics result;
+
+        for (auto& weakDatagram : datagrams)
+        {
+            if (infra::SharedPtr<DatagramBsd> datagram = weakDatagram)
+            {
+                auto statistics = datagram->GetStatistics();
+                result.droppedBySocket += statistics.droppedBySocket;
+                result.droppedTooLarge += statistics.droppedTooLarge;
+            }
+        }
+
+        return result;
+    }
+
     infra::SharedPtr<void> EventDispatcherWithNetwork::Listen(uint16_t port, services::ServerConnectionObserverFactory& factory, IPVersions versions)
     {
         assert(versions != IPVersions::ipv6);
@@ -96,7 +114,7 @@ namespace services
     infra::SharedPtr<DatagramExchange> EventDispatcherWithNetwork::Listen(DatagramExchangeObserver& observer, uint16_t port, IPVersions versions)
     {
         assert(versions != IPVersions::ipv6);
-        auto result = infra::MakeSharedOnHeap<DatagramBsd>(port, observer);
+        auto result = infra::MakeSharedOnHeap<DatagramBsd>(port, observer, datagramConfig);
         RegisterDatagram(result);
         return result;
     }
@@ -104,21 +122,21 @@ namespace services
     infra::SharedPtr<DatagramExchange> EventDispatcherWithNetwork::Listen(DatagramExchangeObserver& observer, IPVersions versions)
     {
         assert(versions != IPVersions::ipv6);
-        auto result = infra::MakeSharedOnHeap<DatagramBsd>(observer);
+        auto result = infra::MakeSharedOnHeap<DatagramBsd>(observer, datagramConfig);
         RegisterDatagram(result);
         return result;
     }
 
     infra::SharedPtr<DatagramExchange> EventDispatcherWithNetwork::Connect(DatagramExchangeObserver& observer, UdpSocket remote)
     {
-        auto result = infra::MakeSharedOnHeap<DatagramBsd>(remote, observer);
+        auto result = infra::MakeSharedOnHeap<DatagramBsd>(remote, observer, datagramConfig);
         RegisterDatagram(result);
         return result;
     }
 
     infra::SharedPtr<DatagramExchange> EventDispatcherWithNetwork::Connect(DatagramExchangeObserver& observer, uint16_t localPort, UdpSocket remote)
     {
-        auto result = infra::MakeSharedOnHeap<DatagramBsd>(localPort, remote, observer);
+        auto result = infra::MakeSharedOnHeap<DatagramBsd>(localPort, remote, observer, datagramConfig);
         RegisterDatagram(result);
         return result;
     }
@@ -15,7 +15,7 @@ namespace services
         , public Multicast
     {
     public:
-        EventDispatcherWithNetwork();
+        explicit EventDispatcherWithNetwork(const DatagramBsd::Config& datagramConfig = DatagramBsd::Config());
         ~EventDispatcherWithNetwork() override;
 
         void RegisterConnection(const infra::SharedPtr<ConnectionBsd>& connection);
@@ -25,6 +25,8 @@ namespace services
         void RegisterDatagram(const infra::SharedPtr<DatagramBsd>& datagram);
 
         bool ConnectionsOpen() const;
+        // Summed over the datagram exchanges that are currently open
+        DatagramBsd::Statistics DatagramStatistics() const;
 
     public:
         // Implementation of ConnectionFactory
@@ -56,6 +58,7 @@ namespace services
         infra::IntrusiveList<ListenerBsd> listeners;
         std::list<ConnectorBsd> connectors;
         std::list<infra::WeakPtr<DatagramBsd>> datagrams;
+        DatagramBsd::Config datagramConfig;
         int numberOfFileDescriptors = 0;
         int wakeUpEvent[2]{ 0 };
         fd_set readFileDescriptors;
@@ -0,0 +1,221 @@
+#include "services/tracer/BinaryTraceDecoder.hpp"
+#include "infra/stream/ByteInputStream.hpp"
+#include "infra/stream/StreamManipulators.hpp"
+#include "services/tracer/TracerWithTime.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+namespace services
+{
+    BinaryTraceDecoder::BinaryTraceDecoder(infra::ConstByteRange formats, infra::TextOutputStream& output)
+        : formats(formats)
+        , output(output)
+    {}
+
+    void BinaryTraceDecoder::Decode(infra::ConstByteRange& data)
+    {
+        while (!data.empty())
+        {
+            infra::ByteInputStream stream(data, infra::softFail);
+
+            auto decoded = DecodeRecord(stream);
+
+            if (!decoded || stream.Failed())
+                break;
+
+            data = stream.Reader().Remaining();
+        }
+    }
+
+    bool BinaryTraceDecoder::DecodeRecord(infra::DataInputStream& stream)
+    {
+        auto kind = stream.Extract<uint8_t>();
+
+        std::string format;
+        if (kind == BinaryTracer::recordInterned)
+            format = Format(stream.Extract<infra::LittleEndian<uint32_t>>());
+        else if (kind == BinaryTracer::recordInline)
+            format = ExtractString(stream);
+        else
+        {
+            // Not the start of a record, so skip this byte to find the next record
+            output << "\r\n<invalid record " << infra::hex << infra::Width(2, '0') << kind << infra::resetWidth << ">";
+            return true;
+        }
+
+        uint64_t microseconds = stream.Extract<infra::LittleEndian<uint64_t>>();
+        auto count = stream.Extract<uint8_t>();
+
+        std::vector<Argument> arguments;
+        for (uint8_t i = 0; i != count && !stream.Failed(); ++i)
+        {
+            arguments.push_back(ExtractArgument(stream));
+
+            if (!stream.Failed() && (arguments.back().type < BinaryTracer::ArgumentType::signed32 || arguments.back().type > BinaryTracer::ArgumentType::string))
+            {
+                // The size of an unknown argument is unknown, so the remainder of the record cannot be decoded
+                output << "\r\n<invalid argument>";
+                return true;
+            }
+        }
+
+        if (stream.Failed())
+            return false;
+
+        InsertHeader(microseconds);
+        Print(format, arguments);
+        return true;
+    }
+
+    std::string BinaryTraceDecoder::ExtractString(infra::DataInputStream& stream) const
+    {
+        std::string result(stream.Extract<uint8_t>(), 0);
+        stream >> infra::ByteRange(reinterpret_cast<uint8_t*>(&result[0]), reinterpret_cast<uint8_t*>(&result[0]) + result.size());
+        return result;
+    }
+
+    BinaryTraceDecoder::Argument BinaryTraceDecoder::ExtractArgument(infra::DataInputStream& stream) const
+    {
+        Argument argument{ stream.Extract<BinaryTracer::ArgumentType>(), 0, {} };
+
+        switch (argument.type)
+        {
+            case BinaryTracer::ArgumentType::signed32:
+                argument.value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(stream.Extract<infra::LittleEndian<int32_t>>())));
+                break;
+            case BinaryTracer::ArgumentType::unsigned32:
+                argument.value = stream.Extract<infra::LittleEndian<uint32_t>>();
+                break;
+            case BinaryTracer::ArgumentType::signed64:
+            case BinaryTracer::ArgumentType::unsigned64:
+                argument.value = stream.Extract<infra::LittleEndian<uint64_t>>();
+                break;
+            case BinaryTracer::ArgumentType::character:
+                argument.value = stream.Extract<uint8_t>();
+                break;
+            case BinaryTracer::ArgumentType::string:
+                argument.text = ExtractString(stream);
+                break;
+            default:
+                break;
+        }
+
+        return argument;
+    }
+
+    std::string BinaryTraceDecoder::Format(uint32_t offset) const
+    {
+        if (offset >= formats.size())
+            return "<unknown format>";
+
+        auto format = infra::DiscardHead(formats, offset);
+        return std::string(format.begin(), std::find(format.begin(), format.end(), 0));
+    }
+
+    void BinaryTraceDecoder::InsertHeader(uint64_t microseconds)
+    {
+        output << "\r\n";
+        InsertTimeHeader(output, microseconds);
+    }
+
+    void BinaryTraceDecoder::Print(const std::string& format, const std::vector<Argument>& arguments)
+    {
+        auto argument = arguments.begin();
+
+        for (auto position = format.begin(); position != format.end(); ++position)
+        {
+            if (*position != '%')
+            {
+                output << *position;
+                continue;
+            }
+
+            if (++position == format.end())
+                break;
+
+            // Flags, width and precision are collected as written, so that they can be applied with snprintf
+            std::string specification = "%";
+            while (position != format.end() && std::strchr("-+ #0", *position) != nullptr)
+                specification += *position++;
+
+            while (position != format.end() && std::isdigit(static_cast<unsigned char>(*position)))
+                specification += *position++;
+
+            if (position != format.end() && *position == '.')
+                do
+                    specification += *position++;
+                while (position != format.end() && std::isdigit(static_cast<unsigned char>(*position)));
+
+            while (position != format.end() && std::strchr("hljztL", *position) != nullptr)
+                ++position;
+
+            if (position == format.end())
+                break;
+
+            if (*position == '%')
+                output << '%';
+            else if (argument == arguments.end())
+                output << "<missing>";
+            else
+                PrintArgument(*position, specification, *argument++);
+        }
+    }
+
+    void BinaryTraceDecoder::PrintArgument(char conversion, const std::string& specification, const Argument& argument)
+    {
+        if (argument.type == BinaryTracer::ArgumentType::string)
+        {
+            PrintFormatted(specification + 's', argument.text.c_str());
+            return;
+        }
+
+        switch (conversion)
+        {
+            case 'c':
+                PrintFormatted(specification + 'c', static_cast<int>(static_cast<char>(argument.value)));
+                break;
+            case 'd':
+            case 'i':
+                if (IsSigned(argument))
+                    PrintFormatted(specification + "lld", static_cast<long long>(argument.value));
+                else
+                    PrintFormatted(specification + "llu", static_cast<unsigned long long>(argument.value));
+                break;
+            case 'p':
+                output << "0x";
+                PrintFormatted(specification + "llx", static_cast<unsigned long long>(AsUnsigned(argument)));
+                break;
+            case 'o':
+            case 'x':
+            case 'X':
+                PrintFormatted(specification + "ll" + conversion, static_cast<unsigned long long>(AsUnsigned(argument)));
+                break;
+            default:
+                PrintFormatted(specification + "llu", static_cast<unsigned long long>(AsUnsigned(argument)));
+                break;
+        }
+    }
+
+    template<class T>
+    void BinaryTraceDecoder::PrintFormatted(const std::string& specification, T value)
+    {
+        std::string result(std::max(std::snprintf(nullptr, 0, specification.c_str(), value), 0), '\0');
+        std::snprintf(&result[0], result.size() + 1, specification.c_str(), value);
+        output << result;
+    }
+
+    bool BinaryTraceDecoder::IsSigned(const Argument& argument) const
+    {
+        return argument.type == BinaryTracer::ArgumentType::signed32 || argument.type == BinaryTracer::ArgumentType::signed64;
+    }
+
+    uint64_t BinaryTraceDecoder::AsUnsigned(const Argument& argument) const
+    {
+        if (argument.type == BinaryTracer::ArgumentType::signed32)
+            return static_cast<uint32_t>(argument.value);
+        else
+            return argument.value;
+    }
+}
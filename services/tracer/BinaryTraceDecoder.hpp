@@ -0,0 +1,49 @@
+#ifndef SERVICES_BINARY_TRACE_DECODER_HPP
+#define SERVICES_BINARY_TRACE_DECODER_HPP
+
+#include "infra/stream/InputStream.hpp"
+#include "infra/stream/OutputStream.hpp"
+#include "services/tracer/BinaryTracer.hpp"
+#include <string>
+#include <vector>
+
+namespace services
+{
+    // BinaryTraceDecoder reconstructs the text of records emitted by BinaryTracer, in the same layout as TracerWithTime
+    class BinaryTraceDecoder
+    {
+    public:
+        // formats holds the contents of the emil_trace_formats section of the firmware which emitted the records
+        BinaryTraceDecoder(infra::ConstByteRange formats, infra::TextOutputStream& output);
+
+        // Decodes all complete records at the start of data, and removes them from data
+        void Decode(infra::ConstByteRange& data);
+
+    private:
+        struct Argument
+        {
+            BinaryTracer::ArgumentType type;
+            uint64_t value;
+            std::string text;
+        };
+
+        bool DecodeRecord(infra::DataInputStream& stream);
+        std::string ExtractString(infra::DataInputStream& stream) const;
+        Argument ExtractArgument(infra::DataInputStream& stream) const;
+        std::string Format(uint32_t offset) const;
+
+        void InsertHeader(uint64_t microseconds);
+        void Print(const std::string& format, const std::vector<Argument>& arguments);
+        void PrintArgument(char conversion, const std::string& specification, const Argument& argument);
+        template<class T>
+        void PrintFormatted(const std::string& specification, T value);
+        bool IsSigned(const Argument& argument) const;
+        uint64_t AsUnsigned(const Argument& argument) const;
+
+    private:
+        infra::ConstByteRange formats;
+        infra::TextOutputStream& output;
+    };
+}
+
+#endif
@@ -0,0 +1,24 @@
+#include "services/tracer/BinaryTracer.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace services
+{
+    BinaryTracer::BinaryTracer(infra::DataOutputStream& stream)
+        : stream(stream)
+    {}
+
+    void BinaryTracer::InsertTimeAndArgumentCount(uint8_t count)
+    {
+        stream << infra::LittleEndian<uint64_t>(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(infra::Now().time_since_epoch()).count())) << count;
+    }
+
+    void BinaryTracer::InsertString(const char* string)
+    {
+        if (string == nullptr)
+            string = "(null)";
+
+        auto size = static_cast<uint8_t>(std::min<std::size_t>(std::strlen(string), 255));
+        stream << size << infra::MakeRange(reinterpret_cast<const uint8_t*>(string), reinterpret_cast<const uint8_t*>(string) + size);
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef SERVICES_BINARY_TRACER_HPP
+#define SERVICES_BINARY_TRACER_HPP
+
+#include "infra/stream/OutputStream.hpp"
+#include "infra/timer/Timer.hpp"
+#include "infra/util/Endian.hpp"
+#include <cstring>
+#include <type_traits>
+
+// BinaryTracer emits trace records instead of text. Formatting is deferred to the host, where
+// services.binary_trace_decoder reconstructs the text from the records and from the firmware ELF file.
+//
+// Use EMIL_TRACE_BINARY(tracer, "printf style format %d", arguments...) to trace. With GCC or Clang on ELF targets,
+// the format string is placed in the emil_trace_formats section, and a record only holds the offset of the
+// format string in that section. On other toolchains, the format string is included in the record.
+//
+// A record consists of (multi-byte values are little endian, independent of the byte order of the target):
+//   uint8_t  kind: recordInterned or recordInline
+//   uint32_t offset of the format string in the emil_trace_formats section (recordInterned), or
+//   uint8_t  size, followed by the characters of the format string (recordInline)
+//   uint64_t microseconds since the epoch of the system time
+//   uint8_t  number of arguments, each followed by a uint8_t ArgumentType and its value:
+//            4 bytes for (un)signed32, 8 bytes for (un)signed64, 1 byte for character, and
+//            a uint8_t size followed by the characters for string
+
+#if defined(__GNUC__) && defined(__ELF__)
+#define EMIL_TRACE_BINARY(tracer, format, ...)                                                                      \
+    do                                                                                                              \
+    {                                                                                                               \
+        __attribute__((section("emil_trace_formats"), used)) static const char emilTraceFormat[] = format;          \
+        (tracer).TraceInterned(emilTraceFormat, ##__VA_ARGS__);                                                     \
+    } while (false)
+
+extern "C" const char __start_emil_trace_formats[]; //NOSONAR
+#else
+#define EMIL_TRACE_BINARY(tracer, format, ...) (tracer).TraceInline(format, ##__VA_ARGS__)
+#endif
+
+namespace services
+{
+    class BinaryTracer
+    {
+    public:
+        static constexpr uint8_t recordInterned = 1;
+        static constexpr uint8_t recordInline = 2;
+
+        enum class ArgumentType : uint8_t
+        {
+            signed32 = 1,
+            unsigned32,
+            signed64,
+            unsigned64,
+            character,
+            string
+        };
+
+        explicit BinaryTracer(infra::DataOutputStream& stream);
+        BinaryTracer(const BinaryTracer& other) = delete;
+        BinaryTracer& operator=(const BinaryTracer& other) = delete;
+        ~BinaryTracer() = default;
+
+        template<class... Args>
+        void TraceInterned(const char* format, const Args&... args);
+        template<class... Args>
+        void TraceInline(const char* format, const Args&... args);
+
+    private:
+        void InsertTimeAndArgumentCount(uint8_t count);
+        void InsertString(const char* string);
+
+        template<class T>
+        void InsertArgument(const T& argument);
+
+    private:
+        infra::DataOutputStream& stream;
+    };
+
+    ////    Implementation    ////
+
+#if defined(EMIL_DISABLE_TRACING)
+    template<class... Args>
+    void BinaryTracer::TraceInterned(const char* format, const Args&... args)
+    {}
+
+    template<class... Args>
+    void BinaryTracer::TraceInline(const char* format, const Args&... args)
+    {}
+#else
+#if defined(__GNUC__) && defined(__ELF__)
+    template<class... Args>
+    void BinaryTracer::TraceInterned(const char* format, const Args&... args)
+    {
+        stream << recordInterned << infra::LittleEndian<uint32_t>(static_cast<uint32_t>(format - __start_emil_trace_formats));
+        InsertTimeAndArgumentCount(static_cast<uint8_t>(sizeof...(args)));
+        (InsertArgument(args), ...);
+    }
+#endif
+
+    template<class... Args>
+    void BinaryTracer::TraceInline(const char* format, const Args&... args)
+    {
+        stream << recordInline;
+        InsertString(format);
+        InsertTimeAndArgumentCount(static_cast<uint8_t>(sizeof...(args)));
+        (InsertArgument(args), ...);
+    }
+#endif
+
+    template<class T>
+    void BinaryTracer::InsertArgument(const T& argument)
+    {
+        if constexpr (std::is_enum<T>::value)
+            InsertArgument(static_cast<std::underlying_type_t<T>>(argument));
+        else if constexpr (std::is_same<T, char>::value)
+            stream << ArgumentType::character << argument;
+        else if constexpr (std::is_same<T, bool>::value)
+            stream << ArgumentType::unsigned32 << infra::LittleEndian<uint32_t>(static_cast<uint32_t>(argument));
+        else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) <= sizeof(int32_t))
+            stream << ArgumentType::signed32 << infra::LittleEndian<int32_t>(static_cast<int32_t>(argument));
+        else if constexpr (std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) <= sizeof(uint32_t))
+            stream << ArgumentType::unsigned32 << infra::LittleEndian<uint32_t>(static_cast<uint32_t>(argument));
+        else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value)
+            stream << ArgumentType::signed64 << infra::LittleEndian<int64_t>(static_cast<int64_t>(argument));
+        else if constexpr (std::is_integral<T>::value)
+            stream << ArgumentType::unsigned64 << infra::LittleEndian<uint64_t>(static_cast<uint64_t>(argument));
+        else if constexpr (std::is_convertible<T, const char*>::value)
+        {
+            stream << ArgumentType::string;
+            InsertString(argument);
+        }
+        else if constexpr (std::is_pointer<T>::value)
+            stream << ArgumentType::unsigned64 << infra::LittleEndian<uint64_t>(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(argument)));
+        else
+            static_assert(std::is_integral<T>::value, "Unsupported binary trace argument");
+    }
+}
+
+#endif
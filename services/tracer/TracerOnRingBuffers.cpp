@@ -0,0 +1,263 @@
+#include "services/tracer/TracerOnRingBuffers.hpp"
+#include "infra/stream/ByteOutputStream.hpp"
+#include "infra/stream/InputStream.hpp"
+#include "infra/stream/StreamManipulators.hpp"
+#include "services/tracer/TracerWithTime.hpp"
+#include <limits>
+
+namespace services
+{
+    namespace
+    {
+        // A chunk holds the bytes of one Insert, preceded by its kind, the start time of
+        // the trace for the first chunk of a trace, and the number of bytes
+        constexpr uint8_t chunkStart = 1;
+        constexpr uint8_t chunkContinuation = 2;
+
+        std::atomic<uint32_t> nextInstance{ 1 };
+        std::atomic<uint32_t> nextThread{ 1 };
+
+        // The lane of the instance last traced to is cached; a thread alternating between
+        // instances finds its lane in another instance by its thread number
+        thread_local const uint32_t currentThread = nextThread.fetch_add(1, std::memory_order_relaxed);
+        thread_local uint32_t currentInstance = 0;
+        thread_local TracerOnRingBuffers::Lane* currentLane = nullptr;
+    }
+
+    TracerOnRingBuffers::Lane::Lane(infra::ByteRange storage)
+        : queue(storage)
+    {}
+
+    void TracerOnRingBuffers::Lane::Insert(infra::ConstByteRange range, infra::StreamErrorPolicy& errorPolicy)
+    {
+        while (!range.empty() && !dropping)
+        {
+            auto part = infra::Head(range, std::numeric_limits<uint16_t>::max());
+
+            infra::ByteOutputStream::WithStorage<sizeof(uint8_t) + sizeof(uint64_t) + sizeof(uint16_t)> header;
+            if (startPending)
+                header << chunkStart << start;
+            else
+                header << chunkContinuation;
+            header << static_cast<uint16_t>(part.size());
+
+            if (header.Writer().Processed().size() + part.size() > queue.MaxSize() - queue.Size())
+            {
+                // The remainder of this trace is dropped, so that the output does not contain a trace with a gap
+                dropping = true;
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+
+            // The drain only takes a chunk when it is complete, so the header and data may be pushed separately
+            queue.Push(header.Writer().Processed());
+            queue.Push(part);
+            startPending = false;
+            range.pop_front(part.size());
+        }
+    }
+
+    std::size_t TracerOnRingBuffers::Lane::Available() const
+    {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    TracerOnRingBuffers::TracerOnRingBuffers(infra::ByteRange laneStorage, infra::BoundedVector<Lane>& lanes, infra::StreamWriter& output, infra::Duration drainInterval)
+        : lanes(lanes)
+        , output(output, infra::noFail)
+        , instance(nextInstance++)
+        , drainTimer(drainInterval, [this]()
+              {
+                  Drain();
+              })
+    {
+        auto laneSize = laneStorage.size() / lanes.max_size();
+
+        while (!lanes.full())
+        {
+            lanes.emplace_back(infra::Head(laneStorage, laneSize));
+            laneStorage.pop_front(laneSize);
+        }
+    }
+
+    infra::TextOutputStream TracerOnRingBuffers::Continue()
+    {
+        auto lane = CurrentLane();
+
+        if (lane != nullptr)
+            return infra::TextOutputStream(*lane, lane->errorPolicy);
+        else
+            return infra::TextOutputStream(noLane, noLaneErrorPolicy);
+    }
+
+    void TracerOnRingBuffers::Drain()
+    {
+        // A lane which did not grow since the previous drain is not in the middle of a trace
+        for (auto& lane : lanes)
+            lane.quiet = lane.queue.Size() == lane.observed;
+
+        TraceInLane trace;
+        while (auto lane = Oldest(trace))
+        {
+            if (!trace.complete)
+                break;
+
+            DrainTrace(*lane, trace);
+        }
+
+        for (auto& lane : lanes)
+            lane.observed = lane.queue.Size();
+
+        ReportDropped();
+    }
+
+    TracerOnRingBuffers::Statistics TracerOnRingBuffers::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void TracerOnRingBuffers::StartTrace()
+    {
+        auto lane = CurrentLane();
+
+        if (lane != nullptr)
+        {
+            lane->start = std::chrono::duration_cast<std::chrono::microseconds>(infra::Now().time_since_epoch()).count();
+            lane->startPending = true;
+            lane->dropping = false;
+        }
+        else
+            droppedWithoutLane.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    TracerOnRingBuffers::Lane* TracerOnRingBuffers::CurrentLane()
+    {
+        if (currentInstance != instance)
+        {
+            currentInstance = instance;
+            currentLane = OwnedLane();
+
+            if (currentLane == nullptr)
+                currentLane = ClaimLane();
+        }
+
+        return currentLane;
+    }
+
+    TracerOnRingBuffers::Lane* TracerOnRingBuffers::OwnedLane()
+    {
+        for (auto& lane : lanes)
+            if (lane.owner.load(std::memory_order_relaxed) == currentThread)
+                return &lane;
+
+        return nullptr;
+    }
+
+    TracerOnRingBuffers::Lane* TracerOnRingBuffers::ClaimLane()
+    {
+        for (auto& lane : lanes)
+        {
+            uint32_t unclaimed = 0;
+            if (lane.owner.compare_exchange_strong(unclaimed, currentThread))
+                return &lane;
+        }
+
+        return nullptr;
+    }
+
+    TracerOnRingBuffers::Lane* TracerOnRingBuffers::Oldest(TraceInLane& trace)
+    {
+        Lane* oldest = nullptr;
+
+        for (auto& lane : lanes)
+        {
+            TraceInLane candidate;
+            if (PeekTrace(lane, candidate) && (oldest == nullptr || candidate.time < trace.time))
+            {
+                oldest = &lane;
+                trace = candidate;
+            }
+        }
+
+        return oldest;
+    }
+
+    bool TracerOnRingBuffers::PeekTrace(Lane& lane, TraceInLane& trace)
+    {
+        // A trace consists of a start chunk followed by continuation chunks. Continuation chunks
+        // without a preceding start chunk are the result of Continue() and belong to the previous trace
+        infra::AtomicByteQueueReader reader(lane.queue);
+        infra::DataInputStream::WithErrorPolicy stream(reader, infra::softFail);
+
+        trace = TraceInLane{ lane.lastStart, 0, lane.quiet };
+
+        while (true)
+        {
+            auto kind = stream.Extract<uint8_t>();
+            if (stream.Failed())
+                break;
+
+            if (kind == chunkStart && trace.size != 0)
+            {
+                trace.complete = true;
+                break;
+            }
+
+            if (kind == chunkStart)
+                trace.time = stream.Extract<uint64_t>();
+
+            auto size = stream.Extract<uint16_t>();
+            if (stream.Failed() || reader.Available() < size)
+                break;
+
+            reader.Rewind(reader.ConstructSaveMarker() + size);
+            trace.size = reader.ConstructSaveMarker();
+        }
+
+        return trace.size != 0;
+    }
+
+    void TracerOnRingBuffers::DrainTrace(Lane& lane, const TraceInLane& trace)
+    {
+        infra::AtomicByteQueueReader reader(lane.queue);
+        infra::DataInputStream::WithErrorPolicy stream(reader);
+
+        while (reader.ConstructSaveMarker() != trace.size)
+        {
+            if (stream.Extract<uint8_t>() == chunkStart)
+            {
+                lane.lastStart = stream.Extract<uint64_t>();
+                InsertHeader(lane.lastStart);
+            }
+
+            std::size_t size = stream.Extract<uint16_t>();
+            while (size != 0)
+            {
+                auto range = reader.ExtractContiguousRange(size);
+                output << infra::data << range;
+                size -= range.size();
+            }
+        }
+
+        reader.Commit();
+    }
+
+    void TracerOnRingBuffers::InsertHeader(uint64_t time)
+    {
+        output << "\r\n";
+        InsertTimeHeader(output, time);
+    }
+
+    void TracerOnRingBuffers::ReportDropped()
+    {
+        uint32_t dropped = droppedWithoutLane.exchange(0, std::memory_order_relaxed);
+        for (auto& lane : lanes)
+            dropped += lane.dropped.exchange(0, std::memory_order_relaxed);
+
+        if (dropped != 0)
+        {
+            statistics.tracesDropped += dropped;
+            output << "\r\n<" << dropped << " traces dropped>";
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef SERVICES_TRACER_ON_RING_BUFFERS_HPP
+#define SERVICES_TRACER_ON_RING_BUFFERS_HPP
+
+#include "infra/stream/AtomicByteQueue.hpp"
+#include "infra/timer/Timer.hpp"
+#include "infra/util/BoundedVector.hpp"
+#include "services/tracer/Tracer.hpp"
+#include <atomic>
+
+namespace services
+{
+    // TracerOnRingBuffers lets multiple threads trace without blocking on each other or on the output.
+    // Each thread claims a lane on its first trace; a lane is a single-producer single-consumer ring buffer
+    // into which that thread writes its traces. On the event dispatcher, the lanes are drained periodically
+    // into a StreamWriter, e.g. a StreamWriterOnSerialCommunication or a StreamWriterOnSeggerRtt; traces are merged
+    // in the order in which they were started, and the time at which they were started is inserted as header.
+    // A trace is drained once the next trace in its lane has started, or once its lane did not change during
+    // a drain interval, so that a trace which is being written is not interleaved with other traces.
+    //
+    // When a lane is full, the trace is dropped instead of waiting for space. The same happens when a thread traces
+    // while all lanes are claimed; lanes are not released when a thread ends. The number of dropped traces is
+    // written to the output with the next drain. A thread tracing to several TracerOnRingBuffers keeps its lane
+    // in each of them.
+    class TracerOnRingBuffers
+        : public Tracer
+    {
+    public:
+        class Lane
+            : public infra::StreamWriter
+        {
+        public:
+            explicit Lane(infra::ByteRange storage);
+            Lane(const Lane& other) = delete;
+            Lane& operator=(const Lane& other) = delete;
+            ~Lane() = default;
+
+            void Insert(infra::ConstByteRange range, infra::StreamErrorPolicy& errorPolicy) override;
+            std::size_t Available() const override;
+
+        private:
+            friend class TracerOnRingBuffers;
+
+            infra::AtomicByteQueue queue;
+            std::atomic<uint32_t> owner{ 0 };
+            std::atomic<uint32_t> dropped{ 0 };
+
+            // Accessed by the thread owning the lane
+            infra::StreamErrorPolicy errorPolicy{ infra::noFail };
+            uint64_t start = 0;
+            bool startPending = false;
+            bool dropping = false;
+
+            // Accessed by the drain
+            uint64_t lastStart = 0;
+            std::size_t observed = 0;
+            bool quiet = false;
+        };
+
+        struct Statistics
+        {
+            uint32_t tracesDropped = 0;
+        };
+
+        template<std::size_t NumberOfLanes, std::size_t LaneSize>
+        using WithLanes = infra::WithStorage<infra::WithStorage<TracerOnRingBuffers, std::array<uint8_t, (LaneSize + 1) * NumberOfLanes>>, typename infra::BoundedVector<Lane>::template WithMaxSize<NumberOfLanes>>;
+
+        TracerOnRingBuffers(infra::ByteRange laneStorage, infra::BoundedVector<Lane>& lanes, infra::StreamWriter& output, infra::Duration drainInterval);
+
+        infra::TextOutputStream Continue() override;
+
+        void Drain();
+
+        Statistics GetStatistics() const;
+
+    protected:
+        void StartTrace() override;
+
+    private:
+        struct TraceInLane
+        {
+            uint64_t time;
+            std::size_t size;
+            bool complete;
+        };
+
+        Lane* CurrentLane();
+        Lane* OwnedLane();
+        Lane* ClaimLane();
+        Lane* Oldest(TraceInLane& trace);
+        bool PeekTrace(Lane& lane, TraceInLane& trace);
+        void DrainTrace(Lane& lane, const TraceInLane& trace);
+        void InsertHeader(uint64_t time);
+        void ReportDropped();
+
+    private:
+        infra::BoundedVector<Lane>& lanes;
+        infra::TextOutputStream::WithErrorPolicy output;
+        infra::StreamWriterDummy noLane;
+        infra::StreamErrorPolicy noLaneErrorPolicy{ infra::noFail };
+        const uint32_t instance;
+        std::atomic<uint32_t> droppedWithoutLane{ 0 };
+        Statistics statistics;
+        infra::TimerRepeating drainTimer;
+    };
+}
+
+#endif
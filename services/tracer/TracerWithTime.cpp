@@ -9,14 +9,19 @@ namespace services
         : TracerToStream(stream)
     {}
 
-    void TracerWithTime::InsertHeader()
+    void InsertTimeHeader(infra::TextOutputStream& stream, uint64_t microseconds)
     {
-        auto now = infra::Now();
-        infra::PartitionedTime partitioned(now);
+        infra::PartitionedTime partitioned(infra::TimePoint(std::chrono::duration_cast<infra::Duration>(std::chrono::microseconds(microseconds))));
+
+        stream << infra::Width(2, '0') << partitioned.hours << infra::resetWidth << ':'
+               << infra::Width(2, '0') << partitioned.minutes << infra::resetWidth << ':'
+               << infra::Width(2, '0') << partitioned.seconds << infra::resetWidth << '.'
+               << infra::Width(6, '0') << microseconds % 1000000 << infra::resetWidth << ' ';
+    }
 
-        Continue() << infra::Width(2, '0') << partitioned.hours << infra::resetWidth << ':'
-                   << infra::Width(2, '0') << partitioned.minutes << infra::resetWidth << ':'
-                   << infra::Width(2, '0') << partitioned.seconds << infra::resetWidth << '.'
-                   << infra::Width(6, '0') << std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count() % 1000000 << ' ';
+    void TracerWithTime::InsertHeader()
+    {
+        auto stream = Continue();
+        InsertTimeHeader(stream, std::chrono::duration_cast<std::chrono::microseconds>(infra::Now().time_since_epoch()).count());
     }
 }
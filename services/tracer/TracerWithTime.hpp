@@ -5,6 +5,9 @@
 
 namespace services
 {
+    // Writes time as "hh:mm:ss.uuuuuu ", the header with which traces are prefixed
+    void InsertTimeHeader(infra::TextOutputStream& stream, uint64_t microseconds);
+
     class TracerWithTime
         : public TracerToStream
     {
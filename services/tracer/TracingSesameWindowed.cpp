@@ -2,8 +2,8 @@
 
 namespace services
 {
-    TracingSesameWindowed::TracingSesameWindowed(SesameEncoded& delegate, Tracer& tracer)
-        : SesameWindowed(delegate)
+    TracingSesameWindowed::TracingSesameWindowed(SesameEncoded& delegate, Tracer& tracer, const Config& config)
+        : SesameWindowed(delegate, config)
         , tracer(tracer)
     {}
 
@@ -10,7 +10,7 @@ namespace services
         : public SesameWindowed
     {
     public:
-        TracingSesameWindowed(SesameEncoded& delegate, Tracer& tracer);
+        TracingSesameWindowed(SesameEncoded& delegate, Tracer& tracer, const Config& config = Config());
 
     protected:
         void ReceivedInit(uint16_t newWindow) override;
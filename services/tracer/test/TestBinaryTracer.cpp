@@ -0,0 +1,122 @@
+#include "infra/stream/ByteOutputStream.hpp"
+#include "infra/stream/StringOutputStream.hpp"
+#include "infra/timer/test_helper/ClockFixture.hpp"
+#include "services/tracer/BinaryTraceDecoder.hpp"
+#include "services/tracer/BinaryTracer.hpp"
+#include "gmock/gmock.h"
+
+extern "C" const char __stop_emil_trace_formats[]; //NOSONAR
+
+class BinaryTracerTest
+    : public testing::Test
+    , public infra::ClockFixture
+{
+public:
+    BinaryTracerTest()
+    {
+        ForwardTime(std::chrono::hours(1) + std::chrono::minutes(20) + std::chrono::seconds(30) + std::chrono::microseconds(5));
+    }
+
+    std::vector<uint8_t> Records() const
+    {
+        return std::vector<uint8_t>(writer.Processed().begin(), writer.Processed().end());
+    }
+
+    std::vector<uint8_t> Time() const
+    {
+        infra::LittleEndian<uint64_t> microseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(infra::Now().time_since_epoch()).count());
+        return std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(&microseconds), reinterpret_cast<const uint8_t*>(&microseconds + 1));
+    }
+
+    std::string Decode(infra::ConstByteRange formats = infra::ConstByteRange())
+    {
+        auto records = Records();
+        infra::ConstByteRange data = infra::MakeRange(records);
+        infra::StringOutputStream::WithStorage<256> output;
+        services::BinaryTraceDecoder decoder(formats, output);
+        decoder.Decode(data);
+        EXPECT_TRUE(data.empty());
+        return std::string(output.Storage().begin(), output.Storage().end());
+    }
+
+    infra::ByteOutputStreamWriter::WithStorage<256> writer;
+    infra::DataOutputStream::WithErrorPolicy stream{ writer };
+    services::BinaryTracer tracer{ stream };
+};
+
+TEST_F(BinaryTracerTest, TraceInline_emits_format_time_and_arguments)
+{
+    tracer.TraceInline("a%d", int16_t(-2), 'c');
+
+    std::vector<uint8_t> expected{ services::BinaryTracer::recordInline, 3, 'a', '%', 'd' };
+    auto time = Time();
+    expected.insert(expected.end(), time.begin(), time.end());
+    expected.insert(expected.end(), { 2, 1, 0xfe, 0xff, 0xff, 0xff, 5, 'c' });
+
+    EXPECT_EQ(expected, Records());
+}
+
+TEST_F(BinaryTracerTest, EMIL_TRACE_BINARY_emits_offset_of_interned_format)
+{
+    EMIL_TRACE_BINARY(tracer, "interned %u", 7u);
+    auto records = Records();
+
+    ASSERT_EQ(services::BinaryTracer::recordInterned, records[0]);
+    infra::LittleEndian<uint32_t> offset;
+    std::memcpy(&offset, &records[1], sizeof(offset));
+    EXPECT_STREQ("interned %u", __start_emil_trace_formats + static_cast<uint32_t>(offset));
+}
+
+TEST_F(BinaryTracerTest, decode_interned_record)
+{
+    EMIL_TRACE_BINARY(tracer, "value %d, %s and %04x", -3, "text", 0xab);
+
+    EXPECT_EQ("\r\n01:20:30.000005 value -3, text and 00ab", Decode(infra::ConstByteRange(reinterpret_cast<const uint8_t*>(__start_emil_trace_formats), reinterpret_cast<const uint8_t*>(__stop_emil_trace_formats))));
+}
+
+TEST_F(BinaryTracerTest, decode_inline_records)
+{
+    tracer.TraceInline("%c%u%%", 'x', -1);
+    tracer.TraceInline("%llu %lld %p", uint64_t(1) << 40, int64_t(-5), 16u);
+
+    EXPECT_EQ("\r\n01:20:30.000005 x4294967295%\r\n01:20:30.000005 1099511627776 -5 0x10", Decode());
+}
+
+TEST_F(BinaryTracerTest, decode_flags_width_and_precision)
+{
+    tracer.TraceInline("[%-4d][%+d][% d][%#x][%#o][%X][%5s][%-3c][%.2s][%08.3d]", 7, 7, 7, 255u, 8u, 0xabu, "ab", 'c', "xyz", -5);
+
+    EXPECT_EQ("\r\n01:20:30.000005 [7   ][+7][ 7][0xff][010][AB][   ab][c  ][xy][    -005]", Decode());
+}
+
+TEST_F(BinaryTracerTest, missing_argument_and_unknown_format_are_marked)
+{
+    tracer.TraceInline("%d");
+    EMIL_TRACE_BINARY(tracer, "x");
+
+    EXPECT_EQ("\r\n01:20:30.000005 <missing>\r\n01:20:30.000005 <unknown format>", Decode());
+}
+
+TEST_F(BinaryTracerTest, incomplete_record_is_kept)
+{
+    tracer.TraceInline("a");
+    tracer.TraceInline("b%d", 1);
+
+    auto records = Records();
+    records.pop_back();
+    infra::ConstByteRange data = infra::MakeRange(records);
+    infra::StringOutputStream::WithStorage<256> output;
+    services::BinaryTraceDecoder decoder(infra::ConstByteRange(), output);
+    decoder.Decode(data);
+
+    EXPECT_EQ("\r\n01:20:30.000005 a", output.Storage());
+    EXPECT_EQ(18, data.size());
+}
+
+TEST_F(BinaryTracerTest, invalid_record_is_skipped)
+{
+    stream << uint8_t(9);
+    tracer.TraceInline("a");
+
+    EXPECT_EQ("\r\n<invalid record 09>\r\n01:20:30.000005 a", Decode());
+}
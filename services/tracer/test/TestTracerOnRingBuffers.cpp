@@ -0,0 +1,171 @@
+#include "infra/stream/StdStringOutputStream.hpp"
+#include "infra/timer/test_helper/ClockFixture.hpp"
+#include "services/tracer/TracerOnRingBuffers.hpp"
+#include "gmock/gmock.h"
+#include <sstream>
+#include <thread>
+
+class TracerOnRingBuffersTest
+    : public testing::Test
+    , public infra::ClockFixture
+{
+public:
+    void TraceOnOtherThread(services::Tracer& tracer, const char* text)
+    {
+        std::thread thread([&tracer, text]()
+            {
+                tracer.Trace() << text;
+            });
+
+        thread.join();
+    }
+
+    void DrainAll()
+    {
+        // During the second drain all lanes are quiet, so that all traces are complete
+        tracer.Drain();
+        tracer.Drain();
+    }
+
+    infra::StdStringOutputStreamWriter::WithStorage writer;
+    services::TracerOnRingBuffers::WithLanes<3, 64> tracer{ writer, std::chrono::milliseconds(10) };
+};
+
+TEST_F(TracerOnRingBuffersTest, trace_is_written_when_its_lane_is_quiet_during_a_drain_interval)
+{
+    tracer.Trace() << "value " << 5;
+    EXPECT_EQ("", writer.Storage());
+
+    ForwardTime(std::chrono::milliseconds(10));
+    EXPECT_EQ("", writer.Storage());
+
+    ForwardTime(std::chrono::milliseconds(10));
+    EXPECT_EQ("\r\n00:00:00.000000 value 5", writer.Storage());
+}
+
+TEST_F(TracerOnRingBuffersTest, trace_is_written_when_next_trace_in_its_lane_starts)
+{
+    tracer.Trace() << "first";
+    tracer.Trace() << "second";
+
+    tracer.Drain();
+    EXPECT_EQ("\r\n00:00:00.000000 first", writer.Storage());
+}
+
+TEST_F(TracerOnRingBuffersTest, traces_of_threads_are_merged_in_time_order)
+{
+    tracer.Trace() << "main 1";
+    ForwardTime(std::chrono::microseconds(1));
+    TraceOnOtherThread(tracer, "other");
+    ForwardTime(std::chrono::microseconds(1));
+    tracer.Trace() << "main 2";
+
+    DrainAll();
+    EXPECT_EQ("\r\n00:00:00.000000 main 1\r\n00:00:00.000001 other\r\n00:00:00.000002 main 2", writer.Storage());
+}
+
+TEST_F(TracerOnRingBuffersTest, continued_trace_stays_with_its_start)
+{
+    tracer.Trace() << "main";
+    ForwardTime(std::chrono::microseconds(1));
+    TraceOnOtherThread(tracer, "other");
+    tracer.Continue() << " continued";
+
+    DrainAll();
+    EXPECT_EQ("\r\n00:00:00.000000 main continued\r\n00:00:00.000001 other", writer.Storage());
+}
+
+TEST_F(TracerOnRingBuffersTest, trace_that_does_not_fit_is_dropped_and_reported)
+{
+    tracer.Trace() << "first";
+    tracer.Trace() << "this trace does not fit in the remaining space of the lane";
+    tracer.Trace() << "last";
+
+    DrainAll();
+    EXPECT_EQ("\r\n00:00:00.000000 first\r\n<1 traces dropped>\r\n00:00:00.000000 last", writer.Storage());
+    EXPECT_EQ(1, tracer.GetStatistics().tracesDropped);
+
+    writer.Storage().clear();
+    DrainAll();
+    EXPECT_EQ("", writer.Storage());
+}
+
+TEST_F(TracerOnRingBuffersTest, trace_of_thread_without_lane_is_dropped)
+{
+    TraceOnOtherThread(tracer, "a");
+    TraceOnOtherThread(tracer, "b");
+    TraceOnOtherThread(tracer, "c");
+    TraceOnOtherThread(tracer, "d");
+
+    DrainAll();
+    EXPECT_EQ("\r\n<1 traces dropped>\r\n00:00:00.000000 a\r\n00:00:00.000000 b\r\n00:00:00.000000 c", writer.Storage());
+}
+
+TEST_F(TracerOnRingBuffersTest, threads_trace_while_draining)
+{
+    infra::StdStringOutputStreamWriter::WithStorage output;
+    services::TracerOnRingBuffers::WithLanes<4, 1024> tracer{ output, std::chrono::milliseconds(10) };
+    std::atomic<int> running{ 4 };
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread != 4; ++thread)
+        threads.emplace_back([&tracer, &running, thread]()
+            {
+                for (int i = 0; i != 1000; ++i)
+                    tracer.Trace() << thread << " " << i;
+
+                --running;
+            });
+
+    while (running != 0)
+        tracer.Drain();
+
+    for (auto& thread : threads)
+        thread.join();
+
+    tracer.Drain();
+    tracer.Drain();
+
+    std::istringstream lines(output.Storage());
+    std::array<int, 4> next{};
+    std::size_t traces = 0;
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        std::istringstream fields(line);
+        std::string time;
+        int thread;
+        int i;
+        if (fields >> time >> thread >> i)
+        {
+            ASSERT_LE(next[thread], i);
+            next[thread] = i + 1;
+            ++traces;
+        }
+    }
+
+    EXPECT_EQ(4 * 1000, traces + tracer.GetStatistics().tracesDropped);
+}
+
+TEST_F(TracerOnRingBuffersTest, thread_alternating_between_tracers_keeps_its_lanes)
+{
+    infra::StdStringOutputStreamWriter::WithStorage otherWriter;
+    services::TracerOnRingBuffers::WithLanes<1, 64> otherTracer{ otherWriter, std::chrono::milliseconds(10) };
+
+    for (int i = 0; i != 2; ++i)
+    {
+        tracer.Trace() << "main " << i;
+        otherTracer.Trace() << "other " << i;
+    }
+
+    DrainAll();
+    otherTracer.Drain();
+    otherTracer.Drain();
+    EXPECT_EQ("\r\n00:00:00.000000 main 0\r\n00:00:00.000000 main 1", writer.Storage());
+    EXPECT_EQ("\r\n00:00:00.000000 other 0\r\n00:00:00.000000 other 1", otherWriter.Storage());
+
+    TraceOnOtherThread(tracer, "a");
+    TraceOnOtherThread(tracer, "b");
+    DrainAll();
+    EXPECT_EQ(0, tracer.GetStatistics().tracesDropped);
+}
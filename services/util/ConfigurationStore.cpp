@@ -1,8 +1,19 @@
 #include "services/util/ConfigurationStore.hpp"
+#include "infra/event/EventDispatcher.hpp"
 #include <algorithm>
 
 namespace services
 {
+    bool ConfigurationBlob::SupportsAppend() const
+    {
+        return false;
+    }
+
+    bool ConfigurationBlob::Append(uint32_t size, const infra::Function<void()>& onDone)
+    {
+        return false;
+    }
+
     ConfigurationBlobFlash::ConfigurationBlobFlash(infra::ByteRange blob, infra::ByteRange verificationBuffer, hal::Flash& flash, services::Sha256& sha256)
         : blob(blob)
         , verificationBuffer(verificationBuffer)
@@ -55,10 +66,7 @@ namespace services
 
     void ConfigurationBlobFlash::IsErased(const infra::Function<void(bool)>& onDone)
     {
-        onErased = onDone;
-        currentVerificationIndex = 0;
-
-        VerifyIfIsErased();
+        IsErasedUpTo(blob.size(), onDone);
     }
 
     infra::ByteRange ConfigurationBlobFlash::Blob()
@@ -71,6 +79,15 @@ namespace services
         return verificationBuffer;
     }
 
+    void ConfigurationBlobFlash::IsErasedUpTo(uint32_t size, const infra::Function<void(bool)>& onDone)
+    {
+        onErased = onDone;
+        currentVerificationIndex = 0;
+        verificationEnd = size;
+
+        VerifyIfIsErased();
+    }
+
     void ConfigurationBlobFlash::RecoverCurrentSize()
     {
         Header header;
@@ -129,10 +146,10 @@ namespace services
 
     void ConfigurationBlobFlash::VerifyIfIsErased()
     {
-        if (currentVerificationIndex != blob.size())
-            flash.ReadBuffer(infra::Head(verificationBuffer, blob.size() - currentVerificationIndex), currentVerificationIndex, [this]()
+        if (currentVerificationIndex != verificationEnd)
+            flash.ReadBuffer(infra::Head(verificationBuffer, verificationEnd - currentVerificationIndex), currentVerificationIndex, [this]()
                 {
-                    auto verificationBlock = infra::Head(verificationBuffer, blob.size() - currentVerificationIndex);
+                    auto verificationBlock = infra::Head(verificationBuffer, verificationEnd - currentVerificationIndex);
 
                     if (std::find_if_not(verificationBlock.begin(), verificationBlock.end(), [](uint8_t byte)
                             {
@@ -149,6 +166,200 @@ namespace services
             onErased(true);
     }
 
+    ConfigurationBlobFlashJournaled::ConfigurationBlobFlashJournaled(infra::ByteRange blob, infra::ByteRange shadow, infra::ByteRange verificationBuffer, hal::Flash& flash, services::Sha256& sha256)
+        : ConfigurationBlobFlash(blob, verificationBuffer, flash, sha256)
+        , shadow(shadow)
+    {
+        really_assert(shadow.size() == MaxBlob().size());
+    }
+
+    void ConfigurationBlobFlashJournaled::Recover(const infra::Function<void(bool success)>& onRecovered)
+    {
+        this->onRecovered = onRecovered;
+        valid = false;
+
+        ConfigurationBlobFlash::Recover([this](bool success)
+            {
+                if (success)
+                {
+                    infra::Copy(MaxBlob(), shadow);
+                    journalEnd = blob.size();
+                    ReplayRecord();
+                }
+                else
+                    this->onRecovered(false);
+            });
+    }
+
+    void ConfigurationBlobFlashJournaled::Write(uint32_t size, const infra::Function<void()>& onDone)
+    {
+        infra::Copy(MaxBlob(), shadow);
+        valid = true;
+        journalEnd = blob.size();
+
+        ConfigurationBlobFlash::Write(size, onDone);
+    }
+
+    void ConfigurationBlobFlashJournaled::Erase(const infra::Function<void()>& onDone)
+    {
+        valid = false;
+
+        ConfigurationBlobFlash::Erase(onDone);
+    }
+
+    void ConfigurationBlobFlashJournaled::IsErased(const infra::Function<void(bool)>& onDone)
+    {
+        IsErasedUpTo(flash.TotalSize(), onDone);
+    }
+
+    bool ConfigurationBlobFlashJournaled::SupportsAppend() const
+    {
+        return true;
+    }
+
+    bool ConfigurationBlobFlashJournaled::Append(uint32_t size, const infra::Function<void()>& onDone)
+    {
+        if (!valid)
+            return false;
+
+        // All changes are captured in a single range, so that a record is either replayed completely or not at all
+        auto contents = infra::Head(MaxBlob(), std::max(size, currentSize));
+        auto mismatch = std::mismatch(contents.begin(), contents.end(), shadow.begin());
+
+        if (mismatch.first == contents.end() && size == currentSize)
+        {
+            infra::EventDispatcher::Instance().Schedule(onDone);
+            return true;
+        }
+
+        uint32_t begin = static_cast<uint32_t>(mismatch.first - contents.begin());
+        uint32_t end = static_cast<uint32_t>(contents.size());
+        while (end != begin && contents[end - 1] == shadow[end - 1])
+            --end;
+
+        record.size = size;
+        record.offset = begin;
+        record.length = end - begin;
+
+        if (!RecordFitsInJournal())
+            return false;
+
+        record.hash = RecordHash();
+        this->onDone = onDone;
+
+        flash.WriteBuffer(infra::MakeByteRange(record), journalEnd, [this]()
+            {
+                flash.WriteBuffer(RecordData(), journalEnd + sizeof(RecordHeader), [this]()
+                    {
+                        ApplyRecordToShadow();
+                        this->onDone();
+                    });
+            });
+
+        return true;
+    }
+
+    infra::ByteRange ConfigurationBlobFlashJournaled::Shadow()
+    {
+        return shadow;
+    }
+
+    uint32_t ConfigurationBlobFlashJournaled::JournalUsed() const
+    {
+        return journalEnd - blob.size();
+    }
+
+    void ConfigurationBlobFlashJournaled::ReplayRecord()
+    {
+        if (journalEnd + sizeof(RecordHeader) > flash.TotalSize())
+        {
+            valid = true;
+            onRecovered(true);
+        }
+        else
+            flash.ReadBuffer(infra::MakeByteRange(record), journalEnd, [this]()
+                {
+                    if (RecordIsErased())
+                    {
+                        valid = true;
+                        onRecovered(true);
+                    }
+                    else if (record.size > MaxBlob().size() || record.offset > MaxBlob().size() || record.length > MaxBlob().size() - record.offset || !RecordFitsInJournal())
+                    {
+                        // A corrupt record ends the journal; the next write rewrites the complete blob
+                        journalEnd = flash.TotalSize();
+                        valid = true;
+                        onRecovered(true);
+                    }
+                    else
+                        ReplayRecordData();
+                });
+    }
+
+    void ConfigurationBlobFlashJournaled::ReplayRecordData()
+    {
+        flash.ReadBuffer(RecordData(), journalEnd + sizeof(RecordHeader), [this]()
+            {
+                if (RecordHash() == record.hash)
+                {
+                    ApplyRecordToShadow();
+                    ReplayRecord();
+                }
+                else
+                {
+                    infra::Copy(infra::Head(infra::DiscardHead(shadow, record.offset), record.length), RecordData());
+                    journalEnd = flash.TotalSize();
+                    valid = true;
+                    onRecovered(true);
+                }
+            });
+    }
+
+    bool ConfigurationBlobFlashJournaled::RecordIsErased() const
+    {
+        auto bytes = infra::MakeByteRange(record);
+        return std::all_of(bytes.begin(), bytes.end(), [](uint8_t byte)
+            {
+                return byte == 0xff;
+            });
+    }
+
+    bool ConfigurationBlobFlashJournaled::RecordFitsInJournal() const
+    {
+        return journalEnd + sizeof(RecordHeader) + record.length <= flash.TotalSize();
+    }
+
+    std::array<uint8_t, 8> ConfigurationBlobFlashJournaled::RecordHash() const
+    {
+        struct
+        {
+            uint32_t size;
+            uint32_t offset;
+            uint32_t length;
+            std::array<uint8_t, 8> dataHash;
+        } input{ record.size, record.offset, record.length };
+
+        auto dataHash = sha256.Calculate(infra::Head(infra::DiscardHead(blob, sizeof(Header) + record.offset), record.length));
+        infra::Copy(infra::Head(infra::MakeRange(dataHash), input.dataHash.size()), infra::MakeRange(input.dataHash));
+
+        auto hash = sha256.Calculate(infra::MakeByteRange(input));
+        std::array<uint8_t, 8> result;
+        infra::Copy(infra::Head(infra::MakeRange(hash), result.size()), infra::MakeRange(result));
+        return result;
+    }
+
+    infra::ByteRange ConfigurationBlobFlashJournaled::RecordData()
+    {
+        return infra::Head(infra::DiscardHead(MaxBlob(), record.offset), record.length);
+    }
+
+    void ConfigurationBlobFlashJournaled::ApplyRecordToShadow()
+    {
+        infra::Copy(RecordData(), infra::Head(infra::DiscardHead(shadow, record.offset), record.length));
+        currentSize = record.size;
+        journalEnd += sizeof(RecordHeader) + record.length;
+    }
+
     ConfigurationBlobReadOnlyMemory::ConfigurationBlobReadOnlyMemory(infra::ConstByteRange data)
         : data(data)
     {}
@@ -243,19 +454,17 @@ namespace services
         if (!writingBlob && !IsLocked())
         {
             ++operationId;
+            writeId = thisId;
             writeRequested = false;
             writingBlob = true;
-            Serialize(*activeBlob, [this, thisId]()
-                {
-                    inactiveBlob->Erase([this, thisId]()
-                        {
-                            BlobWriteDone();
-                            NotifyObservers([thisId](ConfigurationStoreObserver& observer)
-                                {
-                                    observer.OperationDone(thisId);
-                                });
-                        });
-                });
+
+            if (inactiveBlob->SupportsAppend())
+                Serialize(appendingBlob, [this]()
+                    {
+                        AppendDone();
+                    });
+            else
+                WriteFull();
         }
 
         return thisId;
@@ -325,6 +534,22 @@ namespace services
             Write();
     }
 
+    void ConfigurationStoreBase::WriteFull()
+    {
+        Serialize(*activeBlob, [this]()
+            {
+                inactiveBlob->Erase([this]()
+                    {
+                        auto thisId = writeId;
+                        BlobWriteDone();
+                        NotifyObservers([thisId](ConfigurationStoreObserver& observer)
+                            {
+                                observer.OperationDone(thisId);
+                            });
+                    });
+            });
+    }
+
     void ConfigurationStoreBase::OnBlobLoaded(bool success)
     {
         std::swap(activeBlob, inactiveBlob);
@@ -343,6 +568,54 @@ namespace services
             Write();
     }
 
+    void ConfigurationStoreBase::AppendDone()
+    {
+        auto thisId = writeId;
+        writingBlob = false;
+        if (writeRequested)
+            Write();
+
+        NotifyObservers([thisId](ConfigurationStoreObserver& observer)
+            {
+                observer.OperationDone(thisId);
+            });
+    }
+
+    ConfigurationStoreBase::AppendingBlob::AppendingBlob(ConfigurationStoreBase& store)
+        : store(store)
+    {}
+
+    infra::ConstByteRange ConfigurationStoreBase::AppendingBlob::CurrentBlob()
+    {
+        return store.inactiveBlob->CurrentBlob();
+    }
+
+    infra::ByteRange ConfigurationStoreBase::AppendingBlob::MaxBlob()
+    {
+        return store.inactiveBlob->MaxBlob();
+    }
+
+    void ConfigurationStoreBase::AppendingBlob::Recover(const infra::Function<void(bool success)>& onRecovered)
+    {
+        std::abort();
+    }
+
+    void ConfigurationStoreBase::AppendingBlob::Write(uint32_t size, const infra::Function<void()>& onDone)
+    {
+        if (!store.inactiveBlob->Append(size, onDone))
+            store.WriteFull();
+    }
+
+    void ConfigurationStoreBase::AppendingBlob::Erase(const infra::Function<void()>& onDone)
+    {
+        std::abort();
+    }
+
+    void ConfigurationStoreBase::AppendingBlob::IsErased(const infra::Function<void(bool)>& onDone)
+    {
+        std::abort();
+    }
+
     FactoryDefaultConfigurationStoreBase::FactoryDefaultConfigurationStoreBase(ConfigurationStoreBase& configurationStore, ConfigurationBlob& factoryDefaultBlob)
         : configurationStore(configurationStore)
         , factoryDefaultBlob(factoryDefaultBlob)
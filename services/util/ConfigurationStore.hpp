@@ -30,12 +30,17 @@ namespace services
         virtual void Write(uint32_t size, const infra::Function<void()>& onDone) = 0;
         virtual void Erase(const infra::Function<void()>& onDone) = 0;
         virtual void IsErased(const infra::Function<void(bool)>& onDone) = 0;
+
+        // Blobs with a journal can store a change of the current contents as a delta record, without rewriting
+        // the complete blob. MaxBlob() holds the new contents, and Append returns false when the journal is full.
+        virtual bool SupportsAppend() const;
+        virtual bool Append(uint32_t size, const infra::Function<void()>& onDone);
     };
 
     class ConfigurationBlobFlash
         : public ConfigurationBlob
     {
-    private:
+    protected:
         struct Header
         {
             std::array<uint8_t, 8> hash;
@@ -60,6 +65,9 @@ namespace services
         infra::ByteRange Blob();
         infra::ByteRange VerificationBuffer();
 
+    protected:
+        void IsErasedUpTo(uint32_t size, const infra::Function<void(bool)>& onDone);
+
     private:
         void RecoverCurrentSize();
         bool BlobIsValid() const;
@@ -68,18 +76,73 @@ namespace services
         void VerifyBlock();
         void VerifyIfIsErased();
 
-    private:
+    protected:
         infra::ByteRange blob;
         infra::ByteRange verificationBuffer;
         hal::Flash& flash;
         services::Sha256& sha256;
         uint32_t currentSize = 0;
+
+    private:
         uint32_t currentVerificationIndex = 0;
+        uint32_t verificationEnd = 0;
         infra::AutoResetFunction<void(bool success)> onRecovered;
         infra::AutoResetFunction<void()> onDone;
         infra::AutoResetFunction<void(bool success)> onErased;
     };
 
+    // ConfigurationBlobFlashJournaled uses the flash space behind the blob as a journal. Changes are appended as
+    // records holding the changed range of the serialized blob, and recovery replays these records.
+    // The last persisted contents are kept in a shadow buffer to determine which range has changed.
+    class ConfigurationBlobFlashJournaled
+        : public ConfigurationBlobFlash
+    {
+    private:
+        struct RecordHeader
+        {
+            std::array<uint8_t, 8> hash;
+            uint32_t size;
+            uint32_t offset;
+            uint32_t length;
+        };
+
+    public:
+        template<std::size_t Size, std::size_t VerificationSize = 256>
+        using WithStorage = infra::WithStorage<infra::WithStorage<infra::WithStorage<ConfigurationBlobFlashJournaled,
+                                                                      std::array<uint8_t, Size + sizeof(Header)>>,
+                                                   std::array<uint8_t, Size>>,
+            std::array<uint8_t, VerificationSize>>;
+
+        ConfigurationBlobFlashJournaled(infra::ByteRange blob, infra::ByteRange shadow, infra::ByteRange verificationBuffer, hal::Flash& flash, services::Sha256& sha256);
+
+        void Recover(const infra::Function<void(bool success)>& onRecovered) override;
+        void Write(uint32_t size, const infra::Function<void()>& onDone) override;
+        void Erase(const infra::Function<void()>& onDone) override;
+        void IsErased(const infra::Function<void(bool)>& onDone) override;
+        bool SupportsAppend() const override;
+        bool Append(uint32_t size, const infra::Function<void()>& onDone) override;
+
+        infra::ByteRange Shadow();
+        uint32_t JournalUsed() const;
+
+    private:
+        void ReplayRecord();
+        void ReplayRecordData();
+        bool RecordIsErased() const;
+        bool RecordFitsInJournal() const;
+        std::array<uint8_t, 8> RecordHash() const;
+        infra::ByteRange RecordData();
+        void ApplyRecordToShadow();
+
+    private:
+        infra::ByteRange shadow;
+        bool valid = false;
+        uint32_t journalEnd = 0;
+        RecordHeader record;
+        infra::AutoResetFunction<void(bool success)> onRecovered;
+        infra::AutoResetFunction<void()> onDone;
+    };
+
     class ConfigurationBlobReadOnlyMemory
         : public ConfigurationBlob
     {
@@ -207,14 +270,36 @@ namespace services
         void Unlocked() override;
 
     private:
+        // Presents the blob holding the current configuration to Serialize, so that the result is appended to its journal
+        class AppendingBlob
+            : public ConfigurationBlob
+        {
+        public:
+            explicit AppendingBlob(ConfigurationStoreBase& store);
+
+            infra::ConstByteRange CurrentBlob() override;
+            infra::ByteRange MaxBlob() override;
+            void Recover(const infra::Function<void(bool success)>& onRecovered) override;
+            void Write(uint32_t size, const infra::Function<void()>& onDone) override;
+            void Erase(const infra::Function<void()>& onDone) override;
+            void IsErased(const infra::Function<void(bool)>& onDone) override;
+
+        private:
+            ConfigurationStoreBase& store;
+        };
+
+        void WriteFull();
         void OnBlobLoaded(bool success);
         void BlobWriteDone();
+        void AppendDone();
 
     private:
         ConfigurationBlob* activeBlob;
         ConfigurationBlob* inactiveBlob;
+        AppendingBlob appendingBlob{ *this };
         infra::AutoResetFunction<void(bool success)> onRecovered;
         uint32_t operationId = 0;
+        uint32_t writeId = 0;
         bool writingBlob = false;
         bool writeRequested = false;
     };
@@ -239,6 +324,8 @@ namespace services
     public:
         template<std::size_t VerificationSize = 256>
         class WithBlobs;
+        template<std::size_t VerificationSize = 256>
+        class WithJournaledBlobs;
 
         ConfigurationStoreImpl(ConfigurationBlob& blob1, ConfigurationBlob& blob2);
 
@@ -268,6 +355,19 @@ namespace services
         ConfigurationBlobFlash blob2;
     };
 
+    template<class T>
+    template<std::size_t VerificationSize>
+    class ConfigurationStoreImpl<T>::WithJournaledBlobs
+        : public ConfigurationStoreImpl<T>
+    {
+    public:
+        WithJournaledBlobs(hal::Flash& flashFirst, hal::Flash& flashSecond, services::Sha256& sha256, const infra::Function<void(bool success)>& onRecovered);
+
+    private:
+        typename ConfigurationBlobFlashJournaled::WithStorage<T::maxMessageSize, VerificationSize> blob1;
+        ConfigurationBlobFlashJournaled blob2;
+    };
+
     class FactoryDefaultConfigurationStoreBase
         : public ConfigurationStoreInterface
         , protected ConfigurationStoreObserver
@@ -415,6 +515,16 @@ namespace services
         Recover(onRecovered);
     }
 
+    template<class T>
+    template<std::size_t VerificationSize>
+    ConfigurationStoreImpl<T>::WithJournaledBlobs<VerificationSize>::WithJournaledBlobs(hal::Flash& flashFirst, hal::Flash& flashSecond, services::Sha256& sha256, const infra::Function<void(bool success)>& onRecovered)
+        : ConfigurationStoreImpl<T>(blob1, blob2)
+        , blob1(flashFirst, sha256)
+        , blob2(blob1.Blob(), blob1.Shadow(), blob1.VerificationBuffer(), flashSecond, sha256)
+    {
+        Recover(onRecovered);
+    }
+
     template<class T>
     ConfigurationStoreAccess<T>::ConfigurationStoreAccess(ConfigurationStoreInterface& configurationStore, T& configuration)
         : configurationStore(configurationStore)
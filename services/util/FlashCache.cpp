@@ -0,0 +1,277 @@
+#include "services/util/FlashCache.hpp"
+#include "infra/event/EventDispatcher.hpp"
+#include "infra/util/ReallyAssert.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace services
+{
+    FlashCache::FlashCache(infra::ByteRange pageData, infra::MemoryRange<Page> pages, hal::Flash& flash)
+        : FlashDelegate(flash)
+        , pageData(pageData)
+        , pages(pages)
+        , pageSize(static_cast<uint32_t>(pageData.size() / pages.size()))
+    {
+        assert(!pages.empty());
+        assert(pageData.size() == pageSize * pages.size());
+    }
+
+    void FlashCache::WriteBuffer(infra::ConstByteRange buffer, uint32_t address, infra::Function<void()> onDone)
+    {
+        writeBuffer = buffer;
+        this->address = address;
+        this->onDone = onDone;
+
+        ContinueWrite();
+    }
+
+    void FlashCache::ReadBuffer(infra::ByteRange buffer, uint32_t address, infra::Function<void()> onDone)
+    {
+        readBuffer = buffer;
+        this->address = address;
+        this->onDone = onDone;
+
+        ContinueRead();
+    }
+
+    void FlashCache::EraseSectors(uint32_t beginIndex, uint32_t endIndex, infra::Function<void()> onDone)
+    {
+        auto begin = AddressOfSector(beginIndex);
+        auto end = AddressOfSector(endIndex);
+
+        // A page that straddles a sector boundary would hold both erased and retained data
+        really_assert(begin % pageSize == 0 && end % pageSize == 0);
+
+        for (auto& page : pages)
+            if (page.used && page.address >= begin && page.address < end)
+                page = Page();
+
+        FlashDelegate::EraseSectors(beginIndex, endIndex, onDone);
+    }
+
+    void FlashCache::Flush(infra::Function<void()> onDone)
+    {
+        this->onDone = onDone;
+
+        ContinueFlush();
+    }
+
+    const FlashCache::Statistics& FlashCache::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void FlashCache::ResetStatistics()
+    {
+        statistics = Statistics();
+    }
+
+    void FlashCache::ContinueWrite()
+    {
+        while (!writeBuffer.empty())
+        {
+            auto offset = address % pageSize;
+            auto size = std::min<uint32_t>(writeBuffer.size(), pageSize - offset);
+            auto page = Find(address - offset);
+
+            if (page == nullptr)
+            {
+                page = &LeastRecentlyUsed();
+
+                if (page->dirtyBegin != page->dirtyEnd)
+                {
+                    FlushPage(*page, &FlashCache::ContinueWrite);
+                    return;
+                }
+
+                *page = Page();
+                page->used = true;
+                page->address = address - offset;
+                std::fill(Data(*page).begin(), Data(*page).end(), 0xff);
+            }
+
+            Touch(*page);
+
+            auto data = infra::DiscardHead(Data(*page), offset);
+            for (uint32_t i = 0; i != size; ++i)
+                data[i] &= writeBuffer[i];
+
+            if (page->dirtyBegin != page->dirtyEnd)
+            {
+                ++statistics.writesMerged;
+                page->dirtyBegin = std::min(page->dirtyBegin, offset);
+                page->dirtyEnd = std::max(page->dirtyEnd, offset + size);
+            }
+            else
+            {
+                page->dirtyBegin = offset;
+                page->dirtyEnd = offset + size;
+            }
+
+            writeBuffer.pop_front(size);
+            address += size;
+
+            if (page->dirtyBegin == 0 && page->dirtyEnd == pageSize)
+            {
+                FlushPage(*page, &FlashCache::ContinueWrite);
+                return;
+            }
+        }
+
+        Done();
+    }
+
+    void FlashCache::ContinueRead()
+    {
+        while (!readBuffer.empty())
+        {
+            auto offset = address % pageSize;
+            auto size = std::min<uint32_t>(readBuffer.size(), pageSize - offset);
+            auto page = Find(address - offset);
+
+            if (page == nullptr && size == pageSize)
+            {
+                ReadDirect(address);
+                return;
+            }
+
+            if (page != nullptr && page->valid)
+            {
+                ++statistics.readHits;
+                CopyFromPage(*page);
+            }
+            else if (page != nullptr)
+            {
+                // Only part of this page is known, so write it out before reading it back
+                FlushPage(*page, &FlashCache::ContinueRead);
+                return;
+            }
+            else
+            {
+                auto& victim = LeastRecentlyUsed();
+
+                if (victim.dirtyBegin != victim.dirtyEnd)
+                {
+                    FlushPage(victim, &FlashCache::ContinueRead);
+                    return;
+                }
+
+                ++statistics.readMisses;
+                victim = Page();
+                victim.used = true;
+                victim.address = address - offset;
+                Touch(victim);
+
+                busyPage = &victim;
+                FlashDelegate::ReadBuffer(Data(victim), victim.address, [this]()
+                    {
+                        busyPage->valid = true;
+                        CopyFromPage(*busyPage);
+                        ContinueRead();
+                    });
+                return;
+            }
+        }
+
+        Done();
+    }
+
+    void FlashCache::ContinueFlush()
+    {
+        auto page = FindDirty();
+
+        if (page != nullptr)
+            FlushPage(*page, &FlashCache::ContinueFlush);
+        else
+            Done();
+    }
+
+    void FlashCache::Done()
+    {
+        infra::EventDispatcher::Instance().Schedule([this]()
+            {
+                onDone();
+            });
+    }
+
+    FlashCache::Page* FlashCache::Find(uint32_t pageAddress)
+    {
+        for (auto& page : pages)
+            if (page.used && page.address == pageAddress)
+                return &page;
+
+        return nullptr;
+    }
+
+    FlashCache::Page* FlashCache::FindDirty()
+    {
+        for (auto& page : pages)
+            if (page.dirtyBegin != page.dirtyEnd)
+                return &page;
+
+        return nullptr;
+    }
+
+    FlashCache::Page& FlashCache::LeastRecentlyUsed()
+    {
+        return *std::min_element(pages.begin(), pages.end(), [](const Page& x, const Page& y)
+            {
+                return (!x.used && y.used) || (x.used == y.used && x.lastAccess < y.lastAccess);
+            });
+    }
+
+    infra::ByteRange FlashCache::Data(const Page& page)
+    {
+        return infra::Head(infra::DiscardHead(pageData, static_cast<std::size_t>(&page - pages.begin()) * pageSize), pageSize);
+    }
+
+    void FlashCache::CopyFromPage(Page& page)
+    {
+        auto offset = address % pageSize;
+        auto size = std::min<uint32_t>(readBuffer.size(), pageSize - offset);
+
+        Touch(page);
+        infra::Copy(infra::Head(infra::DiscardHead(Data(page), offset), size), infra::Head(readBuffer, size));
+        readBuffer.pop_front(size);
+        address += size;
+    }
+
+    void FlashCache::Touch(Page& page)
+    {
+        page.lastAccess = ++accessCounter;
+    }
+
+    void FlashCache::FlushPage(Page& page, void (FlashCache::*continuation)())
+    {
+        busyPage = &page;
+        this->continuation = continuation;
+
+        FlashDelegate::WriteBuffer(infra::Head(infra::DiscardHead(Data(page), page.dirtyBegin), page.dirtyEnd - page.dirtyBegin), page.address + page.dirtyBegin, [this]()
+            {
+                ++statistics.pagesProgrammed;
+                busyPage->dirtyBegin = 0;
+                busyPage->dirtyEnd = 0;
+                busyPage->used = busyPage->valid;
+                (this->*this->continuation)();
+            });
+    }
+
+    void FlashCache::ReadDirect(uint32_t pageAddress)
+    {
+        // Consecutive whole pages which are not cached are read in one go, without polluting the cache
+        uint32_t size = pageSize;
+        while (readBuffer.size() >= size + pageSize && Find(pageAddress + size) == nullptr)
+            size += pageSize;
+
+        statistics.readMisses += size / pageSize;
+
+        auto buffer = infra::Head(readBuffer, size);
+        readBuffer.pop_front(size);
+        address += size;
+
+        FlashDelegate::ReadBuffer(buffer, pageAddress, [this]()
+            {
+                ContinueRead();
+            });
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef SERVICES_FLASH_CACHE_HPP
+#define SERVICES_FLASH_CACHE_HPP
+
+#include "infra/util/AutoResetFunction.hpp"
+#include "infra/util/ByteRange.hpp"
+#include "infra/util/WithStorage.hpp"
+#include "services/util/FlashDelegate.hpp"
+#include <array>
+
+namespace services
+{
+    // FlashCache keeps a small number of flash pages in RAM. Reads of cached pages are served without accessing
+    // the underlying flash, and writes are merged into the cached pages so that adjacent small writes result in
+    // a single page program operation. Written data is held back until a page is completely written, until
+    // the page is evicted, until data of that page is read, or until Flush is invoked.
+    // Writes are merged by AND-ing them into the page, which matches NOR flash programming semantics.
+    // Sectors passed to EraseSectors must start and end on page boundaries, so the page size must divide the sector sizes.
+    class FlashCache
+        : public FlashDelegate
+    {
+    public:
+        struct Page
+        {
+            bool used = false;
+            bool valid = false;
+            uint32_t address = 0;
+            uint32_t dirtyBegin = 0;
+            uint32_t dirtyEnd = 0;
+            uint32_t lastAccess = 0;
+        };
+
+        struct Statistics
+        {
+            uint32_t readHits = 0;
+            uint32_t readMisses = 0;
+            uint32_t writesMerged = 0;
+            uint32_t pagesProgrammed = 0;
+        };
+
+        template<std::size_t PageSize, std::size_t NumberOfPages>
+        using WithPages = infra::WithStorage<infra::WithStorage<FlashCache, std::array<uint8_t, PageSize * NumberOfPages>>, std::array<Page, NumberOfPages>>;
+
+        FlashCache(infra::ByteRange pageData, infra::MemoryRange<Page> pages, hal::Flash& flash);
+
+        void WriteBuffer(infra::ConstByteRange buffer, uint32_t address, infra::Function<void()> onDone) override;
+        void ReadBuffer(infra::ByteRange buffer, uint32_t address, infra::Function<void()> onDone) override;
+        void EraseSectors(uint32_t beginIndex, uint32_t endIndex, infra::Function<void()> onDone) override;
+
+        void Flush(infra::Function<void()> onDone);
+
+        const Statistics& GetStatistics() const;
+        void ResetStatistics();
+
+    private:
+        void ContinueWrite();
+        void ContinueRead();
+        void ContinueFlush();
+        void Done();
+
+        Page* Find(uint32_t pageAddress);
+        Page* FindDirty();
+        Page& LeastRecentlyUsed();
+        infra::ByteRange Data(const Page& page);
+        void CopyFromPage(Page& page);
+        void Touch(Page& page);
+        void FlushPage(Page& page, void (FlashCache::*continuation)());
+        void ReadDirect(uint32_t pageAddress);
+
+    private:
+        infra::ByteRange pageData;
+        infra::MemoryRange<Page> pages;
+        uint32_t pageSize;
+
+        infra::ConstByteRange writeBuffer;
+        infra::ByteRange readBuffer;
+        uint32_t address = 0;
+        infra::AutoResetFunction<void()> onDone;
+
+        Page* busyPage = nullptr;
+        void (FlashCache::*continuation)() = nullptr;
+
+        uint32_t accessCounter = 0;
+        Statistics statistics;
+    };
+}
+
+#endif
@@ -1,10 +1,17 @@
 #include "services/util/FlashMultipleAccess.hpp"
+#include <algorithm>
 
 namespace services
 {
-    FlashMultipleAccess::FlashMultipleAccess(FlashMultipleAccessMaster& master)
+    FlashMultipleAccessMaster::FlashMultipleAccessMaster(hal::Flash& delegate, const infra::ClaimableResource::Config& config)
+        : FlashDelegate(delegate)
+        , infra::ClaimableResource(config)
+    {}
+
+    FlashMultipleAccess::FlashMultipleAccess(FlashMultipleAccessMaster& master, const Config& config)
         : master(master)
-        , claimer(master)
+        , config(config)
+        , claimer(master, config.priority)
     {}
 
     uint32_t FlashMultipleAccess::NumberOfSectors() const
@@ -30,39 +37,115 @@ namespace services
     void FlashMultipleAccess::WriteBuffer(infra::ConstByteRange buffer, uint32_t address, infra::Function<void()> onDone)
     {
         this->onDone = onDone;
-        claimer.Claim([this, buffer, address]()
-            {
-                master.WriteBuffer(buffer, address, [this]()
-                    {
-                        claimer.Release();
-                        this->onDone();
-                    });
-            });
+        writeBuffer = buffer;
+        this->address = address;
+        Claim(&FlashMultipleAccess::WriteChunk);
     }
 
     void FlashMultipleAccess::ReadBuffer(infra::ByteRange buffer, uint32_t address, infra::Function<void()> onDone)
     {
         this->onDone = onDone;
-        claimer.Claim([this, buffer, address]()
-            {
-                master.ReadBuffer(buffer, address, [this]()
-                    {
-                        claimer.Release();
-                        this->onDone();
-                    });
-            });
+        readBuffer = buffer;
+        this->address = address;
+        Claim(&FlashMultipleAccess::ReadChunk);
     }
 
     void FlashMultipleAccess::EraseSectors(uint32_t beginIndex, uint32_t endIndex, infra::Function<void()> onDone)
     {
         this->onDone = onDone;
-        claimer.Claim([this, beginIndex, endIndex]()
+        address = beginIndex;
+        this->endIndex = endIndex;
+        Claim(&FlashMultipleAccess::EraseChunk);
+    }
+
+    const FlashMultipleAccess::Statistics& FlashMultipleAccess::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void FlashMultipleAccess::ResetStatistics()
+    {
+        statistics = Statistics();
+    }
+
+    void FlashMultipleAccess::Claim(void (FlashMultipleAccess::*operation)())
+    {
+        this->operation = operation;
+
+        if (config.timerServiceId)
+            claimed = infra::Now(*config.timerServiceId);
+
+        claimer.Claim([this]()
             {
-                master.EraseSectors(beginIndex, endIndex, [this]()
-                    {
-                        claimer.Release();
-                        this->onDone();
-                    });
+                Granted();
             });
     }
+
+    void FlashMultipleAccess::Granted()
+    {
+        ++statistics.claims;
+
+        if (config.timerServiceId)
+        {
+            auto delay = infra::Now(*config.timerServiceId) - claimed;
+            statistics.totalQueueingDelay += delay;
+            statistics.maxQueueingDelay = std::max(statistics.maxQueueingDelay, delay);
+        }
+
+        (this->*operation)();
+    }
+
+    void FlashMultipleAccess::WriteChunk()
+    {
+        auto chunk = infra::Head(writeBuffer, config.maxChunkSize);
+        writeBuffer.pop_front(chunk.size());
+        address += chunk.size();
+
+        master.WriteBuffer(chunk, address - chunk.size(), [this]()
+            {
+                ChunkDone(writeBuffer.empty());
+            });
+    }
+
+    void FlashMultipleAccess::ReadChunk()
+    {
+        auto chunk = infra::Head(readBuffer, config.maxChunkSize);
+        readBuffer.pop_front(chunk.size());
+        address += chunk.size();
+
+        master.ReadBuffer(chunk, address - chunk.size(), [this]()
+            {
+                ChunkDone(readBuffer.empty());
+            });
+    }
+
+    void FlashMultipleAccess::EraseChunk()
+    {
+        auto beginIndex = address;
+
+        if (config.maxChunkSize == std::numeric_limits<uint32_t>::max())
+            address = endIndex;
+        else
+        {
+            auto start = master.AddressOfSector(beginIndex);
+            address = std::min(beginIndex + 1, endIndex);
+            while (address != endIndex && master.AddressOfSector(address) + master.SizeOfSector(address) - start <= config.maxChunkSize)
+                ++address;
+        }
+
+        master.EraseSectors(beginIndex, address, [this]()
+            {
+                ChunkDone(address == endIndex);
+            });
+    }
+
+    void FlashMultipleAccess::ChunkDone(bool finished)
+    {
+        claimer.Release();
+
+        if (finished)
+            onDone();
+        else
+            Claim(operation);
+    }
 }
@@ -3,9 +3,12 @@
 
 #include "hal/interfaces/Flash.hpp"
 #include "infra/event/ClaimableResource.hpp"
+#include "infra/timer/Timer.hpp"
 #include "infra/util/AutoResetFunction.hpp"
 #include "infra/util/ByteRange.hpp"
 #include "services/util/FlashDelegate.hpp"
+#include <limits>
+#include <optional>
 
 #ifndef SERVICES_FLASH_MULTIPLE_ACCESS_FUNCTION_EXTRA_SIZE
 #define SERVICES_FLASH_MULTIPLE_ACCESS_FUNCTION_EXTRA_SIZE (sizeof(services::FlashMultipleAccess::LargestLambdaCapture))
@@ -19,13 +22,35 @@ namespace services
     {
     public:
         using FlashDelegate::FlashDelegate;
+        FlashMultipleAccessMaster(hal::Flash& delegate, const infra::ClaimableResource::Config& config);
     };
 
     class FlashMultipleAccess
         : public hal::Flash
     {
     public:
-        explicit FlashMultipleAccess(FlashMultipleAccessMaster& master);
+        struct Config
+        {
+            Config()
+            {}
+
+            // Pending accesses of clients with a higher priority are executed before those of clients with a lower priority
+            uint8_t priority = 0;
+            // Reads and writes are split into chunks of at most maxChunkSize bytes, and erases into groups of sectors
+            // spanning at most maxChunkSize bytes. Between chunks the flash is released so that other clients can interleave.
+            uint32_t maxChunkSize = std::numeric_limits<uint32_t>::max();
+            // When set, the time between requesting and being granted access is measured using this timer service
+            std::optional<uint32_t> timerServiceId;
+        };
+
+        struct Statistics
+        {
+            uint32_t claims = 0;
+            infra::Duration totalQueueingDelay{};
+            infra::Duration maxQueueingDelay{};
+        };
+
+        explicit FlashMultipleAccess(FlashMultipleAccessMaster& master, const Config& config = Config());
 
         uint32_t NumberOfSectors() const override;
         uint32_t SizeOfSector(uint32_t sectorIndex) const override;
@@ -35,8 +60,20 @@ namespace services
         void ReadBuffer(infra::ByteRange buffer, uint32_t address, infra::Function<void()> onDone) override;
         void EraseSectors(uint32_t beginIndex, uint32_t endIndex, infra::Function<void()> onDone) override;
 
+        const Statistics& GetStatistics() const;
+        void ResetStatistics();
+
+    private:
+        void Claim(void (FlashMultipleAccess::*operation)());
+        void Granted();
+        void WriteChunk();
+        void ReadChunk();
+        void EraseChunk();
+        void ChunkDone(bool finished);
+
     private:
         FlashMultipleAccessMaster& master;
+        Config config;
 
         struct LargestLambdaCapture
         {
@@ -47,6 +84,14 @@ namespace services
 
         infra::ClaimableResource::Claimer::WithSize<SERVICES_FLASH_MULTIPLE_ACCESS_FUNCTION_EXTRA_SIZE> claimer;
         infra::AutoResetFunction<void()> onDone;
+
+        void (FlashMultipleAccess::*operation)() = nullptr;
+        infra::ConstByteRange writeBuffer;
+        infra::ByteRange readBuffer;
+        uint32_t address = 0;
+        uint32_t endIndex = 0;
+        infra::TimePoint claimed;
+        Statistics statistics;
     };
 }
 
@@ -63,14 +63,11 @@ namespace services
         flashOperationClaimer.Claim([this, buffer, onDone]()
             {
                 this->onDone = onDone;
-                readBuffer = buffer;
-                spi.SendData(InstructionAndAddress(commandReadData, this->address), hal::SpiAction::continueSession, [this]()
+                transfers = { hal::SpiTransfer{ InstructionAndAddress(commandReadData, this->address), infra::ByteRange() }, hal::SpiTransfer{ infra::ConstByteRange(), buffer } };
+                spi.ExecuteTransfers(transfers, hal::SpiAction::stop, [this]()
                     {
-                        spi.ReceiveData(readBuffer, hal::SpiAction::stop, [this]()
-                            {
-                                flashOperationClaimer.Release();
-                                this->onDone();
-                            });
+                        flashOperationClaimer.Release();
+                        this->onDone();
                     });
             });
     }
@@ -115,14 +112,11 @@ namespace services
         flashIdClaimer.Claim([this, buffer, onDone]()
             {
                 this->onDone = onDone;
-                readBuffer = buffer;
-                spi.SendData(infra::MakeByteRange(commandReadId), hal::SpiAction::continueSession, [this]()
+                transfers = { hal::SpiTransfer{ infra::MakeByteRange(commandReadId), infra::ByteRange() }, hal::SpiTransfer{ infra::ConstByteRange(), buffer } };
+                spi.ExecuteTransfers(transfers, hal::SpiAction::stop, [this]()
                     {
-                        spi.ReceiveData(readBuffer, hal::SpiAction::stop, [this]()
-                            {
-                                flashIdClaimer.Release();
-                                this->onDone();
-                            });
+                        flashIdClaimer.Release();
+                        this->onDone();
                     });
             });
     }
@@ -139,19 +133,17 @@ namespace services
 
     void FlashSpi::PageProgram()
     {
-        writeBuffer = infra::Head(buffer, config.sizePage - AddressOffsetInSector(address) % config.sizePage);
+        auto writeBuffer = infra::Head(buffer, config.sizePage - AddressOffsetInSector(address) % config.sizePage);
         buffer.pop_front(writeBuffer.size());
 
         auto instructionAndAddress = InstructionAndAddress(commandPageProgram, address);
 
         address += writeBuffer.size();
 
-        spi.SendData(instructionAndAddress, hal::SpiAction::continueSession, [this]()
+        transfers = { hal::SpiTransfer{ instructionAndAddress, infra::ByteRange() }, hal::SpiTransfer{ writeBuffer, infra::ByteRange() } };
+        spi.ExecuteTransfers(transfers, hal::SpiAction::stop, [this]()
             {
-                spi.SendData(writeBuffer, hal::SpiAction::stop, [this]()
-                    {
-                        sequencer.Continue();
-                    });
+                sequencer.Continue();
             });
     }
 
@@ -226,12 +218,10 @@ namespace services
     {
         static const uint8_t instruction = commandReadStatusRegister;
 
-        spi.SendData(infra::MakeByteRange(instruction), hal::SpiAction::continueSession, [this]()
+        transfers = { hal::SpiTransfer{ infra::MakeByteRange(instruction), infra::ByteRange() }, hal::SpiTransfer{ infra::ConstByteRange(), infra::MakeByteRange(statusRegister) } };
+        spi.ExecuteTransfers(transfers, hal::SpiAction::stop, [this]()
             {
-                spi.ReceiveData(infra::MakeByteRange(statusRegister), hal::SpiAction::stop, [this]()
-                    {
-                        sequencer.Continue();
-                    });
+                sequencer.Continue();
             });
     }
 
@@ -86,8 +86,7 @@ namespace services
         infra::TimerSingleShot delayTimer;
         infra::AutoResetFunction<void()> onDone;
         infra::ConstByteRange buffer;
-        infra::ConstByteRange writeBuffer;
-        infra::ByteRange readBuffer;
+        std::array<hal::SpiTransfer, 2> transfers;
         uint32_t address = 0;
         uint32_t sectorIndex = 0;
         uint8_t statusRegister = 0;
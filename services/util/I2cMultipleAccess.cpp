@@ -2,8 +2,9 @@
 
 namespace services
 {
-    I2cMultipleAccessMaster::I2cMultipleAccessMaster(hal::I2cMaster& master)
-        : master(master)
+    I2cMultipleAccessMaster::I2cMultipleAccessMaster(hal::I2cMaster& master, const infra::ClaimableResource::Config& config)
+        : infra::ClaimableResource(config)
+        , master(master)
     {}
 
     void I2cMultipleAccessMaster::SendData(hal::I2cAddress address, infra::ConstByteRange data, hal::Action nextAction,
@@ -28,6 +29,12 @@ namespace services
         master.ResetErrorPolicy();
     }
 
+    void I2cMultipleAccessMaster::ExecuteTransfers(hal::I2cAddress address, infra::MemoryRange<const hal::I2cTransfer> transfers, hal::Action nextAction,
+        const infra::Function<void(hal::Result)>& onDone)
+    {
+        master.ExecuteTransfers(address, transfers, nextAction, onDone);
+    }
+
     I2cMultipleAccess::I2cMultipleAccess(I2cMultipleAccessMaster& master)
         : master(master)
         , claimer(master)
@@ -38,10 +45,13 @@ namespace services
     {
         this->onSent = onSent;
         if (!claimer.IsClaimed())
+        {
+            claimer.SetBatchKey(address.address);
             claimer.Claim([this, address, data, nextAction, onSent]()
                 {
                     SendDataOnClaimed(address, data, nextAction);
                 });
+        }
         else
             SendDataOnClaimed(address, data, nextAction);
     }
@@ -65,10 +75,13 @@ namespace services
     {
         this->onReceived = onReceived;
         if (!claimer.IsClaimed())
+        {
+            claimer.SetBatchKey(address.address);
             claimer.Claim([this, address, data, nextAction, onReceived]()
                 {
                     ReceiveDataOnClaimed(address, data, nextAction);
                 });
+        }
         else
             ReceiveDataOnClaimed(address, data, nextAction);
     }
@@ -88,6 +101,37 @@ namespace services
             });
     }
 
+    void I2cMultipleAccess::ExecuteTransfers(hal::I2cAddress address, infra::MemoryRange<const hal::I2cTransfer> transfers, hal::Action nextAction,
+        const infra::Function<void(hal::Result)>& onDone)
+    {
+        onTransfersDone = onDone;
+        if (!claimer.IsClaimed())
+        {
+            claimer.SetBatchKey(address.address);
+            claimer.Claim([this, address, transfers, nextAction]()
+                {
+                    ExecuteTransfersOnClaimed(address, transfers, nextAction);
+                });
+        }
+        else
+            ExecuteTransfersOnClaimed(address, transfers, nextAction);
+    }
+
+    void I2cMultipleAccess::ExecuteTransfersOnClaimed(hal::I2cAddress address, infra::MemoryRange<const hal::I2cTransfer> transfers, hal::Action nextAction)
+    {
+        if (errorPolicy != nullptr)
+            master.SetErrorPolicy(*errorPolicy);
+        else
+            master.ResetErrorPolicy();
+
+        master.ExecuteTransfers(address, transfers, nextAction, [this, nextAction](hal::Result result)
+            {
+                if (nextAction == hal::Action::stop)
+                    claimer.Release();
+                onTransfersDone(result);
+            });
+    }
+
     void I2cMultipleAccess::SetErrorPolicy(hal::I2cErrorPolicy& policy)
     {
         errorPolicy = &policy;
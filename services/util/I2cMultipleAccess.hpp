@@ -16,7 +16,7 @@ namespace services
         , public infra::ClaimableResource
     {
     public:
-        explicit I2cMultipleAccessMaster(hal::I2cMaster& master);
+        explicit I2cMultipleAccessMaster(hal::I2cMaster& master, const infra::ClaimableResource::Config& config = infra::ClaimableResource::Config());
 
         void SendData(hal::I2cAddress address, infra::ConstByteRange data, hal::Action nextAction,
             infra::Function<void(hal::Result, uint32_t numberOfBytesSent)> onSent) override;
@@ -24,6 +24,8 @@ namespace services
             infra::Function<void(hal::Result)> onReceived) override;
         void SetErrorPolicy(hal::I2cErrorPolicy& policy) override;
         void ResetErrorPolicy() override;
+        void ExecuteTransfers(hal::I2cAddress address, infra::MemoryRange<const hal::I2cTransfer> transfers, hal::Action nextAction,
+            const infra::Function<void(hal::Result)>& onDone) override;
 
     private:
         hal::I2cMaster& master;
@@ -41,10 +43,13 @@ namespace services
             infra::Function<void(hal::Result)> onReceived) override;
         void SetErrorPolicy(hal::I2cErrorPolicy& policy) override;
         void ResetErrorPolicy() override;
+        void ExecuteTransfers(hal::I2cAddress address, infra::MemoryRange<const hal::I2cTransfer> transfers, hal::Action nextAction,
+            const infra::Function<void(hal::Result)>& onDone) override;
 
     private:
         void SendDataOnClaimed(hal::I2cAddress address, infra::ConstByteRange data, hal::Action nextAction);
         void ReceiveDataOnClaimed(hal::I2cAddress address, infra::ByteRange data, hal::Action nextAction);
+        void ExecuteTransfersOnClaimed(hal::I2cAddress address, infra::MemoryRange<const hal::I2cTransfer> transfers, hal::Action nextAction);
 
     private:
         I2cMultipleAccessMaster& master;
@@ -52,6 +57,7 @@ namespace services
         infra::ClaimableResource::Claimer::WithSize<SERVICES_I2C_MULTIPLE_ACCESS_FUNCTION_EXTRA_SIZE> claimer;
         infra::AutoResetFunction<void(hal::Result, uint32_t numberOfBytesSent)> onSent;
         infra::AutoResetFunction<void(hal::Result)> onReceived;
+        infra::AutoResetFunction<void(hal::Result)> onTransfersDone;
     };
 }
 
@@ -33,4 +33,16 @@ namespace hal
     {
         spiMaster.ResetCommunicationConfigurator();
     }
+
+    void LowPowerSpiMaster::ExecuteTransfers(infra::MemoryRange<const SpiTransfer> transfers, SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        mainClock.Refere();
+        this->onDone = onDone;
+
+        spiMaster.ExecuteTransfers(transfers, nextAction, [this]()
+            {
+                this->onDone();
+                this->mainClock.Release();
+            });
+    }
 }
@@ -23,6 +23,7 @@ namespace hal
         void SetChipSelectConfigurator(ChipSelectConfigurator& configurator) override;
         void SetCommunicationConfigurator(CommunicationConfigurator& configurator) override;
         void ResetCommunicationConfigurator() override;
+        void ExecuteTransfers(infra::MemoryRange<const SpiTransfer> transfers, SpiAction nextAction, const infra::Function<void()>& onDone) override;
 
     private:
         infra::MainClockReference& mainClock;
@@ -169,7 +169,6 @@ namespace services
 
     uint8_t MessageCommunicationCobs::FindDelimiter() const
     {
-        auto data = infra::Head(dataToSend, 254);
-        return static_cast<uint8_t>(std::find(data.begin(), data.end(), messageDelimiter) - data.begin());
+        return static_cast<uint8_t>(infra::FindAndSplit(infra::Head(dataToSend, 254), messageDelimiter).first.size());
     }
 }
@@ -21,6 +21,16 @@ namespace services
         return MessageCommunicationReceiveOnInterruptObserver::Subject().MaxSendMessageSize() - sizeof(Operation);
     }
 
+    const MessageCommunicationWindowed::Statistics& MessageCommunicationWindowed::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void MessageCommunicationWindowed::ResetStatistics()
+    {
+        statistics = Statistics();
+    }
+
     void MessageCommunicationWindowed::ReceivedMessageOnInterrupt(infra::StreamReader& reader)
     {
         infra::DataInputStream::WithErrorPolicy stream(reader, infra::noFail);
@@ -135,10 +145,16 @@ namespace services
                 }
                 else if (requestedSendMessageSize && WindowSize(*requestedSendMessageSize) <= otherAvailableWindow)
                     state.Emplace<StateSendingMessage>(*this);
-                else if (releasedWindow != 0)
-                    state.Emplace<StateSendingReleaseWindow>(*this);
                 else
-                    state.Emplace<StateOperational>(*this);
+                {
+                    if (requestedSendMessageSize && !std::exchange(stalled, true))
+                        ++statistics.windowStalls;
+
+                    if (releasedWindow != 0)
+                        state.Emplace<StateSendingReleaseWindow>(*this);
+                    else
+                        state.Emplace<StateOperational>(*this);
+                }
             }
 
             switchingState = false;
@@ -233,6 +249,7 @@ namespace services
         : communication(communication)
     {
         communication.sending = true;
+        communication.stalled = false;
         auto writer = communication.MessageCommunicationReceiveOnInterruptObserver::Subject().SendMessageStream(*communication.requestedSendMessageSize + 1, [this](uint16_t sent)
             {
                 OnSent(sent);
@@ -253,6 +270,8 @@ namespace services
     void MessageCommunicationWindowed::StateSendingMessage::OnSent(uint16_t sent)
     {
         communication.otherAvailableWindow -= communication.WindowSize(sent - 1);
+        ++communication.statistics.messagesSent;
+        communication.statistics.bytesSent += sent;
         communication.sending = false;
         communication.SetNextState();
     }
@@ -268,6 +287,7 @@ namespace services
 
         infra::DataOutputStream::WithErrorPolicy stream(*writer);
         stream << PacketReleaseWindow(communication.releasedWindow.exchange(0));
+        ++communication.statistics.releaseWindowsSent;
     }
 
     void MessageCommunicationWindowed::StateSendingReleaseWindow::RequestSendMessage(uint16_t size)
@@ -80,6 +80,14 @@ namespace services
         , private MessageCommunicationReceiveOnInterruptObserver
     {
     public:
+        struct Statistics
+        {
+            uint32_t messagesSent = 0;
+            uint32_t bytesSent = 0;
+            uint32_t releaseWindowsSent = 0;
+            uint32_t windowStalls = 0;
+        };
+
         static constexpr uint32_t RawMessageSize(uint32_t messageSize)
         {
             return messageSize + sizeof(uint32_t);
@@ -94,6 +102,9 @@ namespace services
         void RequestSendMessage(uint16_t size) override;
         std::size_t MaxSendMessageSize() const override;
 
+        const Statistics& GetStatistics() const;
+        void ResetStatistics();
+
     private:
         // Implementation of MessageCommunicationReceiveOnInterruptObserver
         void ReceivedMessageOnInterrupt(infra::StreamReader& reader) override;
@@ -230,6 +241,8 @@ namespace services
         std::atomic<bool> sendInitResponse{ false };
         bool sending = false;
         std::optional<uint16_t> requestedSendMessageSize;
+        bool stalled = false;
+        Statistics statistics;
         infra::PolymorphicVariant<State, StateSendingInit, StateSendingInitResponse, StateOperational, StateSendingMessage, StateSendingReleaseWindow> state;
     };
 }
@@ -2,8 +2,9 @@
 
 namespace services
 {
-    SesameWindowed::SesameWindowed(SesameEncoded& delegate)
+    SesameWindowed::SesameWindowed(SesameEncoded& delegate, const Config& config)
         : SesameEncodedObserver(delegate)
+        , config(config)
         , ownBufferSize(static_cast<uint16_t>(SesameEncodedObserver::Subject().MaxSendMessageSize()))
         , releaseWindowSize(static_cast<uint16_t>(SesameEncodedObserver::Subject().MessageSize(sizeof(PacketReleaseWindow))))
         , state(std::in_place_type_t<StateSendingInit>(), *this)
@@ -19,7 +20,7 @@ namespace services
     std::size_t SesameWindowed::MaxSendMessageSize() const
     {
         assert(initialized);
-        return (std::min(ownBufferSize, maxUsableBufferSize) - sizeof(Operation) - releaseWindowSize - SesameEncodedObserver::Subject().MessageSize(sizeof(Operation))) / 2;
+        return (std::min(ownBufferSize, maxUsableBufferSize) - MessageHeaderSize() - releaseWindowSize - SesameEncodedObserver::Subject().MessageSize(sizeof(Operation))) / 2;
     }
 
     void SesameWindowed::Reset()
@@ -28,12 +29,14 @@ namespace services
         assert(receivedMessageReader == nullptr);
         assert(!readerAccess.Referenced());
         initialized = false;
+        otherCapabilities = 0;
         otherAvailableWindow = 0;
         maxUsableBufferSize = 0;
         releasedWindow = 0;
         sendInitResponse = false;
         sending = false;
         requestedSendMessageSize.reset();
+        stalled = false;
         state.Emplace<StateSendingInit>(*this);
         state->Request();
     }
@@ -43,6 +46,21 @@ namespace services
         readerAccess.SetAction([]() {});
     }
 
+    bool SesameWindowed::Pipelined() const
+    {
+        return config.pipelined && (otherCapabilities & capabilityPipelining) != 0;
+    }
+
+    const SesameWindowed::Statistics& SesameWindowed::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void SesameWindowed::ResetStatistics()
+    {
+        statistics = Statistics();
+    }
+
     void SesameWindowed::Initialized()
     {
         std::abort();
@@ -65,12 +83,14 @@ namespace services
         {
             case Operation::init:
                 otherAvailableWindow = stream.Extract<infra::LittleEndian<uint16_t>>();
+                ReceivedCapabilities(stream);
                 ReceivedInit(otherAvailableWindow);
                 sendInitResponse = true;
                 ReceivedInitialize();
                 break;
             case Operation::initResponse:
                 otherAvailableWindow = stream.Extract<infra::LittleEndian<uint16_t>>();
+                ReceivedCapabilities(stream);
                 ReceivedInitResponse(otherAvailableWindow);
                 releasedWindow = static_cast<uint16_t>(encodedSize);
                 ReceivedInitialize();
@@ -91,6 +111,18 @@ namespace services
                     ForwardReceivedMessage(static_cast<uint16_t>(encodedSize));
                 }
                 break;
+            case Operation::messageWithReleaseWindow:
+                if (initialized)
+                {
+                    auto oldOtherAvailableWindow = otherAvailableWindow;
+                    otherAvailableWindow += stream.Extract<infra::LittleEndian<uint16_t>>();
+                    if (otherAvailableWindow != oldOtherAvailableWindow)
+                        ReceivedReleaseWindow(oldOtherAvailableWindow, otherAvailableWindow);
+
+                    receivedMessageReader = std::move(reader);
+                    ForwardReceivedMessage(static_cast<uint16_t>(encodedSize));
+                }
+                break;
         }
 
         SetNextState();
@@ -103,6 +135,15 @@ namespace services
         GetObserver().Initialized();
     }
 
+    void SesameWindowed::ReceivedCapabilities(infra::DataInputStream& stream)
+    {
+        // Peers without capabilities send init packets without the capabilities byte
+        if (!stream.Empty())
+            otherCapabilities = stream.Extract<uint8_t>();
+        else
+            otherCapabilities = 0;
+    }
+
     void SesameWindowed::ForwardReceivedMessage(uint16_t encodedSize)
     {
         readerAccess.SetAction([this, encodedSize]()
@@ -125,15 +166,39 @@ namespace services
                 if (receivedMessageReader == nullptr)
                     state.Emplace<StateSendingInitResponse>(*this).Request();
             }
-            else if (requestedSendMessageSize != std::nullopt && SesameEncodedObserver::Subject().MessageSize(*requestedSendMessageSize + 1) + releaseWindowSize <= otherAvailableWindow)
+            else if (requestedSendMessageSize != std::nullopt && SesameEncodedObserver::Subject().MessageSize(*requestedSendMessageSize + MessageHeaderSize()) + releaseWindowSize <= otherAvailableWindow)
                 state.Emplace<StateSendingMessage>(*this).Request();
-            else if (releasedWindow > releaseWindowSize && releaseWindowSize <= otherAvailableWindow)
-                state.Emplace<StateSendingReleaseWindow>(*this).Request();
             else
-                state.Emplace<StateOperational>(*this);
+            {
+                if (requestedSendMessageSize != std::nullopt && !std::exchange(stalled, true))
+                    ++statistics.windowStalls;
+
+                if (ReleaseWindowDue() && releaseWindowSize <= otherAvailableWindow)
+                    state.Emplace<StateSendingReleaseWindow>(*this).Request();
+                else
+                    state.Emplace<StateOperational>(*this);
+            }
         }
     }
 
+    bool SesameWindowed::ReleaseWindowDue() const
+    {
+        // When pipelining, small amounts of released window are held back so that they can be piggybacked on a message.
+        // Holding back less than a quarter of the window never blocks the other side, since a message takes at most half of it.
+        if (Pipelined())
+            return releasedWindow > releaseWindowSize && releasedWindow >= ownBufferSize / 4;
+        else
+            return releasedWindow > releaseWindowSize;
+    }
+
+    std::size_t SesameWindowed::MessageHeaderSize() const
+    {
+        if (Pipelined())
+            return sizeof(Operation) + sizeof(uint16_t);
+        else
+            return sizeof(Operation);
+    }
+
     SesameWindowed::PacketInit::PacketInit(uint16_t window)
         : window(window)
     {}
@@ -180,7 +245,7 @@ namespace services
 
     void SesameWindowed::StateSendingInit::Request()
     {
-        communication.SesameEncodedObserver::Subject().RequestSendMessage(3);
+        communication.SesameEncodedObserver::Subject().RequestSendMessage(communication.config.pipelined ? 4 : 3);
     }
 
     void SesameWindowed::StateSendingInit::SendMessageStreamAvailable(infra::SharedPtr<infra::StreamWriter>&& writer)
@@ -188,6 +253,8 @@ namespace services
         communication.SendingInit(communication.ownBufferSize);
         infra::DataOutputStream::WithErrorPolicy stream(*writer);
         stream << PacketInit(communication.ownBufferSize);
+        if (communication.config.pipelined)
+            stream << capabilityPipelining;
     }
 
     void SesameWindowed::StateSendingInit::MessageSent(std::size_t encodedSize)
@@ -205,7 +272,7 @@ namespace services
 
     void SesameWindowed::StateSendingInitResponse::Request()
     {
-        communication.SesameEncodedObserver::Subject().RequestSendMessage(3);
+        communication.SesameEncodedObserver::Subject().RequestSendMessage(communication.config.pipelined ? 4 : 3);
     }
 
     void SesameWindowed::StateSendingInitResponse::SendMessageStreamAvailable(infra::SharedPtr<infra::StreamWriter>&& writer)
@@ -213,6 +280,8 @@ namespace services
         communication.SendingInitResponse(communication.ownBufferSize);
         infra::DataOutputStream::WithErrorPolicy stream(*writer);
         stream << PacketInitResponse(communication.ownBufferSize);
+        if (communication.config.pipelined)
+            stream << capabilityPipelining;
 
         communication.releasedWindow = 0;
         communication.sendInitResponse = false;
@@ -232,9 +301,10 @@ namespace services
 
     SesameWindowed::StateSendingMessage::StateSendingMessage(SesameWindowed& communication)
         : State(communication)
-        , requestedSize(*communication.requestedSendMessageSize + 1)
+        , requestedSize(*communication.requestedSendMessageSize + communication.MessageHeaderSize())
     {
         communication.sending = true;
+        communication.stalled = false;
     }
 
     void SesameWindowed::StateSendingMessage::Request()
@@ -246,7 +316,16 @@ namespace services
     {
         communication.SendingMessage(*writer);
         infra::DataOutputStream::WithErrorPolicy stream(*writer);
-        stream << Operation::message;
+
+        if (communication.Pipelined())
+        {
+            if (communication.releasedWindow != 0)
+                ++communication.statistics.releaseWindowsPiggybacked;
+
+            stream << Operation::messageWithReleaseWindow << infra::LittleEndian<uint16_t>(std::exchange(communication.releasedWindow, 0));
+        }
+        else
+            stream << Operation::message;
 
         communication.requestedSendMessageSize.reset();
         communication.GetObserver().SendMessageStreamAvailable(std::move(writer));
@@ -255,6 +334,8 @@ namespace services
     void SesameWindowed::StateSendingMessage::MessageSent(std::size_t encodedSize)
     {
         communication.otherAvailableWindow -= encodedSize;
+        ++communication.statistics.messagesSent;
+        communication.statistics.bytesSent += encodedSize;
 
         communication.sending = false;
         communication.SetNextState();
@@ -277,5 +358,6 @@ namespace services
         infra::DataOutputStream::WithErrorPolicy stream(*writer);
         stream << PacketReleaseWindow(communication.releasedWindow);
         communication.releasedWindow = 0;
+        ++communication.statistics.releaseWindowsSent;
     }
 }
@@ -16,7 +16,27 @@ namespace services
         , private SesameEncodedObserver
     {
     public:
-        explicit SesameWindowed(SesameEncoded& delegate);
+        struct Config
+        {
+            Config()
+            {}
+
+            // In pipelined mode, released window is piggybacked on outgoing messages, and separate release window
+            // packets are only sent once a quarter of the window has been released. Pipelining is announced during
+            // initialization, and is only used when both sides support it.
+            bool pipelined = false;
+        };
+
+        struct Statistics
+        {
+            uint32_t messagesSent = 0;
+            uint32_t bytesSent = 0;
+            uint32_t releaseWindowsSent = 0;
+            uint32_t releaseWindowsPiggybacked = 0;
+            uint32_t windowStalls = 0;
+        };
+
+        explicit SesameWindowed(SesameEncoded& delegate, const Config& config = Config());
 
         // Implementation of Sesame
         void RequestSendMessage(std::size_t size) override;
@@ -24,6 +44,10 @@ namespace services
         void Reset() override;
         void Stop();
 
+        bool Pipelined() const;
+        const Statistics& GetStatistics() const;
+        void ResetStatistics();
+
     protected:
         // clang-format off
         virtual void ReceivedInit(uint16_t newWindow) {}
@@ -47,8 +71,11 @@ namespace services
 
     private:
         void ReceivedInitialize();
+        void ReceivedCapabilities(infra::DataInputStream& stream);
         void ForwardReceivedMessage(uint16_t encodedSize);
         void SetNextState();
+        bool ReleaseWindowDue() const;
+        std::size_t MessageHeaderSize() const;
 
     private:
         enum class Operation : uint8_t
@@ -56,7 +83,13 @@ namespace services
             init = 1,
             initResponse,
             releaseWindow,
-            message
+            message,
+            messageWithReleaseWindow
+        };
+
+        enum Capabilities : uint8_t
+        {
+            capabilityPipelining = 1
         };
 
         struct PacketInit
@@ -158,9 +191,11 @@ namespace services
         };
 
     private:
+        const Config config;
         const uint16_t ownBufferSize;
         const uint16_t releaseWindowSize;
         bool initialized = false;
+        uint8_t otherCapabilities = 0;
         infra::SharedPtr<infra::StreamReaderWithRewinding> receivedMessageReader;
         infra::AccessedBySharedPtr readerAccess;
         uint16_t otherAvailableWindow{ 0 };
@@ -169,6 +204,8 @@ namespace services
         bool sendInitResponse{ false };
         bool sending = false;
         std::optional<std::size_t> requestedSendMessageSize;
+        bool stalled = false;
+        Statistics statistics;
         infra::PolymorphicVariant<State, StateSendingInit, StateSendingInitResponse, StateOperational, StateSendingMessage, StateSendingReleaseWindow> state;
     };
 }
@@ -29,6 +29,11 @@ namespace services
         spi.ResetCommunicationConfigurator();
     }
 
+    void SpiMasterWithChipSelect::ExecuteTransfers(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        spi.ExecuteTransfers(transfers, nextAction, onDone);
+    }
+
     void SpiMasterWithChipSelect::StartSession()
     {
         if (chipSelectConfigurator != nullptr)
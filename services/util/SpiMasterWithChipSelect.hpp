@@ -18,6 +18,7 @@ namespace services
         void SetChipSelectConfigurator(hal::ChipSelectConfigurator& configurator) override;
         void SetCommunicationConfigurator(hal::CommunicationConfigurator& configurator) override;
         void ResetCommunicationConfigurator() override;
+        void ExecuteTransfers(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone) override;
 
         void StartSession() override;
         void EndSession() override;
@@ -2,8 +2,9 @@
 
 namespace services
 {
-    SpiMultipleAccessMaster::SpiMultipleAccessMaster(hal::SpiMaster& master)
-        : master(master)
+    SpiMultipleAccessMaster::SpiMultipleAccessMaster(hal::SpiMaster& master, const infra::ClaimableResource::Config& config)
+        : infra::ClaimableResource(config)
+        , master(master)
     {}
 
     void SpiMultipleAccessMaster::SendAndReceive(infra::ConstByteRange sendData, infra::ByteRange receiveData, hal::SpiAction nextAction, const infra::Function<void()>& onDone)
@@ -34,6 +35,11 @@ namespace services
         }
     }
 
+    void SpiMultipleAccessMaster::ExecuteTransfers(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        master.ExecuteTransfers(transfers, nextAction, onDone);
+    }
+
     SpiMultipleAccess::SpiMultipleAccess(SpiMultipleAccessMaster& master)
         : master(master)
         , claimer(master)
@@ -50,9 +56,23 @@ namespace services
             SendAndReceiveOnClaimed(sendData, receiveData, nextAction, onDone);
     }
 
+    void SpiMultipleAccess::ExecuteTransfers(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        if (!claimer.IsClaimed())
+            claimer.Claim([this, transfers, nextAction, onDone]()
+                {
+                    ExecuteTransfersOnClaimed(transfers, nextAction, onDone);
+                });
+        else
+            ExecuteTransfersOnClaimed(transfers, nextAction, onDone);
+    }
+
     void SpiMultipleAccess::SetChipSelectConfigurator(hal::ChipSelectConfigurator& configurator)
     {
         chipSelectConfigurator = &configurator;
+
+        // Transfers to the same device are batched
+        claimer.SetBatchKey(reinterpret_cast<uintptr_t>(chipSelectConfigurator));
     }
 
     void SpiMultipleAccess::SetCommunicationConfigurator(hal::CommunicationConfigurator& configurator)
@@ -80,6 +100,18 @@ namespace services
     }
 
     void SpiMultipleAccess::SendAndReceiveOnClaimed(infra::ConstByteRange sendData, infra::ByteRange receiveData, hal::SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        ConfigureMaster();
+        master.SendAndReceive(sendData, receiveData, nextAction, onDone);
+    }
+
+    void SpiMultipleAccess::ExecuteTransfersOnClaimed(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone)
+    {
+        ConfigureMaster();
+        master.ExecuteTransfers(transfers, nextAction, onDone);
+    }
+
+    void SpiMultipleAccess::ConfigureMaster()
     {
         if (communicationConfigurator != nullptr)
             master.SetCommunicationConfigurator(*communicationConfigurator);
@@ -87,6 +119,5 @@ namespace services
             master.ResetCommunicationConfigurator();
 
         master.SetChipSelectConfigurator(*this);
-        master.SendAndReceive(sendData, receiveData, nextAction, onDone);
     }
 }
@@ -16,12 +16,13 @@ namespace services
         , public infra::ClaimableResource
     {
     public:
-        explicit SpiMultipleAccessMaster(hal::SpiMaster& master);
+        explicit SpiMultipleAccessMaster(hal::SpiMaster& master, const infra::ClaimableResource::Config& config = infra::ClaimableResource::Config());
 
         void SendAndReceive(infra::ConstByteRange sendData, infra::ByteRange receiveData, hal::SpiAction nextAction, const infra::Function<void()>& onDone) override;
         void SetChipSelectConfigurator(hal::ChipSelectConfigurator& configurator) override;
         void SetCommunicationConfigurator(hal::CommunicationConfigurator& configurator) override;
         void ResetCommunicationConfigurator() override;
+        void ExecuteTransfers(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone) override;
 
     private:
         hal::SpiMaster& master;
@@ -39,11 +40,14 @@ namespace services
         void SetChipSelectConfigurator(hal::ChipSelectConfigurator& configurator) override;
         void SetCommunicationConfigurator(hal::CommunicationConfigurator& configurator) override;
         void ResetCommunicationConfigurator() override;
+        void ExecuteTransfers(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone) override;
 
     private:
         void StartSession() override;
         void EndSession() override;
         void SendAndReceiveOnClaimed(infra::ConstByteRange sendData, infra::ByteRange receiveData, hal::SpiAction nextAction, const infra::Function<void()>& onDone);
+        void ExecuteTransfersOnClaimed(infra::MemoryRange<const hal::SpiTransfer> transfers, hal::SpiAction nextAction, const infra::Function<void()>& onDone);
+        void ConfigureMaster();
 
     private:
         SpiMultipleAccessMaster& master;
@@ -1129,3 +1129,153 @@ TEST_F(FactoryDefaultConfigurationStoreReadOnlyMemoryIntegrationTest, factory_de
                   0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }),
         flashBlob2.sectors[0]);
 }
+
+class ConfigurationStoreJournaledIntegrationTest
+    : public testing::Test
+    , public infra::EventDispatcherFixture
+{
+public:
+    void ConstructConfigurationStore()
+    {
+        configurationStore.emplace(flashBlob1, flashBlob2, sha256, [this](bool success)
+            {
+                OnRecovered(success);
+            });
+        ExecuteAllActions();
+    }
+
+    void WriteData(std::array<uint8_t, 8> data)
+    {
+        configurationStore->Configuration().data = data;
+        configurationStore->Write();
+        ExecuteAllActions();
+    }
+
+    MOCK_METHOD1(OnRecovered, void(bool success));
+
+    struct Data
+    {
+        void Serialize(infra::ProtoFormatter& formatter)
+        {
+            formatter.PutBytesField(infra::MakeRange(data), 1);
+        }
+
+        void Deserialize(infra::ProtoParser& parser)
+        {
+            infra::ProtoParser::Field field = parser.GetField();
+            assert(field.second == 1);
+            infra::BoundedVector<uint8_t>::WithMaxSize<8> bytes;
+            std::get<infra::ProtoLengthDelimited>(field.first).GetBytes(bytes);
+            assert(bytes.size() == data.size());
+            std::copy(bytes.begin(), bytes.end(), data.begin());
+        }
+
+    public:
+        static const uint32_t maxMessageSize = 10;
+
+        std::array<uint8_t, 8> data{ { 0, 1, 2, 3, 4, 5, 6, 7 } };
+    };
+
+public:
+    services::Sha256MbedTls sha256;
+    hal::FlashStub flashBlob1{ 1, 64 };
+    hal::FlashStub flashBlob2{ 1, 64 };
+    std::optional<services::ConfigurationStoreImpl<Data>::WithJournaledBlobs<>> configurationStore;
+};
+
+TEST_F(ConfigurationStoreJournaledIntegrationTest, first_Write_writes_complete_blob)
+{
+    EXPECT_CALL(*this, OnRecovered(false));
+    ConstructConfigurationStore();
+
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0x0a, 0x00, 0x00, 0x00, 0x0a, 0x08, 1, 2, 3, 4, 5, 6, 7, 8 }), std::vector<uint8_t>(flashBlob1.sectors[0].begin() + 8, flashBlob1.sectors[0].begin() + 22));
+    EXPECT_EQ(std::vector<uint8_t>(64, 0xff), flashBlob2.sectors[0]);
+}
+
+TEST_F(ConfigurationStoreJournaledIntegrationTest, small_change_is_appended_to_journal)
+{
+    EXPECT_CALL(*this, OnRecovered(false));
+    ConstructConfigurationStore();
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    auto blob = std::vector<uint8_t>(flashBlob1.sectors[0].begin(), flashBlob1.sectors[0].begin() + 22);
+
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 8 });
+
+    EXPECT_EQ(blob, std::vector<uint8_t>(flashBlob1.sectors[0].begin(), flashBlob1.sectors[0].begin() + 22));
+    EXPECT_EQ((std::vector<uint8_t>{ 9 }), std::vector<uint8_t>(flashBlob1.sectors[0].begin() + 42, flashBlob1.sectors[0].begin() + 43));
+    EXPECT_EQ(std::vector<uint8_t>(64, 0xff), flashBlob2.sectors[0]);
+}
+
+TEST_F(ConfigurationStoreJournaledIntegrationTest, unchanged_configuration_is_not_written)
+{
+    EXPECT_CALL(*this, OnRecovered(false));
+    ConstructConfigurationStore();
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    auto flash = flashBlob1.sectors[0];
+
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+
+    EXPECT_EQ(flash, flashBlob1.sectors[0]);
+}
+
+TEST_F(ConfigurationStoreJournaledIntegrationTest, journal_is_replayed_on_recovery)
+{
+    EXPECT_CALL(*this, OnRecovered(false));
+    ConstructConfigurationStore();
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 8 });
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 10 });
+
+    configurationStore.reset();
+    EXPECT_CALL(*this, OnRecovered(true));
+    ConstructConfigurationStore();
+
+    EXPECT_EQ((std::array<uint8_t, 8>{ 1, 2, 3, 9, 5, 6, 7, 10 }), configurationStore->Configuration().data);
+}
+
+TEST_F(ConfigurationStoreJournaledIntegrationTest, corrupt_record_is_ignored_on_recovery)
+{
+    EXPECT_CALL(*this, OnRecovered(false));
+    ConstructConfigurationStore();
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 8 });
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 10 });
+
+    flashBlob1.sectors[0][63] = 0;
+
+    configurationStore.reset();
+    EXPECT_CALL(*this, OnRecovered(true));
+    ConstructConfigurationStore();
+
+    EXPECT_EQ((std::array<uint8_t, 8>{ 1, 2, 3, 9, 5, 6, 7, 8 }), configurationStore->Configuration().data);
+
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 11 });
+    EXPECT_EQ(std::vector<uint8_t>(64, 0xff), flashBlob1.sectors[0]);
+
+    configurationStore.reset();
+    EXPECT_CALL(*this, OnRecovered(true));
+    ConstructConfigurationStore();
+
+    EXPECT_EQ((std::array<uint8_t, 8>{ 1, 2, 3, 9, 5, 6, 7, 11 }), configurationStore->Configuration().data);
+}
+
+TEST_F(ConfigurationStoreJournaledIntegrationTest, full_journal_results_in_complete_write_to_other_blob)
+{
+    EXPECT_CALL(*this, OnRecovered(false));
+    ConstructConfigurationStore();
+    WriteData({ 1, 2, 3, 4, 5, 6, 7, 8 });
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 8 });
+    WriteData({ 1, 2, 3, 9, 5, 6, 7, 10 });
+    WriteData({ 11, 2, 3, 9, 5, 6, 7, 10 });
+
+    EXPECT_EQ(std::vector<uint8_t>(64, 0xff), flashBlob1.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 0x0a, 0x00, 0x00, 0x00, 0x0a, 0x08, 11, 2, 3, 9, 5, 6, 7, 10 }), std::vector<uint8_t>(flashBlob2.sectors[0].begin() + 8, flashBlob2.sectors[0].begin() + 22));
+
+    configurationStore.reset();
+    EXPECT_CALL(*this, OnRecovered(true));
+    ConstructConfigurationStore();
+
+    EXPECT_EQ((std::array<uint8_t, 8>{ 11, 2, 3, 9, 5, 6, 7, 10 }), configurationStore->Configuration().data);
+}
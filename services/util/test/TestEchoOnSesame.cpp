@@ -324,3 +324,110 @@ TEST_F(EchoOnSesameTest, invoke_service_proxy_method_after_previous_service_prox
     sesame.GetObserver().SendMessageStreamAvailable(infra::UnOwnedSharedPtr(writer));
     EXPECT_THAT(std::vector<uint8_t>(writer.Processed().begin(), writer.Processed().end()), testing::ElementsAreArray(std::vector<uint8_t>{ 1, (1 << 3) | 2, 2, 8, 5 }));
 }
+
+namespace
+{
+    class ServiceStubWithId
+        : public services::ServiceStub
+    {
+    public:
+        ServiceStubWithId(services::Echo& echo, uint32_t id)
+            : services::ServiceStub(echo)
+            , id(id)
+        {}
+
+        bool AcceptsService(uint32_t serviceId) const override
+        {
+            return serviceId == id;
+        }
+
+    private:
+        uint32_t id;
+    };
+}
+
+class EchoOnSesameConcurrentTest
+    : public testing::Test
+    , public infra::EventDispatcherWithWeakPtrFixture
+{
+public:
+    EchoOnSesameConcurrentTest()
+    {
+        echo.EnableConcurrentMethods(activeMethods);
+    }
+
+    void ReceiveMessage(infra::ConstByteRange data)
+    {
+        sesame.GetObserver().ReceivedMessage(reader.Emplace(data));
+    }
+
+    services::MethodSerializerFactory::ForServices<services::ServiceStub>::Concurrent<2>::AndProxies<services::ServiceStubProxy> serializerFactory;
+    testing::StrictMock<services::EchoErrorPolicyMock> errorPolicy;
+    testing::StrictMock<services::SesameMock> sesame;
+    services::EchoOnSesame echo{ sesame, serializerFactory, errorPolicy };
+    services::EchoOnStreams::ActiveMethods<2> activeMethods;
+
+    testing::StrictMock<ServiceStubWithId> service1{ echo, 1 };
+    testing::StrictMock<ServiceStubWithId> service2{ echo, 2 };
+    testing::StrictMock<ServiceStubWithId> service3{ echo, 3 };
+
+    infra::SharedOptional<infra::ByteInputStreamReader> reader;
+};
+
+TEST_F(EchoOnSesameConcurrentTest, methods_of_different_services_execute_concurrently)
+{
+    EXPECT_CALL(service1, Method(5));
+    EXPECT_CALL(service2, Method(6));
+    auto data = infra::ConstructBin()({ 1, 10, 2, 8, 5, 2, 10, 2, 8, 6 }).Vector();
+    ReceiveMessage(data);
+
+    EXPECT_TRUE(reader.Allocatable());
+
+    service2.MethodDone();
+    service1.MethodDone();
+}
+
+TEST_F(EchoOnSesameConcurrentTest, method_of_busy_service_waits_until_MethodDone)
+{
+    EXPECT_CALL(service1, Method(5));
+    auto data = infra::ConstructBin()({ 1, 10, 2, 8, 5, 1, 10, 2, 8, 6 }).Vector();
+    ReceiveMessage(data);
+
+    EXPECT_FALSE(reader.Allocatable());
+
+    EXPECT_CALL(service1, Method(6));
+    service1.MethodDone();
+
+    EXPECT_TRUE(reader.Allocatable());
+    service1.MethodDone();
+}
+
+TEST_F(EchoOnSesameConcurrentTest, method_waits_when_all_active_methods_are_in_use)
+{
+    EXPECT_CALL(service1, Method(5));
+    EXPECT_CALL(service2, Method(6));
+    auto data = infra::ConstructBin()({ 1, 10, 2, 8, 5, 2, 10, 2, 8, 6, 3, 10, 2, 8, 7 }).Vector();
+    ReceiveMessage(data);
+
+    EXPECT_FALSE(reader.Allocatable());
+
+    EXPECT_CALL(service3, Method(7)).WillOnce(testing::Invoke([this]()
+        {
+            service3.MethodDone();
+        }));
+    service2.MethodDone();
+
+    service1.MethodDone();
+}
+
+TEST_F(EchoOnSesameConcurrentTest, unknown_service_does_not_block_active_methods)
+{
+    EXPECT_CALL(service1, Method(5));
+    EXPECT_CALL(errorPolicy, ServiceNotFound(4));
+    EXPECT_CALL(service2, Method(6));
+    auto data = infra::ConstructBin()({ 1, 10, 2, 8, 5, 4, 10, 2, 8, 5, 2, 10, 2, 8, 6 }).Vector();
+    ReceiveMessage(data);
+
+    service1.MethodDone();
+    service2.MethodDone();
+}
@@ -0,0 +1,184 @@
+#include "hal/interfaces/test_doubles/FlashMock.hpp"
+#include "hal/interfaces/test_doubles/FlashStub.hpp"
+#include "infra/event/test_helper/EventDispatcherFixture.hpp"
+#include "infra/util/test_helper/MockCallback.hpp"
+#include "services/util/FlashCache.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+class FlashCacheTest
+    : public testing::Test
+    , public infra::EventDispatcherFixture
+{
+public:
+    hal::FlashStub flashStub{ 2, 16 };
+    services::FlashCache::WithPages<4, 2> cache{ flashStub };
+};
+
+TEST_F(FlashCacheTest, adjacent_writes_are_merged_into_one_page_program)
+{
+    infra::VerifyingFunction<void()> onDone1;
+    cache.WriteBuffer(std::vector<uint8_t>{ 1, 2 }, 0, onDone1);
+    ExecuteAllActions();
+
+    EXPECT_EQ((std::vector<uint8_t>(16, 0xff)), flashStub.sectors[0]);
+
+    infra::VerifyingFunction<void()> onDone2;
+    cache.WriteBuffer(std::vector<uint8_t>{ 3, 4 }, 2, onDone2);
+    ExecuteAllActions();
+
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }), flashStub.sectors[0]);
+    EXPECT_EQ(1, cache.GetStatistics().writesMerged);
+    EXPECT_EQ(1, cache.GetStatistics().pagesProgrammed);
+}
+
+TEST_F(FlashCacheTest, Flush_writes_partial_pages)
+{
+    cache.WriteBuffer(std::vector<uint8_t>{ 1 }, 5, infra::emptyFunction);
+    ExecuteAllActions();
+
+    infra::VerifyingFunction<void()> onDone;
+    cache.Flush(onDone);
+    ExecuteAllActions();
+
+    EXPECT_EQ(1, flashStub.sectors[0][5]);
+    EXPECT_EQ(1, cache.GetStatistics().pagesProgrammed);
+}
+
+TEST_F(FlashCacheTest, repeated_read_is_served_from_cache)
+{
+    flashStub.sectors[0][1] = 5;
+
+    std::array<uint8_t, 2> buffer{};
+    infra::VerifyingFunction<void()> onDone1;
+    cache.ReadBuffer(buffer, 0, onDone1);
+    ExecuteAllActions();
+    EXPECT_EQ((std::array<uint8_t, 2>{ 0xff, 5 }), buffer);
+
+    flashStub.sectors[0][1] = 6;
+    infra::VerifyingFunction<void()> onDone2;
+    cache.ReadBuffer(buffer, 0, onDone2);
+    ExecuteAllActions();
+    EXPECT_EQ((std::array<uint8_t, 2>{ 0xff, 5 }), buffer);
+
+    EXPECT_EQ(1, cache.GetStatistics().readMisses);
+    EXPECT_EQ(1, cache.GetStatistics().readHits);
+}
+
+TEST_F(FlashCacheTest, read_after_write_sees_written_data)
+{
+    cache.WriteBuffer(std::vector<uint8_t>{ 1 }, 1, infra::emptyFunction);
+    ExecuteAllActions();
+
+    std::array<uint8_t, 3> buffer{};
+    cache.ReadBuffer(buffer, 0, infra::emptyFunction);
+    ExecuteAllActions();
+
+    EXPECT_EQ((std::array<uint8_t, 3>{ 0xff, 1, 0xff }), buffer);
+    EXPECT_EQ(1, flashStub.sectors[0][1]);
+}
+
+TEST_F(FlashCacheTest, whole_uncached_pages_are_read_directly)
+{
+    flashStub.sectors[0][9] = 9;
+
+    std::array<uint8_t, 12> buffer{};
+    cache.ReadBuffer(buffer, 0, infra::emptyFunction);
+    ExecuteAllActions();
+
+    EXPECT_EQ(9, buffer[9]);
+    EXPECT_EQ(3, cache.GetStatistics().readMisses);
+
+    cache.ReadBuffer(buffer, 0, infra::emptyFunction);
+    ExecuteAllActions();
+    EXPECT_EQ(6, cache.GetStatistics().readMisses);
+    EXPECT_EQ(0, cache.GetStatistics().readHits);
+}
+
+TEST_F(FlashCacheTest, least_recently_used_page_is_evicted)
+{
+    std::array<uint8_t, 1> buffer{};
+    for (auto address : { 0, 4, 0, 8 })
+    {
+        cache.ReadBuffer(buffer, address, infra::emptyFunction);
+        ExecuteAllActions();
+    }
+
+    cache.ReadBuffer(buffer, 0, infra::emptyFunction);
+    ExecuteAllActions();
+
+    EXPECT_EQ(3, cache.GetStatistics().readMisses);
+    EXPECT_EQ(2, cache.GetStatistics().readHits);
+}
+
+TEST_F(FlashCacheTest, evicting_dirty_page_programs_it)
+{
+    for (uint8_t i = 0; i != 3; ++i)
+    {
+        cache.WriteBuffer(std::vector<uint8_t>{ static_cast<uint8_t>(i + 1) }, i * 4, infra::emptyFunction);
+        ExecuteAllActions();
+    }
+
+    EXPECT_EQ(1, flashStub.sectors[0][0]);
+    EXPECT_EQ(0xff, flashStub.sectors[0][4]);
+    EXPECT_EQ(0xff, flashStub.sectors[0][8]);
+}
+
+TEST_F(FlashCacheTest, EraseSectors_invalidates_cached_pages)
+{
+    std::array<uint8_t, 1> buffer{};
+    cache.ReadBuffer(buffer, 16, infra::emptyFunction);
+    ExecuteAllActions();
+    cache.WriteBuffer(std::vector<uint8_t>{ 1 }, 20, infra::emptyFunction);
+    ExecuteAllActions();
+
+    infra::VerifyingFunction<void()> onDone;
+    cache.EraseSectors(1, 2, onDone);
+    ExecuteAllActions();
+
+    cache.Flush(infra::emptyFunction);
+    ExecuteAllActions();
+    EXPECT_EQ((std::vector<uint8_t>(16, 0xff)), flashStub.sectors[1]);
+
+    cache.ReadBuffer(buffer, 16, infra::emptyFunction);
+    ExecuteAllActions();
+    EXPECT_EQ(2, cache.GetStatistics().readMisses);
+}
+
+TEST_F(FlashCacheTest, EraseSectors_not_aligned_to_pages_aborts)
+{
+    hal::FlashStub unalignedFlashStub{ 2, 6 };
+    services::FlashCache::WithPages<4, 2> unalignedCache{ unalignedFlashStub };
+
+    EXPECT_DEATH(unalignedCache.EraseSectors(1, 2, infra::emptyFunction), "");
+}
+
+TEST_F(FlashCacheTest, ResetStatistics)
+{
+    std::array<uint8_t, 1> buffer{};
+    cache.ReadBuffer(buffer, 0, infra::emptyFunction);
+    ExecuteAllActions();
+
+    cache.ResetStatistics();
+    EXPECT_EQ(0, cache.GetStatistics().readMisses);
+}
+
+class FlashCacheMockTest
+    : public testing::Test
+    , public infra::EventDispatcherFixture
+{
+public:
+    testing::StrictMock<hal::CleanFlashMock> flash;
+    services::FlashCache::WithPages<4, 1> cache{ flash };
+};
+
+TEST_F(FlashCacheMockTest, read_of_cached_page_does_not_access_flash)
+{
+    EXPECT_CALL(flash, ReadBuffer(testing::_, 0, testing::_)).WillOnce(testing::InvokeArgument<2>());
+
+    std::array<uint8_t, 2> buffer{};
+    cache.ReadBuffer(buffer, 0, infra::emptyFunction);
+    ExecuteAllActions();
+    cache.ReadBuffer(buffer, 2, infra::emptyFunction);
+    ExecuteAllActions();
+}
@@ -1,5 +1,7 @@
 #include "hal/interfaces/test_doubles/FlashMock.hpp"
 #include "infra/event/test_helper/EventDispatcherFixture.hpp"
+#include "infra/timer/test_helper/ClockFixture.hpp"
+#include "infra/util/test_helper/MockCallback.hpp"
 #include "services/util/FlashMultipleAccess.hpp"
 #include "gtest/gtest.h"
 
@@ -118,3 +120,130 @@ TEST_F(FlashMultipleAccessTest, SecondEraseIsExecutedWhenFirstAccessFinishes)
     onDone();
     ExecuteAllActions();
 }
+
+class FlashMultipleAccessPrioritizedTest
+    : public testing::Test
+    , public infra::ClockFixture
+{
+public:
+    FlashMultipleAccessPrioritizedTest()
+        : multipleAccess(flash)
+        , background(multipleAccess, BackgroundConfig())
+        , urgent(multipleAccess, UrgentConfig())
+    {}
+
+    static services::FlashMultipleAccess::Config BackgroundConfig()
+    {
+        services::FlashMultipleAccess::Config config;
+        config.maxChunkSize = 2;
+        config.timerServiceId = infra::systemTimerServiceId;
+        return config;
+    }
+
+    static services::FlashMultipleAccess::Config UrgentConfig()
+    {
+        services::FlashMultipleAccess::Config config;
+        config.priority = 1;
+        config.timerServiceId = infra::systemTimerServiceId;
+        return config;
+    }
+
+    testing::StrictMock<hal::CleanFlashMock> flash;
+    services::FlashMultipleAccessMaster multipleAccess;
+    services::FlashMultipleAccess background;
+    services::FlashMultipleAccess urgent;
+
+    std::array<uint8_t, 5> buffer;
+    infra::Function<void()> onDone;
+};
+
+TEST_F(FlashMultipleAccessPrioritizedTest, large_read_is_split_into_chunks)
+{
+    testing::InSequence s;
+    EXPECT_CALL(flash, ReadBuffer(infra::Head(infra::MakeRange(buffer), 2), 10, testing::_)).WillOnce(testing::InvokeArgument<2>());
+    EXPECT_CALL(flash, ReadBuffer(infra::Head(infra::DiscardHead(infra::MakeRange(buffer), 2), 2), 12, testing::_)).WillOnce(testing::InvokeArgument<2>());
+    EXPECT_CALL(flash, ReadBuffer(infra::DiscardHead(infra::MakeRange(buffer), 4), 14, testing::_)).WillOnce(testing::InvokeArgument<2>());
+
+    infra::VerifyingFunction<void()> done;
+    background.ReadBuffer(buffer, 10, done);
+    ExecuteAllActions();
+
+    EXPECT_EQ(3, background.GetStatistics().claims);
+}
+
+TEST_F(FlashMultipleAccessPrioritizedTest, large_write_is_split_into_chunks)
+{
+    testing::InSequence s;
+    EXPECT_CALL(flash, WriteBuffer(infra::MakeConst(infra::Head(infra::MakeRange(buffer), 2)), 0, testing::_)).WillOnce(testing::InvokeArgument<2>());
+    EXPECT_CALL(flash, WriteBuffer(infra::MakeConst(infra::Head(infra::DiscardHead(infra::MakeRange(buffer), 2), 2)), 2, testing::_)).WillOnce(testing::InvokeArgument<2>());
+    EXPECT_CALL(flash, WriteBuffer(infra::MakeConst(infra::DiscardHead(infra::MakeRange(buffer), 4)), 4, testing::_)).WillOnce(testing::InvokeArgument<2>());
+
+    infra::VerifyingFunction<void()> done;
+    background.WriteBuffer(buffer, 0, done);
+    ExecuteAllActions();
+}
+
+TEST_F(FlashMultipleAccessPrioritizedTest, erase_is_split_into_sector_groups)
+{
+    EXPECT_CALL(flash, AddressOfSector(testing::_)).WillRepeatedly(testing::Invoke([](uint32_t index)
+        {
+            return index * 2;
+        }));
+    EXPECT_CALL(flash, SizeOfSector(testing::_)).WillRepeatedly(testing::Return(2));
+
+    testing::InSequence s;
+    EXPECT_CALL(flash, EraseSectors(0, 1, testing::_)).WillOnce(testing::InvokeArgument<2>());
+    EXPECT_CALL(flash, EraseSectors(1, 2, testing::_)).WillOnce(testing::InvokeArgument<2>());
+
+    infra::VerifyingFunction<void()> done;
+    background.EraseSectors(0, 2, done);
+    ExecuteAllActions();
+}
+
+TEST_F(FlashMultipleAccessPrioritizedTest, split_erase_ending_at_last_sector_only_accesses_existing_sectors)
+{
+    EXPECT_CALL(flash, AddressOfSector(testing::_)).WillRepeatedly(testing::Invoke([](uint32_t index)
+        {
+            EXPECT_LT(index, 3);
+            return index;
+        }));
+    EXPECT_CALL(flash, SizeOfSector(testing::_)).WillRepeatedly(testing::Invoke([](uint32_t index)
+        {
+            EXPECT_LT(index, 3);
+            return 1;
+        }));
+
+    testing::InSequence s;
+    EXPECT_CALL(flash, EraseSectors(0, 2, testing::_)).WillOnce(testing::InvokeArgument<2>());
+    EXPECT_CALL(flash, EraseSectors(2, 3, testing::_)).WillOnce(testing::InvokeArgument<2>());
+
+    infra::VerifyingFunction<void()> done;
+    background.EraseSectors(0, 3, done);
+    ExecuteAllActions();
+}
+
+TEST_F(FlashMultipleAccessPrioritizedTest, higher_priority_access_interleaves_between_chunks)
+{
+    EXPECT_CALL(flash, ReadBuffer(testing::_, 10, testing::_)).WillOnce(testing::SaveArg<2>(&onDone));
+    background.ReadBuffer(buffer, 10, infra::emptyFunction);
+    ExecuteAllActions();
+
+    std::array<uint8_t, 1> urgentBuffer;
+    urgent.WriteBuffer(urgentBuffer, 100, infra::emptyFunction);
+    ForwardTime(std::chrono::milliseconds(5));
+
+    EXPECT_CALL(flash, WriteBuffer(testing::_, 100, testing::_)).WillOnce(testing::SaveArg<2>(&onDone));
+    onDone();
+    ExecuteAllActions();
+
+    EXPECT_CALL(flash, ReadBuffer(testing::_, 12, testing::_));
+    onDone();
+    ExecuteAllActions();
+
+    EXPECT_EQ(std::chrono::milliseconds(5), urgent.GetStatistics().maxQueueingDelay);
+    EXPECT_EQ(std::chrono::milliseconds(5), urgent.GetStatistics().totalQueueingDelay);
+    EXPECT_EQ(1, urgent.GetStatistics().claims);
+
+    urgent.ResetStatistics();
+    EXPECT_EQ(0, urgent.GetStatistics().claims);
+}
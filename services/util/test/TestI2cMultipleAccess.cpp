@@ -277,3 +277,60 @@ TEST_F(I2cMultipleAccessTest, ErrorPolicyIsAppliedForRepeatedStart)
     access1.ReceiveData(hal::I2cAddress(1), buffer, hal::Action::stop, [](hal::Result) {});
     ExecuteAllActions();
 }
+
+TEST_F(I2cMultipleAccessTest, WithDirectHandoffAccessToSameDeviceIsExecutedBackToBack)
+{
+    infra::ClaimableResource::Config config;
+    config.directHandoffBudget = 1;
+    config.batchBudget = 1;
+    services::I2cMultipleAccessMaster batchingMultipleAccess(i2c, config);
+    services::I2cMultipleAccess batchingAccess1(batchingMultipleAccess);
+    services::I2cMultipleAccess batchingAccess2(batchingMultipleAccess);
+    services::I2cMultipleAccess batchingAccess3(batchingMultipleAccess);
+    std::array<uint8_t, 1> buffer;
+
+    EXPECT_CALL(i2c, ResetErrorPolicy());
+    EXPECT_CALL(i2c, ReceiveDataMock(hal::I2cAddress(1), hal::Action::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 5 }));
+    batchingAccess1.ReceiveData(hal::I2cAddress(1), buffer, hal::Action::stop, [](hal::Result) {});
+    batchingAccess2.ReceiveData(hal::I2cAddress(2), buffer, hal::Action::stop, [](hal::Result) {});
+    batchingAccess3.ReceiveData(hal::I2cAddress(1), buffer, hal::Action::stop, [](hal::Result) {});
+    ExecuteAllActions();
+
+    EXPECT_CALL(i2c, ResetErrorPolicy());
+    EXPECT_CALL(i2c, ReceiveDataMock(hal::I2cAddress(1), hal::Action::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 5 }));
+    auto onReceived = i2c.onReceived;
+    onReceived(hal::Result::complete);
+
+    EXPECT_CALL(i2c, ResetErrorPolicy());
+    EXPECT_CALL(i2c, ReceiveDataMock(hal::I2cAddress(2), hal::Action::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 5 }));
+    onReceived = i2c.onReceived;
+    onReceived(hal::Result::complete);
+    ExecuteAllActions();
+
+    i2c.onReceived(hal::Result::complete);
+    ExecuteAllActions();
+}
+
+TEST_F(I2cMultipleAccessTest, TransferChainHoldsClaimUntilChainFinishes)
+{
+    std::array<uint8_t, 1> registerAddress{ 3 };
+    std::array<uint8_t, 1> buffer;
+    std::array<hal::I2cTransfer, 2> transfers{ hal::I2cTransfer::Send(registerAddress), hal::I2cTransfer::Receive(buffer) };
+
+    EXPECT_CALL(i2c, ResetErrorPolicy());
+    EXPECT_CALL(i2c, SendDataMock(hal::I2cAddress(1), hal::Action::repeatedStart, std::vector<uint8_t>{ 3 }));
+    access1.ExecuteTransfers(hal::I2cAddress(1), transfers, hal::Action::stop, [](hal::Result) {});
+    access2.ReceiveData(hal::I2cAddress(1), buffer, hal::Action::stop, [](hal::Result) {});
+    ExecuteAllActions();
+
+    EXPECT_CALL(i2c, ReceiveDataMock(hal::I2cAddress(1), hal::Action::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 5 }));
+    auto onSent = i2c.onSent;
+    onSent(hal::Result::complete, 1);
+    ExecuteAllActions();
+
+    EXPECT_CALL(i2c, ResetErrorPolicy());
+    EXPECT_CALL(i2c, ReceiveDataMock(hal::I2cAddress(1), hal::Action::stop)).WillOnce(testing::Return(std::vector<uint8_t>{ 5 }));
+    auto onReceived = i2c.onReceived;
+    onReceived(hal::Result::complete);
+    ExecuteAllActions();
+}
@@ -69,4 +69,24 @@ TEST_F(LowPowerSpiMasterTest, SendAndReceive_will_refere_mainClock_and_release_o
     ExecuteAllActions();
 
     EXPECT_FALSE(mainClock.IsReferenced());
-}
\ No newline at end of file
+}
+TEST_F(LowPowerSpiMasterTest, ExecuteTransfers_will_refere_mainClock_and_release_onDone)
+{
+    infra::MockCallback<void()> mockOnDone;
+    std::array<uint8_t, 1> command{ 1 };
+    std::array<hal::SpiTransfer, 1> transfers{ { { infra::MakeByteRange(command), infra::ByteRange() } } };
+
+    EXPECT_CALL(spiMock, SendDataMock(std::vector<uint8_t>{ 1 }, hal::SpiAction::stop));
+
+    lowPowerSpiMaster.ExecuteTransfers(transfers, hal::SpiAction::stop, [&mockOnDone]()
+        {
+            mockOnDone.callback();
+        });
+
+    EXPECT_TRUE(mainClock.IsReferenced());
+
+    EXPECT_CALL(mockOnDone, callback());
+    ExecuteAllActions();
+
+    EXPECT_FALSE(mainClock.IsReferenced());
+}
@@ -370,3 +370,25 @@ TEST_F(MessageCommunicationWindowedTest, release_window_while_sending_init_respo
 
     OnSentInitResponse(16);
 }
+
+TEST_F(MessageCommunicationWindowedTest, statistics_count_sent_messages_and_window_stalls)
+{
+    FinishInitialization(2);
+
+    communication.RequestSendMessage(4);
+    ExecuteAllActions();
+    EXPECT_EQ(1, communication.GetStatistics().windowStalls);
+
+    ExpectSendMessageStream(5);
+    ExpectSendMessageStreamAvailable({ 1, 2, 3, 4 });
+    SendReleaseWindow(4);
+
+    OnSentData(infra::ConstructBin().Value<uint8_t>(4)({ 1, 2, 3, 4 }).Vector());
+
+    EXPECT_EQ(1, communication.GetStatistics().messagesSent);
+    EXPECT_EQ(4, communication.GetStatistics().bytesSent);
+    EXPECT_EQ(1, communication.GetStatistics().windowStalls);
+
+    communication.ResetStatistics();
+    EXPECT_EQ(0, communication.GetStatistics().messagesSent);
+}
@@ -526,3 +526,166 @@ TEST_F(SesameWindowedTest, Reset_forwards_to_cobs_and_requests_initialize)
     ExpectSendMessageStreamAvailable({ 1, 2, 3, 4 });
     communication.RequestSendMessage(4);
 }
+
+class SesameWindowedPipelinedTest
+    : public testing::Test
+    , public infra::EventDispatcherFixture
+{
+public:
+    SesameWindowedPipelinedTest()
+    {
+        EXPECT_CALL(base, MessageSize(testing::_)).WillRepeatedly(testing::Invoke([](std::size_t size)
+            {
+                return size + size / 254 + 2;
+            }));
+    }
+
+    static services::SesameWindowed::Config PipelinedConfig()
+    {
+        services::SesameWindowed::Config config;
+        config.pipelined = true;
+        return config;
+    }
+
+    void SendMessageStreamAvailableWithWriter(const std::vector<uint8_t>& expected)
+    {
+        expectedMessage = expected;
+        writer.OnAllocatable([this]()
+            {
+                auto sentDataCopy = std::exchange(sentData, {});
+                base.GetObserver().MessageSent(sentDataCopy.size() + sentDataCopy.size() / 254 + 2);
+                EXPECT_EQ(std::exchange(expectedMessage, {}), sentDataCopy);
+            });
+        base.GetObserver().SendMessageStreamAvailable(writer.Emplace(sentData));
+    }
+
+    void ReceivePacket(const std::vector<uint8_t>& data)
+    {
+        base.GetObserver().ReceivedMessage(reader.Emplace(std::in_place, data), data.size() + data.size() / 254 + 2);
+    }
+
+    void ReceiveInitResponse(uint16_t availableWindow)
+    {
+        EXPECT_CALL(observer, Initialized());
+        ReceivePacket(infra::ConstructBin().Value<uint8_t>(2).Value<infra::LittleEndian<uint16_t>>(availableWindow).Vector());
+    }
+
+    void ReceivePipelinedInitResponse(uint16_t availableWindow)
+    {
+        EXPECT_CALL(observer, Initialized());
+        ReceivePacket(infra::ConstructBin().Value<uint8_t>(2).Value<infra::LittleEndian<uint16_t>>(availableWindow).Value<uint8_t>(1).Vector());
+    }
+
+    void ReceivePipelinedMessage(uint16_t releasedWindow, const std::string& text)
+    {
+        ExpectReceivedMessage(text);
+        ReceivePacket(infra::ConstructBin().Value<uint8_t>(5).Value<infra::LittleEndian<uint16_t>>(releasedWindow)(text).Vector());
+    }
+
+    void ExpectReceivedMessage(const std::string& expected)
+    {
+        EXPECT_CALL(observer, ReceivedMessage(testing::_)).WillOnce(testing::Invoke([expected](infra::SharedPtr<infra::StreamReaderWithRewinding>&& reader)
+            {
+                infra::DataInputStream::WithErrorPolicy stream(*reader);
+                std::string text(stream.Available(), 0);
+                stream >> infra::ByteRange(reinterpret_cast<uint8_t*>(text.data()), reinterpret_cast<uint8_t*>(text.data() + text.size()));
+
+                EXPECT_EQ(expected, text);
+            }));
+    }
+
+    void ExpectRequestSendMessage(uint16_t size, const std::vector<uint8_t>& expected)
+    {
+        EXPECT_CALL(base, RequestSendMessage(size)).WillOnce(testing::Invoke([this, expected](uint16_t size)
+            {
+                SendMessageStreamAvailableWithWriter(expected);
+            }));
+    }
+
+    void ExpectSendMessageStreamAvailable(const std::vector<uint8_t>& data)
+    {
+        EXPECT_CALL(observer, SendMessageStreamAvailable(testing::_)).WillOnce(testing::Invoke([data](infra::SharedPtr<infra::StreamWriter>&& writer)
+            {
+                infra::DataOutputStream::WithErrorPolicy stream(*writer);
+                stream << infra::MakeRange(data);
+            }));
+    }
+
+    testing::StrictMock<services::SesameEncodedMock> base;
+    std::vector<uint8_t> expectedMessage;
+    std::vector<uint8_t> sentData;
+    infra::NotifyingSharedOptional<infra::StdVectorOutputStreamWriter> writer;
+    infra::Execute execute{ [this]()
+        {
+            EXPECT_CALL(base, MaxSendMessageSize()).WillOnce(testing::Return(100));
+            EXPECT_CALL(base, MessageSize(3)).WillOnce(testing::Return(5));
+            ExpectRequestSendMessage(4, infra::ConstructBin().Value<uint8_t>(1).Value<infra::LittleEndian<uint16_t>>(100).Value<uint8_t>(1).Vector());
+        } };
+    infra::SharedOptional<infra::StdVectorInputStreamReader::WithStorage> reader;
+    services::SesameWindowed communication{ base, PipelinedConfig() };
+    testing::StrictMock<services::SesameObserverMock> observer{ communication };
+};
+
+TEST_F(SesameWindowedPipelinedTest, peer_without_pipelining_receives_plain_messages)
+{
+    ReceiveInitResponse(30);
+    EXPECT_FALSE(communication.Pipelined());
+
+    ExpectRequestSendMessage(5, infra::ConstructBin().Value<uint8_t>(4)({ 1, 2, 3, 4 }).Vector());
+    ExpectSendMessageStreamAvailable({ 1, 2, 3, 4 });
+    communication.RequestSendMessage(4);
+}
+
+TEST_F(SesameWindowedPipelinedTest, init_request_is_answered_with_capabilities)
+{
+    EXPECT_CALL(observer, Initialized());
+    ExpectRequestSendMessage(4, infra::ConstructBin().Value<uint8_t>(2).Value<infra::LittleEndian<uint16_t>>(100).Value<uint8_t>(1).Vector());
+    ReceivePacket(infra::ConstructBin().Value<uint8_t>(1).Value<infra::LittleEndian<uint16_t>>(30).Value<uint8_t>(1).Vector());
+
+    EXPECT_TRUE(communication.Pipelined());
+}
+
+TEST_F(SesameWindowedPipelinedTest, released_window_is_piggybacked_on_message)
+{
+    ReceivePipelinedInitResponse(30);
+    EXPECT_TRUE(communication.Pipelined());
+
+    // 6 bytes for the init response plus 9 bytes for the message remain below a quarter of the window
+    ReceivePipelinedMessage(0, "abcd");
+
+    ExpectRequestSendMessage(7, infra::ConstructBin().Value<uint8_t>(5).Value<infra::LittleEndian<uint16_t>>(15)({ 1, 2, 3, 4 }).Vector());
+    ExpectSendMessageStreamAvailable({ 1, 2, 3, 4 });
+    communication.RequestSendMessage(4);
+
+    EXPECT_EQ(1, communication.GetStatistics().messagesSent);
+    EXPECT_EQ(9, communication.GetStatistics().bytesSent);
+    EXPECT_EQ(1, communication.GetStatistics().releaseWindowsPiggybacked);
+    EXPECT_EQ(0, communication.GetStatistics().releaseWindowsSent);
+}
+
+TEST_F(SesameWindowedPipelinedTest, release_window_is_sent_after_a_quarter_of_the_window_is_released)
+{
+    ReceivePipelinedInitResponse(30);
+
+    ReceivePipelinedMessage(0, "abcd");
+    ReceivePipelinedMessage(0, "abcd");
+
+    ExpectRequestSendMessage(3, infra::ConstructBin().Value<uint8_t>(3).Value<infra::LittleEndian<uint16_t>>(33).Vector());
+    ReceivePipelinedMessage(0, "abcd");
+
+    EXPECT_EQ(1, communication.GetStatistics().releaseWindowsSent);
+}
+
+TEST_F(SesameWindowedPipelinedTest, piggybacked_release_window_resumes_stalled_message)
+{
+    ReceivePipelinedInitResponse(10);
+
+    communication.RequestSendMessage(4);
+    EXPECT_EQ(1, communication.GetStatistics().windowStalls);
+
+    ExpectRequestSendMessage(7, infra::ConstructBin().Value<uint8_t>(5).Value<infra::LittleEndian<uint16_t>>(15)({ 1, 2, 3, 4 }).Vector());
+    ExpectSendMessageStreamAvailable({ 1, 2, 3, 4 });
+    ReceivePipelinedMessage(10, "abcd");
+
+    EXPECT_EQ(1, communication.GetStatistics().windowStalls);
+}
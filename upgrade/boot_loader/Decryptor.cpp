@@ -0,0 +1,12 @@
+#include "upgrade/boot_loader/Decryptor.hpp"
+
+namespace application
+{
+    bool Decryptor::SavePosition(infra::ByteRange position) const
+    {
+        return false;
+    }
+
+    void Decryptor::RestorePosition(infra::ConstByteRange position)
+    {}
+}
@@ -13,6 +13,14 @@ namespace application
         virtual void DecryptPart(infra::ByteRange data) = 0;
         virtual bool DecryptAndAuthenticate(infra::ByteRange data) = 0;
 
+        // Decryptors that support it save their position in the stream into position, which holds at least maxPositionSize
+        // bytes, so that decryption can later continue from that position again, for instance to decrypt part of an image
+        // twice. SavePosition returns false when this is not supported.
+        virtual bool SavePosition(infra::ByteRange position) const;
+        virtual void RestorePosition(infra::ConstByteRange position);
+
+        static constexpr std::size_t maxPositionSize = 33;
+
     protected:
         ~Decryptor() = default;
     };
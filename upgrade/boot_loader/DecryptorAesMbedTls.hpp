@@ -18,6 +18,8 @@ namespace application
         void Reset() override;
         void DecryptPart(infra::ByteRange data) override;
         bool DecryptAndAuthenticate(infra::ByteRange data) override;
+        bool SavePosition(infra::ByteRange position) const override;
+        void RestorePosition(infra::ConstByteRange position) override;
 
     private:
         mbedtls_aes_context ctx;
@@ -1,4 +1,5 @@
 #include "upgrade/boot_loader/DecryptorAesTiny.hpp"
+#include <algorithm>
 
 extern "C"
 {
@@ -56,4 +57,21 @@ namespace application
 
         return true;
     }
+
+    bool DecryptorAesTiny::SavePosition(infra::ByteRange position) const
+    {
+        static_assert(2 * blockLength + 1 <= maxPositionSize, "Position does not fit");
+
+        auto end = std::copy(counter.begin(), counter.end(), position.begin());
+        end = std::copy(currentStreamBlock.begin(), currentStreamBlock.end(), end);
+        *end = static_cast<uint8_t>(currentStreamBlockOffset);
+        return true;
+    }
+
+    void DecryptorAesTiny::RestorePosition(infra::ConstByteRange position)
+    {
+        std::copy(position.begin(), position.begin() + blockLength, counter.begin());
+        std::copy(position.begin() + blockLength, position.begin() + 2 * blockLength, currentStreamBlock.begin());
+        currentStreamBlockOffset = position[2 * blockLength];
+    }
 }
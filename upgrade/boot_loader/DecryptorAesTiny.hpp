@@ -17,6 +17,8 @@ namespace application
         void Reset() override;
         void DecryptPart(infra::ByteRange data) override;
         bool DecryptAndAuthenticate(infra::ByteRange data) override;
+        bool SavePosition(infra::ByteRange position) const override;
+        void RestorePosition(infra::ConstByteRange position) override;
 
     private:
         void IncreaseCounter();
@@ -17,4 +17,12 @@ namespace application
     {
         return true;
     }
+
+    bool DecryptorNone::SavePosition(infra::ByteRange position) const
+    {
+        return true;
+    }
+
+    void DecryptorNone::RestorePosition(infra::ConstByteRange position)
+    {}
 }
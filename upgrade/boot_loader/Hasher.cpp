@@ -0,0 +1,24 @@
+#include "upgrade/boot_loader/Hasher.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace application
+{
+    std::array<uint8_t, 32> Hasher::Calculate(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& data, infra::ByteRange buffer)
+    {
+        assert(!buffer.empty());
+
+        Start();
+
+        auto address = data.first;
+        while (address != data.second)
+        {
+            auto chunk = infra::Head(buffer, data.second - address);
+            flash.ReadBuffer(chunk, address);
+            Update(chunk);
+            address += chunk.size();
+        }
+
+        return Finish();
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef UPGRADE_HASHER_HPP
+#define UPGRADE_HASHER_HPP
+
+#include "hal/synchronous_interfaces/SynchronousFlash.hpp"
+#include "infra/util/ByteRange.hpp"
+#include <array>
+
+namespace application
+{
+    // Incremental SHA-256 calculation. Implementations may drive a hardware hash peripheral instead of hashing in software.
+    class Hasher
+    {
+    public:
+        virtual void Start() = 0;
+        virtual void Update(infra::ConstByteRange data) = 0;
+        virtual std::array<uint8_t, 32> Finish() = 0;
+
+        // Reads data from flash in chunks of the size of buffer, so that a large buffer results in few flash reads
+        // and few, large, updates of the hash
+        std::array<uint8_t, 32> Calculate(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& data, infra::ByteRange buffer);
+
+    protected:
+        ~Hasher() = default;
+    };
+}
+
+#endif
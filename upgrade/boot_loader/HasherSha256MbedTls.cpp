@@ -0,0 +1,31 @@
+#include "upgrade/boot_loader/HasherSha256MbedTls.hpp"
+
+namespace application
+{
+    HasherSha256MbedTls::HasherSha256MbedTls()
+    {
+        mbedtls_sha256_init(&ctx);
+    }
+
+    HasherSha256MbedTls::~HasherSha256MbedTls()
+    {
+        mbedtls_sha256_free(&ctx);
+    }
+
+    void HasherSha256MbedTls::Start()
+    {
+        mbedtls_sha256_starts(&ctx, 0);
+    }
+
+    void HasherSha256MbedTls::Update(infra::ConstByteRange data)
+    {
+        mbedtls_sha256_update(&ctx, data.begin(), data.size());
+    }
+
+    std::array<uint8_t, 32> HasherSha256MbedTls::Finish()
+    {
+        std::array<uint8_t, 32> hash;
+        mbedtls_sha256_finish(&ctx, hash.data());
+        return hash;
+    }
+}
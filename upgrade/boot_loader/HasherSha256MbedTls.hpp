@@ -0,0 +1,27 @@
+#ifndef UPGRADE_HASHER_SHA256_MBED_TLS_HPP
+#define UPGRADE_HASHER_SHA256_MBED_TLS_HPP
+
+#include "mbedtls/sha256.h"
+#include "upgrade/boot_loader/Hasher.hpp"
+
+namespace application
+{
+    class HasherSha256MbedTls
+        : public Hasher
+    {
+    public:
+        HasherSha256MbedTls();
+        HasherSha256MbedTls(const HasherSha256MbedTls& other) = delete;
+        HasherSha256MbedTls& operator=(const HasherSha256MbedTls& other) = delete;
+        ~HasherSha256MbedTls();
+
+        void Start() override;
+        void Update(infra::ConstByteRange data) override;
+        std::array<uint8_t, 32> Finish() override;
+
+    private:
+        mbedtls_sha256_context ctx;
+    };
+}
+
+#endif
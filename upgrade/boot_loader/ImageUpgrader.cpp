@@ -16,4 +16,19 @@ namespace application
     {
         return decryptor;
     }
+
+    uint32_t ImageUpgrader::SectorsRewritten() const
+    {
+        return sectorsRewrittenUnknown;
+    }
+
+    hal::SynchronousFlash* ImageUpgrader::DestinationFlash()
+    {
+        return nullptr;
+    }
+
+    uint32_t ImageUpgrader::DestinationAddress(uint32_t destinationAddress) const
+    {
+        return destinationAddress;
+    }
 }
@@ -17,6 +17,17 @@ namespace application
         Decryptor& ImageDecryptor();
         virtual uint32_t Upgrade(hal::SynchronousFlash& flash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress) = 0;
 
+        // Number of destination sectors erased and programmed by the last Upgrade, or sectorsRewrittenUnknown
+        // for upgraders that do not keep track of this
+        virtual uint32_t SectorsRewritten() const;
+
+        static constexpr uint32_t sectorsRewrittenUnknown = 0xffffffff;
+
+        // The flash and address that Upgrade writes an image for destinationAddress to, so that decorators can inspect
+        // the written image; upgraders that do not write the image into flash return nullptr
+        virtual hal::SynchronousFlash* DestinationFlash();
+        virtual uint32_t DestinationAddress(uint32_t destinationAddress) const;
+
     protected:
         ~ImageUpgrader() = default;
 
@@ -0,0 +1,208 @@
+#include "upgrade/boot_loader/ImageUpgraderDecompressLz4.hpp"
+#include "upgrade/pack/UpgradePackHeader.hpp"
+#include <cstdlib>
+
+namespace application
+{
+    ImageUpgraderDecompressLz4::ImageUpgraderDecompressLz4(infra::ByteRange window, const char* targetName, Decryptor& decryptor, ImageUpgrader& upgrader)
+        : ImageUpgrader(targetName, decryptor)
+        , window(window)
+        , upgrader(upgrader)
+    {}
+
+    uint32_t ImageUpgraderDecompressLz4::Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress)
+    {
+        CompressedImageHeader header;
+        if (imageSize < sizeof(header))
+            return upgradeErrorCodeImageDecompressionFailed;
+
+        upgradePackFlash.ReadBuffer(infra::MakeByteRange(header), imageAddress);
+        ImageDecryptor().DecryptPart(infra::MakeByteRange(header));
+
+        if (header.magic != compressedImageMagicLz4 || header.windowSize > window.size())
+            return upgradeErrorCodeImageDecompressionFailed;
+
+        this->upgradePackFlash = &upgradePackFlash;
+        inputAddress = imageAddress + sizeof(header);
+        inputRemaining = imageSize - sizeof(header);
+        inputAvailable = infra::ByteRange();
+        uncompressedSize = header.uncompressedSize;
+        produced = 0;
+        literalsRemaining = 0;
+        matchRemaining = 0;
+        matchPending = false;
+        failed = false;
+
+        auto result = upgrader.Upgrade(*this, 0, uncompressedSize, destinationAddress);
+
+        if (result == 0 && !DecompressedCompletely())
+            return upgradeErrorCodeImageDecompressionFailed;
+
+        return result;
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::SectorsRewritten() const
+    {
+        return upgrader.SectorsRewritten();
+    }
+
+    hal::SynchronousFlash* ImageUpgraderDecompressLz4::DestinationFlash()
+    {
+        return upgrader.DestinationFlash();
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::DestinationAddress(uint32_t destinationAddress) const
+    {
+        return upgrader.DestinationAddress(destinationAddress);
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::NumberOfSectors() const
+    {
+        return 1;
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::SizeOfSector(uint32_t sectorIndex) const
+    {
+        return uncompressedSize;
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::SectorOfAddress(uint32_t address) const
+    {
+        return 0;
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::AddressOfSector(uint32_t sectorIndex) const
+    {
+        return 0;
+    }
+
+    void ImageUpgraderDecompressLz4::WriteBuffer(infra::ConstByteRange buffer, uint32_t address)
+    {
+        std::abort();
+    }
+
+    void ImageUpgraderDecompressLz4::ReadBuffer(infra::ByteRange buffer, uint32_t address)
+    {
+        if (address != produced)
+            failed = true;
+
+        for (auto& value : buffer)
+            value = NextByte();
+    }
+
+    void ImageUpgraderDecompressLz4::EraseSectors(uint32_t beginIndex, uint32_t endIndex)
+    {
+        std::abort();
+    }
+
+    uint8_t ImageUpgraderDecompressLz4::NextByte()
+    {
+        while (!failed)
+        {
+            if (literalsRemaining != 0)
+            {
+                --literalsRemaining;
+                return Emit(ReadInput());
+            }
+
+            if (matchPending)
+                StartMatch();
+
+            if (matchRemaining != 0)
+            {
+                --matchRemaining;
+                return Emit(window[(produced - matchOffset) % window.size()]);
+            }
+
+            StartSequence();
+        }
+
+        return 0;
+    }
+
+    void ImageUpgraderDecompressLz4::StartSequence()
+    {
+        if (InputExhausted())
+        {
+            failed = true;
+            return;
+        }
+
+        auto token = ReadInput();
+        literalsRemaining = ReadLength(token >> 4);
+        matchCode = token & 0xf;
+        matchPending = true;
+    }
+
+    void ImageUpgraderDecompressLz4::StartMatch()
+    {
+        matchPending = false;
+
+        // The last sequence of a block consists of literals only
+        if (InputExhausted())
+            return;
+
+        matchOffset = ReadInput();
+        matchOffset |= ReadInput() << 8;
+        matchRemaining = ReadLength(matchCode) + 4;
+
+        if (matchOffset == 0 || matchOffset > window.size() || matchOffset > produced)
+            failed = true;
+    }
+
+    uint32_t ImageUpgraderDecompressLz4::ReadLength(uint32_t length)
+    {
+        if (length == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                extra = ReadInput();
+                length += extra;
+            } while (extra == 255 && !failed);
+        }
+
+        return length;
+    }
+
+    bool ImageUpgraderDecompressLz4::DecompressedCompletely() const
+    {
+        // Both the input and the output must end exactly at a sequence boundary; anything left over on either side means
+        // that uncompressedSize does not describe the compressed data
+        return !failed && produced == uncompressedSize && literalsRemaining == 0 && matchRemaining == 0 && InputExhausted();
+    }
+
+    bool ImageUpgraderDecompressLz4::InputExhausted() const
+    {
+        return inputAvailable.empty() && inputRemaining == 0;
+    }
+
+    uint8_t ImageUpgraderDecompressLz4::ReadInput()
+    {
+        if (inputAvailable.empty())
+        {
+            if (inputRemaining == 0)
+            {
+                failed = true;
+                return 0;
+            }
+
+            inputAvailable = infra::Head(infra::MakeRange(input), inputRemaining);
+            upgradePackFlash->ReadBuffer(inputAvailable, inputAddress);
+            ImageDecryptor().DecryptPart(inputAvailable);
+            inputAddress += inputAvailable.size();
+            inputRemaining -= inputAvailable.size();
+        }
+
+        auto value = inputAvailable.front();
+        inputAvailable.pop_front();
+        return value;
+    }
+
+    uint8_t ImageUpgraderDecompressLz4::Emit(uint8_t value)
+    {
+        window[produced % window.size()] = value;
+        ++produced;
+        return value;
+    }
+}
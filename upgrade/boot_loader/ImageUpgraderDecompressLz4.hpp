@@ -0,0 +1,72 @@
+#ifndef UPGRADE_IMAGE_UPGRADER_DECOMPRESS_LZ4_HPP
+#define UPGRADE_IMAGE_UPGRADER_DECOMPRESS_LZ4_HPP
+
+#include "infra/util/WithStorage.hpp"
+#include "upgrade/boot_loader/ImageUpgrader.hpp"
+#include <array>
+
+namespace application
+{
+    // ImageUpgraderDecompressLz4 decorates another ImageUpgrader for images that are compressed by ImageCompressorLz4.
+    // It decrypts the compressed data with its own decryptor and decompresses it on the fly while the decorated upgrader
+    // reads the image, so the decorated upgrader must be constructed with a DecryptorNone. RAM usage is constant: only the
+    // window, which must be at least as large as the window the image was compressed with, and a small input buffer.
+    // The decorated upgrader must read the image sequentially. Images without the LZ4 marker in their CompressedImageHeader,
+    // and images whose data does not decompress to exactly uncompressedSize bytes, are rejected.
+    class ImageUpgraderDecompressLz4
+        : public ImageUpgrader
+        , private hal::SynchronousFlash
+    {
+    public:
+        template<std::size_t Size>
+        using WithWindowSize = infra::WithStorage<ImageUpgraderDecompressLz4, std::array<uint8_t, Size>>;
+
+        ImageUpgraderDecompressLz4(infra::ByteRange window, const char* targetName, Decryptor& decryptor, ImageUpgrader& upgrader);
+
+        uint32_t Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress) override;
+        uint32_t SectorsRewritten() const override;
+        hal::SynchronousFlash* DestinationFlash() override;
+        uint32_t DestinationAddress(uint32_t destinationAddress) const override;
+
+    private:
+        // Implementation of hal::SynchronousFlash, presenting the decompressed image to the decorated upgrader
+        uint32_t NumberOfSectors() const override;
+        uint32_t SizeOfSector(uint32_t sectorIndex) const override;
+        uint32_t SectorOfAddress(uint32_t address) const override;
+        uint32_t AddressOfSector(uint32_t sectorIndex) const override;
+        void WriteBuffer(infra::ConstByteRange buffer, uint32_t address) override;
+        void ReadBuffer(infra::ByteRange buffer, uint32_t address) override;
+        void EraseSectors(uint32_t beginIndex, uint32_t endIndex) override;
+
+    private:
+        uint8_t NextByte();
+        void StartSequence();
+        void StartMatch();
+        uint32_t ReadLength(uint32_t length);
+        bool DecompressedCompletely() const;
+        bool InputExhausted() const;
+        uint8_t ReadInput();
+        uint8_t Emit(uint8_t value);
+
+    private:
+        infra::ByteRange window;
+        ImageUpgrader& upgrader;
+
+        hal::SynchronousFlash* upgradePackFlash = nullptr;
+        uint32_t inputAddress = 0;
+        uint32_t inputRemaining = 0;
+        std::array<uint8_t, 16> input;
+        infra::ByteRange inputAvailable;
+
+        uint32_t uncompressedSize = 0;
+        uint32_t produced = 0;
+        uint32_t literalsRemaining = 0;
+        uint32_t matchRemaining = 0;
+        uint32_t matchOffset = 0;
+        uint8_t matchCode = 0;
+        bool matchPending = false;
+        bool failed = false;
+    };
+}
+
+#endif
@@ -0,0 +1,243 @@
+#include "upgrade/boot_loader/ImageUpgraderDelta.hpp"
+#include "infra/util/ReallyAssert.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace application
+{
+    ImageUpgraderDelta::ImageUpgraderDelta(const char* targetName, Decryptor& decryptor, ImageUpgrader& upgrader, const Verifier& verifier,
+        hal::SynchronousFlash& baseFlash, uint32_t baseAddress)
+        : ImageUpgrader(targetName, decryptor)
+        , upgrader(upgrader)
+        , verifier(verifier)
+        , baseFlash(baseFlash)
+        , baseAddress(baseAddress)
+    {
+        really_assert(upgrader.DestinationFlash() != nullptr);
+    }
+
+    uint32_t ImageUpgraderDelta::Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress)
+    {
+        if (imageSize < sizeof(header))
+            return upgradeErrorCodeDeltaImageInvalid;
+
+        upgradePackFlash.ReadBuffer(infra::MakeByteRange(header), imageAddress);
+        ImageDecryptor().DecryptPart(infra::MakeByteRange(header));
+
+        if (header.signatureLength > header.baseSignature.size())
+            return upgradeErrorCodeDeltaImageInvalid;
+
+        SignedRegion base(baseFlash, baseAddress, header.baseSize, infra::Head(infra::MakeRange(header.baseSignature), header.signatureLength));
+        if (!base.IsValid(verifier))
+            return upgradeErrorCodeDeltaBaseMismatch;
+
+        this->upgradePackFlash = &upgradePackFlash;
+        inputAddress = imageAddress + sizeof(header);
+        inputRemaining = imageSize - sizeof(header);
+        inputAvailable = infra::ByteRange();
+        produced = 0;
+        basePosition = 0;
+        record = DeltaRecord{};
+        failed = false;
+
+        auto result = upgrader.Upgrade(*this, 0, header.imageSize, destinationAddress);
+        if (result != 0)
+            return result;
+
+        SignedRegion image(*upgrader.DestinationFlash(), upgrader.DestinationAddress(destinationAddress), header.imageSize, infra::Head(infra::MakeRange(header.imageSignature), header.signatureLength));
+        if (failed || !image.IsValid(verifier))
+            return upgradeErrorCodeDeltaImageInvalid;
+
+        return 0;
+    }
+
+    uint32_t ImageUpgraderDelta::SectorsRewritten() const
+    {
+        return upgrader.SectorsRewritten();
+    }
+
+    hal::SynchronousFlash* ImageUpgraderDelta::DestinationFlash()
+    {
+        return upgrader.DestinationFlash();
+    }
+
+    uint32_t ImageUpgraderDelta::DestinationAddress(uint32_t destinationAddress) const
+    {
+        return upgrader.DestinationAddress(destinationAddress);
+    }
+
+    uint32_t ImageUpgraderDelta::NumberOfSectors() const
+    {
+        return 1;
+    }
+
+    uint32_t ImageUpgraderDelta::SizeOfSector(uint32_t sectorIndex) const
+    {
+        return header.imageSize;
+    }
+
+    uint32_t ImageUpgraderDelta::SectorOfAddress(uint32_t address) const
+    {
+        return 0;
+    }
+
+    uint32_t ImageUpgraderDelta::AddressOfSector(uint32_t sectorIndex) const
+    {
+        return 0;
+    }
+
+    void ImageUpgraderDelta::WriteBuffer(infra::ConstByteRange buffer, uint32_t address)
+    {
+        std::abort();
+    }
+
+    void ImageUpgraderDelta::ReadBuffer(infra::ByteRange buffer, uint32_t address)
+    {
+        if (address != produced)
+            failed = true;
+
+        while (!buffer.empty() && !failed)
+        {
+            if (record.diffLength != 0)
+            {
+                auto part = infra::Head(buffer, record.diffLength);
+                if (part.size() > header.baseSize - basePosition)
+                {
+                    failed = true;
+                    break;
+                }
+
+                baseFlash.ReadBuffer(part, baseAddress + basePosition);
+                for (auto& value : part)
+                {
+                    uint8_t difference;
+                    ReadInput(infra::MakeByteRange(difference));
+                    value += difference;
+                }
+
+                basePosition += part.size();
+                record.diffLength -= part.size();
+                buffer.pop_front(part.size());
+                produced += part.size();
+            }
+            else if (record.extraLength != 0)
+            {
+                auto part = infra::Head(buffer, record.extraLength);
+                ReadInput(part);
+
+                record.extraLength -= part.size();
+                buffer.pop_front(part.size());
+                produced += part.size();
+            }
+            else if (!ReadRecord())
+                failed = true;
+        }
+
+        if (failed)
+            std::fill(buffer.begin(), buffer.end(), 0xff);
+    }
+
+    void ImageUpgraderDelta::EraseSectors(uint32_t beginIndex, uint32_t endIndex)
+    {
+        std::abort();
+    }
+
+    bool ImageUpgraderDelta::ReadRecord()
+    {
+        // basePosition never exceeds baseSize, so that the bounds check when applying differences cannot overflow
+        auto seekedPosition = static_cast<int64_t>(basePosition) + record.seek;
+        if (seekedPosition < 0 || seekedPosition > header.baseSize)
+            return false;
+
+        basePosition = static_cast<uint32_t>(seekedPosition);
+
+        if (inputRemaining + inputAvailable.size() < sizeof(record))
+            return false;
+
+        ReadInput(infra::MakeByteRange(record));
+        return true;
+    }
+
+    void ImageUpgraderDelta::ReadInput(infra::ByteRange data)
+    {
+        while (!data.empty())
+        {
+            if (inputAvailable.empty())
+            {
+                if (inputRemaining == 0)
+                {
+                    failed = true;
+                    std::fill(data.begin(), data.end(), 0);
+                    return;
+                }
+
+                inputAvailable = infra::Head(infra::MakeRange(input), inputRemaining);
+                upgradePackFlash->ReadBuffer(inputAvailable, inputAddress);
+                ImageDecryptor().DecryptPart(inputAvailable);
+                inputAddress += inputAvailable.size();
+                inputRemaining -= inputAvailable.size();
+            }
+
+            auto part = infra::Head(inputAvailable, data.size());
+            infra::Copy(part, infra::Head(data, part.size()));
+            inputAvailable.pop_front(part.size());
+            data.pop_front(part.size());
+        }
+    }
+
+    ImageUpgraderDelta::SignedRegion::SignedRegion(hal::SynchronousFlash& flash, uint32_t address, uint32_t size, infra::ConstByteRange signature)
+        : flash(flash)
+        , address(address)
+        , size(size)
+        , signature(signature)
+    {}
+
+    bool ImageUpgraderDelta::SignedRegion::IsValid(const Verifier& verifier)
+    {
+        return verifier.IsValid(*this, hal::SynchronousFlash::Range(size, size + signature.size()), hal::SynchronousFlash::Range(0, size));
+    }
+
+    uint32_t ImageUpgraderDelta::SignedRegion::NumberOfSectors() const
+    {
+        return 1;
+    }
+
+    uint32_t ImageUpgraderDelta::SignedRegion::SizeOfSector(uint32_t sectorIndex) const
+    {
+        return size + signature.size();
+    }
+
+    uint32_t ImageUpgraderDelta::SignedRegion::SectorOfAddress(uint32_t address) const
+    {
+        return 0;
+    }
+
+    uint32_t ImageUpgraderDelta::SignedRegion::AddressOfSector(uint32_t sectorIndex) const
+    {
+        return 0;
+    }
+
+    void ImageUpgraderDelta::SignedRegion::WriteBuffer(infra::ConstByteRange buffer, uint32_t address)
+    {
+        std::abort();
+    }
+
+    void ImageUpgraderDelta::SignedRegion::ReadBuffer(infra::ByteRange buffer, uint32_t address)
+    {
+        if (address < size)
+        {
+            auto part = infra::Head(buffer, size - address);
+            flash.ReadBuffer(part, this->address + address);
+            buffer.pop_front(part.size());
+            address += part.size();
+        }
+
+        auto part = infra::Head(infra::DiscardHead(signature, address - size), buffer.size());
+        infra::Copy(part, infra::Head(buffer, part.size()));
+    }
+
+    void ImageUpgraderDelta::SignedRegion::EraseSectors(uint32_t beginIndex, uint32_t endIndex)
+    {
+        std::abort();
+    }
+}
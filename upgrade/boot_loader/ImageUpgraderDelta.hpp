@@ -0,0 +1,93 @@
+#ifndef UPGRADE_IMAGE_UPGRADER_DELTA_HPP
+#define UPGRADE_IMAGE_UPGRADER_DELTA_HPP
+
+#include "upgrade/boot_loader/ImageUpgrader.hpp"
+#include "upgrade/boot_loader/Verifier.hpp"
+#include "upgrade/pack/UpgradePackHeader.hpp"
+#include <array>
+
+namespace application
+{
+    // ImageUpgraderDelta decorates another ImageUpgrader for images that are produced by InputDelta: a patch against
+    // the currently installed image. Before anything is written, the installed image at baseAddress is checked against
+    // the base signature in the patch. While the decorated upgrader reads the image, the patch is decrypted and applied
+    // on the fly; afterwards the reconstructed image is read back from the decorated upgrader's destination and checked
+    // against the image signature. The decorated upgrader must be constructed with a DecryptorNone, it must read the
+    // image sequentially, and it must write the image into flash.
+    // RAM usage is bounded by the DeltaImageHeader and a small input buffer. Since the installed image is read while
+    // the new image is written, the destination must not overlap the installed image: write into a second bank or a
+    // scratch area from which the image is copied afterwards. Patching in place is not supported: a patch may seek to any
+    // part of the installed image, including parts that an in-place upgrade would already have overwritten.
+    class ImageUpgraderDelta
+        : public ImageUpgrader
+        , private hal::SynchronousFlash
+    {
+    public:
+        ImageUpgraderDelta(const char* targetName, Decryptor& decryptor, ImageUpgrader& upgrader, const Verifier& verifier,
+            hal::SynchronousFlash& baseFlash, uint32_t baseAddress);
+
+        uint32_t Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress) override;
+        uint32_t SectorsRewritten() const override;
+        hal::SynchronousFlash* DestinationFlash() override;
+        uint32_t DestinationAddress(uint32_t destinationAddress) const override;
+
+    private:
+        // Implementation of hal::SynchronousFlash, presenting the reconstructed image to the decorated upgrader
+        uint32_t NumberOfSectors() const override;
+        uint32_t SizeOfSector(uint32_t sectorIndex) const override;
+        uint32_t SectorOfAddress(uint32_t address) const override;
+        uint32_t AddressOfSector(uint32_t sectorIndex) const override;
+        void WriteBuffer(infra::ConstByteRange buffer, uint32_t address) override;
+        void ReadBuffer(infra::ByteRange buffer, uint32_t address) override;
+        void EraseSectors(uint32_t beginIndex, uint32_t endIndex) override;
+
+    private:
+        // Presents a flash region followed by a signature, so that the Verifier can check the region
+        class SignedRegion
+            : public hal::SynchronousFlash
+        {
+        public:
+            SignedRegion(hal::SynchronousFlash& flash, uint32_t address, uint32_t size, infra::ConstByteRange signature);
+
+            bool IsValid(const Verifier& verifier);
+
+            uint32_t NumberOfSectors() const override;
+            uint32_t SizeOfSector(uint32_t sectorIndex) const override;
+            uint32_t SectorOfAddress(uint32_t address) const override;
+            uint32_t AddressOfSector(uint32_t sectorIndex) const override;
+            void WriteBuffer(infra::ConstByteRange buffer, uint32_t address) override;
+            void ReadBuffer(infra::ByteRange buffer, uint32_t address) override;
+            void EraseSectors(uint32_t beginIndex, uint32_t endIndex) override;
+
+        private:
+            hal::SynchronousFlash& flash;
+            uint32_t address;
+            uint32_t size;
+            infra::ConstByteRange signature;
+        };
+
+    private:
+        bool ReadRecord();
+        void ReadInput(infra::ByteRange data);
+
+    private:
+        ImageUpgrader& upgrader;
+        const Verifier& verifier;
+        hal::SynchronousFlash& baseFlash;
+        uint32_t baseAddress;
+
+        DeltaImageHeader header;
+        hal::SynchronousFlash* upgradePackFlash = nullptr;
+        uint32_t inputAddress = 0;
+        uint32_t inputRemaining = 0;
+        std::array<uint8_t, 16> input;
+        infra::ByteRange inputAvailable;
+
+        uint32_t produced = 0;
+        uint32_t basePosition = 0;
+        DeltaRecord record;
+        bool failed = false;
+    };
+}
+
+#endif
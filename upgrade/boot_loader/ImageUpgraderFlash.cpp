@@ -2,37 +2,89 @@
 
 namespace application
 {
-    ImageUpgraderFlash::ImageUpgraderFlash(infra::ByteRange buffer, const char* targetName, Decryptor& decryptor, hal::SynchronousFlash& flash, uint32_t destinationAddressOffset)
+    ImageUpgraderFlash::ImageUpgraderFlash(infra::ByteRange buffer, const char* targetName, Decryptor& decryptor, hal::SynchronousFlash& flash, uint32_t destinationAddressOffset, const Config& config)
         : ImageUpgrader(targetName, decryptor)
         , buffer(buffer)
         , flash(&flash)
         , destinationAddressOffset(destinationAddressOffset)
+        , config(config)
     {}
 
     uint32_t ImageUpgraderFlash::Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress)
     {
         destinationAddress += destinationAddressOffset;
+        erasedUntil = destinationAddress;
+        statistics = Statistics();
 
-        flash->EraseSectors(flash->SectorOfAddress(destinationAddress), flash->SectorOfAddress(destinationAddress + imageSize - 1) + 1);
+        if (!config.eraseLazily && imageSize != 0)
+            EraseUpTo(destinationAddress + imageSize);
 
-        uint32_t imageAddressStart = imageAddress;
-        while (imageAddress - imageAddressStart < imageSize)
+        while (imageSize != 0)
         {
-            infra::ByteRange bufferRange(infra::Head(buffer, imageSize - (imageAddress - imageAddressStart)));
-            upgradePackFlash.ReadBuffer(bufferRange, imageAddress);
-            imageAddress += bufferRange.size();
+            infra::ByteRange bufferRange(infra::Head(buffer, imageSize));
 
+            auto start = Timestamp();
+            upgradePackFlash.ReadBuffer(bufferRange, imageAddress);
+            auto read = Timestamp();
             ImageDecryptor().DecryptPart(bufferRange);
+            statistics.readTicks += read - start;
+            statistics.decryptTicks += Timestamp() - read;
 
+            EraseUpTo(destinationAddress + bufferRange.size());
+
+            start = Timestamp();
             flash->WriteBuffer(bufferRange, destinationAddress);
+            statistics.writeTicks += Timestamp() - start;
+
+            imageAddress += bufferRange.size();
             destinationAddress += bufferRange.size();
+            imageSize -= bufferRange.size();
         }
 
         return 0;
     }
 
+    hal::SynchronousFlash* ImageUpgraderFlash::DestinationFlash()
+    {
+        return flash;
+    }
+
+    uint32_t ImageUpgraderFlash::DestinationAddress(uint32_t destinationAddress) const
+    {
+        return destinationAddress + destinationAddressOffset;
+    }
+
     void ImageUpgraderFlash::SetFlash(hal::SynchronousFlash& flash)
     {
         this->flash = &flash;
     }
+
+    const ImageUpgraderFlash::Statistics& ImageUpgraderFlash::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    void ImageUpgraderFlash::EraseUpTo(uint32_t end)
+    {
+        if (end <= erasedUntil)
+            return;
+
+        auto beginSector = flash->SectorOfAddress(erasedUntil);
+        auto endSector = flash->SectorOfAddress(end - 1) + 1;
+
+        auto start = Timestamp();
+        flash->EraseSectors(beginSector, endSector);
+        statistics.eraseTicks += Timestamp() - start;
+        statistics.sectorsErased += endSector - beginSector;
+
+        erasedUntil = endSector == flash->NumberOfSectors() ? flash->TotalSize() : flash->AddressOfSector(endSector);
+    }
+
+    uint32_t ImageUpgraderFlash::Timestamp() const
+    {
+        if (config.timestamp)
+            return config.timestamp();
+        else
+            return 0;
+    }
 }
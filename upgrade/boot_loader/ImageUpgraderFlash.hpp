@@ -1,11 +1,16 @@
 #ifndef UPGRADE_IMAGE_UPGRADER_FLASH_HPP
 #define UPGRADE_IMAGE_UPGRADER_FLASH_HPP
 
+#include "infra/util/Function.hpp"
 #include "infra/util/WithStorage.hpp"
 #include "upgrade/boot_loader/ImageUpgrader.hpp"
 
 namespace application
 {
+    // ImageUpgraderFlash copies an image from the upgrade pack into flash, one buffer at a time. By default, the complete
+    // destination range is erased up front; with eraseLazily, each destination sector is erased just before the first
+    // data is written into it. When a timestamp function is provided (for example a cycle counter), the time spent in
+    // each stage of the last upgrade is recorded in the statistics.
     class ImageUpgraderFlash
         : public ImageUpgrader
     {
@@ -13,16 +18,44 @@ namespace application
         template<std::size_t Size>
         using WithBlockSize = infra::WithStorage<ImageUpgraderFlash, std::array<uint8_t, Size>>;
 
-        ImageUpgraderFlash(infra::ByteRange buffer, const char* targetName, Decryptor& decryptor, hal::SynchronousFlash& flash, uint32_t destinationAddressOffset);
+        struct Config
+        {
+            Config() {}
+
+            bool eraseLazily = false;
+            infra::Function<uint32_t()> timestamp;
+        };
+
+        struct Statistics
+        {
+            uint32_t readTicks = 0;
+            uint32_t decryptTicks = 0;
+            uint32_t eraseTicks = 0;
+            uint32_t writeTicks = 0;
+            uint32_t sectorsErased = 0;
+        };
+
+        ImageUpgraderFlash(infra::ByteRange buffer, const char* targetName, Decryptor& decryptor, hal::SynchronousFlash& flash, uint32_t destinationAddressOffset, const Config& config = Config());
 
         uint32_t Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress) override;
+        hal::SynchronousFlash* DestinationFlash() override;
+        uint32_t DestinationAddress(uint32_t destinationAddress) const override;
 
         void SetFlash(hal::SynchronousFlash& flash);
+        const Statistics& GetStatistics() const;
+
+    private:
+        void EraseUpTo(uint32_t end);
+        uint32_t Timestamp() const;
 
     private:
         infra::ByteRange buffer;
         hal::SynchronousFlash* flash;
         uint32_t destinationAddressOffset;
+        Config config;
+
+        uint32_t erasedUntil = 0;
+        Statistics statistics;
     };
 }
 
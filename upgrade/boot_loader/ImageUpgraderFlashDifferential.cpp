@@ -0,0 +1,149 @@
+#include "upgrade/boot_loader/ImageUpgraderFlashDifferential.hpp"
+#include <algorithm>
+#include <array>
+
+namespace application
+{
+    ImageUpgraderFlashDifferential::ImageUpgraderFlashDifferential(infra::ByteRange buffer, const char* targetName, Decryptor& decryptor, hal::SynchronousFlash& flash, uint32_t destinationAddressOffset)
+        : ImageUpgrader(targetName, decryptor)
+        , buffer(buffer)
+        , flash(flash)
+        , destinationAddressOffset(destinationAddressOffset)
+    {}
+
+    uint32_t ImageUpgraderFlashDifferential::Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress)
+    {
+        destinationAddress += destinationAddressOffset;
+        statistics = Statistics();
+
+        while (imageSize != 0)
+        {
+            uint32_t size = std::min(imageSize, EndOfSector(destinationAddress) - destinationAddress);
+
+            if (size <= buffer.size())
+            {
+                infra::ByteRange bufferRange(infra::Head(buffer, size));
+                upgradePackFlash.ReadBuffer(bufferRange, imageAddress);
+                ImageDecryptor().DecryptPart(bufferRange);
+
+                if (Matches(bufferRange, destinationAddress))
+                    ++statistics.sectorsSkipped;
+                else
+                    RewriteSector(destinationAddress, bufferRange);
+            }
+            else if (ImageDecryptor().SavePosition(infra::MakeRange(decryptorPosition)))
+            {
+                if (SectorMatches(upgradePackFlash, imageAddress, size, destinationAddress))
+                    ++statistics.sectorsSkipped;
+                else
+                {
+                    ImageDecryptor().RestorePosition(infra::MakeRange(decryptorPosition));
+                    CopySector(upgradePackFlash, imageAddress, size, destinationAddress);
+                }
+            }
+            else
+                CopySector(upgradePackFlash, imageAddress, size, destinationAddress);
+
+            imageAddress += size;
+            destinationAddress += size;
+            imageSize -= size;
+        }
+
+        return 0;
+    }
+
+    uint32_t ImageUpgraderFlashDifferential::SectorsRewritten() const
+    {
+        return statistics.sectorsRewritten;
+    }
+
+    hal::SynchronousFlash* ImageUpgraderFlashDifferential::DestinationFlash()
+    {
+        return &flash;
+    }
+
+    uint32_t ImageUpgraderFlashDifferential::DestinationAddress(uint32_t destinationAddress) const
+    {
+        return destinationAddress + destinationAddressOffset;
+    }
+
+    const ImageUpgraderFlashDifferential::Statistics& ImageUpgraderFlashDifferential::GetStatistics() const
+    {
+        return statistics;
+    }
+
+    uint32_t ImageUpgraderFlashDifferential::EndOfSector(uint32_t address) const
+    {
+        auto sector = flash.SectorOfAddress(address) + 1;
+
+        if (sector == flash.NumberOfSectors())
+            return flash.TotalSize();
+        else
+            return flash.AddressOfSector(sector);
+    }
+
+    bool ImageUpgraderFlashDifferential::Matches(infra::ConstByteRange data, uint32_t address) const
+    {
+        std::array<uint8_t, 32> current;
+
+        while (!data.empty())
+        {
+            auto currentRange = infra::Head(infra::MakeRange(current), data.size());
+            flash.ReadBuffer(currentRange, address);
+
+            if (!std::equal(currentRange.begin(), currentRange.end(), data.begin()))
+                return false;
+
+            data.pop_front(currentRange.size());
+            address += currentRange.size();
+        }
+
+        return true;
+    }
+
+    bool ImageUpgraderFlashDifferential::SectorMatches(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t size, uint32_t destinationAddress)
+    {
+        while (size != 0)
+        {
+            infra::ByteRange bufferRange(infra::Head(buffer, size));
+            upgradePackFlash.ReadBuffer(bufferRange, imageAddress);
+            ImageDecryptor().DecryptPart(bufferRange);
+
+            if (!Matches(bufferRange, destinationAddress))
+                return false;
+
+            imageAddress += bufferRange.size();
+            destinationAddress += bufferRange.size();
+            size -= bufferRange.size();
+        }
+
+        return true;
+    }
+
+    void ImageUpgraderFlashDifferential::RewriteSector(uint32_t address, infra::ConstByteRange data)
+    {
+        auto sector = flash.SectorOfAddress(address);
+        flash.EraseSectors(sector, sector + 1);
+        flash.WriteBuffer(data, address);
+        ++statistics.sectorsRewritten;
+    }
+
+    void ImageUpgraderFlashDifferential::CopySector(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t size, uint32_t destinationAddress)
+    {
+        auto sector = flash.SectorOfAddress(destinationAddress);
+        flash.EraseSectors(sector, sector + 1);
+        ++statistics.sectorsRewritten;
+
+        while (size != 0)
+        {
+            infra::ByteRange bufferRange(infra::Head(buffer, size));
+            upgradePackFlash.ReadBuffer(bufferRange, imageAddress);
+            ImageDecryptor().DecryptPart(bufferRange);
+            flash.WriteBuffer(bufferRange, destinationAddress);
+
+            imageAddress += bufferRange.size();
+            destinationAddress += bufferRange.size();
+            size -= bufferRange.size();
+        }
+    }
+}
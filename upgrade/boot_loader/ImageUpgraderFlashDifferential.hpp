@@ -0,0 +1,54 @@
+#ifndef UPGRADE_IMAGE_UPGRADER_FLASH_DIFFERENTIAL_HPP
+#define UPGRADE_IMAGE_UPGRADER_FLASH_DIFFERENTIAL_HPP
+
+#include "infra/util/WithStorage.hpp"
+#include "upgrade/boot_loader/ImageUpgrader.hpp"
+
+namespace application
+{
+    // Like ImageUpgraderFlash, but the image is processed one destination sector at a time. The decrypted contents
+    // for a sector are compared against what is already in flash, and the sector is only erased and programmed when
+    // they differ. This saves erase cycles and time when an image is deployed that is mostly identical to the current one.
+    // When the image part of a sector does not fit in the buffer, it is compared one buffer at a time; when it differs,
+    // the decryptor is returned to the start of the sector so that the sector can be decrypted again while it is
+    // rewritten. With a decryptor that cannot save its position, such sectors are always rewritten.
+    class ImageUpgraderFlashDifferential
+        : public ImageUpgrader
+    {
+    public:
+        template<std::size_t Size>
+        using WithBlockSize = infra::WithStorage<ImageUpgraderFlashDifferential, std::array<uint8_t, Size>>;
+
+        struct Statistics
+        {
+            uint32_t sectorsRewritten = 0;
+            uint32_t sectorsSkipped = 0;
+        };
+
+        ImageUpgraderFlashDifferential(infra::ByteRange buffer, const char* targetName, Decryptor& decryptor, hal::SynchronousFlash& flash, uint32_t destinationAddressOffset);
+
+        uint32_t Upgrade(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t imageSize, uint32_t destinationAddress) override;
+        uint32_t SectorsRewritten() const override;
+        hal::SynchronousFlash* DestinationFlash() override;
+        uint32_t DestinationAddress(uint32_t destinationAddress) const override;
+
+        const Statistics& GetStatistics() const;
+
+    private:
+        uint32_t EndOfSector(uint32_t address) const;
+        bool Matches(infra::ConstByteRange data, uint32_t address) const;
+        bool SectorMatches(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t size, uint32_t destinationAddress);
+        void RewriteSector(uint32_t address, infra::ConstByteRange data);
+        void CopySector(hal::SynchronousFlash& upgradePackFlash, uint32_t imageAddress, uint32_t size, uint32_t destinationAddress);
+
+    private:
+        infra::ByteRange buffer;
+        hal::SynchronousFlash& flash;
+        uint32_t destinationAddressOffset;
+
+        std::array<uint8_t, Decryptor::maxPositionSize> decryptorPosition;
+        Statistics statistics;
+    };
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "upgrade/boot_loader/PackUpgrader.hpp"
+#include <cstddef>
 #include <cstring>
 
 namespace application
@@ -9,6 +10,8 @@ namespace application
 
     void PackUpgrader::UpgradeFromImages(infra::MemoryRange<ImageUpgrader*> imageUpgraders)
     {
+        sectorsRewritten = ImageUpgrader::sectorsRewrittenUnknown;
+
         UpgradePackHeaderPrologue headerPrologue;
         upgradePackFlash.ReadBuffer(infra::MakeByteRange(headerPrologue), address);
         address += sizeof(UpgradePackHeaderPrologue);
@@ -25,7 +28,7 @@ namespace application
         upgradePackFlash.ReadBuffer(infra::MakeByteRange(headerEpilogue), address);
         address += sizeof(UpgradePackHeaderEpilogue);
 
-        if (headerEpilogue.headerVersion != 1)
+        if (headerEpilogue.headerVersion != 2)
             MarkAsError(upgradeErrorCodeUnknownHeaderVersion);
         else
         {
@@ -92,6 +95,7 @@ namespace application
                     return false;
                 }
 
+                AddSectorsRewritten(imageUpgrader->SectorsRewritten());
                 return true;
             }
         }
@@ -117,6 +121,25 @@ namespace application
     void PackUpgrader::MarkAsDeployed()
     {
         WriteStatus(UpgradePackStatus::deployed);
+
+        if (sectorsRewritten != ImageUpgrader::sectorsRewrittenUnknown)
+            WriteSectorsRewritten(sectorsRewritten);
+    }
+
+    void PackUpgrader::AddSectorsRewritten(uint32_t sectors)
+    {
+        if (sectors == ImageUpgrader::sectorsRewrittenUnknown)
+            return;
+
+        if (sectorsRewritten == ImageUpgrader::sectorsRewrittenUnknown)
+            sectorsRewritten = 0;
+
+        sectorsRewritten += sectors;
+    }
+
+    uint32_t PackUpgrader::SectorsRewritten() const
+    {
+        return sectorsRewritten;
     }
 
     void PackUpgrader::MarkAsError(uint32_t errorCode)
@@ -134,4 +157,10 @@ namespace application
     {
         upgradePackFlash.WriteBuffer(infra::MakeByteRange(errorCode), 4);
     }
+
+    void PackUpgrader::WriteSectorsRewritten(uint32_t sectors)
+    {
+        upgradePackFlash.WriteBuffer(infra::MakeByteRange(sectors), offsetof(UpgradePackHeaderPrologue, sectorsRewritten));
+    }
+
 }
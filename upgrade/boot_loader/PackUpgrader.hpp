@@ -18,19 +18,27 @@ namespace application
 
         void MarkAsError(uint32_t errorCode);
 
+        // Total number of destination sectors rewritten by the image upgraders during the last UpgradeFromImages, or
+        // ImageUpgrader::sectorsRewrittenUnknown when none of them keeps track of this. When known, it is also stored
+        // in UpgradePackHeaderPrologue::sectorsRewritten once the pack is marked as deployed.
+        uint32_t SectorsRewritten() const;
+
     protected:
         virtual void WriteStatus(UpgradePackStatus status);
         virtual void WriteError(uint32_t errorCode);
+        virtual void WriteSectorsRewritten(uint32_t sectors);
 
     private:
         bool TryUpgradeImage(infra::MemoryRange<ImageUpgrader*> imageUpgraders);
         bool IsImage(uint32_t& imageAddress, const char* imageName) const;
         void MarkAsDeployStarted();
         void MarkAsDeployed();
+        void AddSectorsRewritten(uint32_t sectors);
 
     private:
         hal::SynchronousFlash& upgradePackFlash;
         uint32_t address = 0;
+        uint32_t sectorsRewritten = ImageUpgrader::sectorsRewrittenUnknown;
     };
 }
 
@@ -33,7 +33,7 @@ namespace application
         upgradePackFlash.ReadBuffer(infra::MakeByteRange(headerEpilogue), address);
         address += sizeof(UpgradePackHeaderEpilogue);
 
-        if (headerEpilogue.headerVersion != 1)
+        if (headerEpilogue.headerVersion != 2)
             MarkAsError(upgradeErrorCodeUnknownHeaderVersion);
         else if (std::strcmp(product, headerEpilogue.productName.data()) != 0)
             MarkAsError(upgradeErrorCodeUnknownProductName);
@@ -1,7 +1,6 @@
 #include "upgrade/boot_loader/VerifierEcDsa.hpp"
 #include "infra/util/ByteRange.hpp"
 #include "infra/util/MemoryRange.hpp"
-#include "mbedtls/sha256.h"
 #include "uECC.h"
 
 namespace application
@@ -10,6 +9,11 @@ namespace application
         : key(key)
     {}
 
+    VerifierEcDsa::VerifierEcDsa(infra::ConstByteRange key, Hasher& hasher, infra::ByteRange readBuffer)
+        : VerifierHashOnly(hasher, readBuffer)
+        , key(key)
+    {}
+
     bool VerifierEcDsa::IsValid(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& signature, const hal::SynchronousFlash::Range& data) const
     {
         std::array<uint8_t, 32> messageHash = Hash(flash, data);
@@ -32,6 +36,12 @@ namespace application
         assert(key.size() == signSize);
     }
 
+    VerifierEcDsa224::VerifierEcDsa224(infra::ConstByteRange key, Hasher& hasher, infra::ByteRange readBuffer)
+        : VerifierEcDsa(key, hasher, readBuffer)
+    {
+        assert(key.size() == signSize);
+    }
+
     infra::ByteRange VerifierEcDsa224::GetSignatureStorage(const hal::SynchronousFlash::Range& signature) const
     {
         if (signature.second - signature.first != signatureStorage.size())
@@ -51,6 +61,12 @@ namespace application
         assert(key.size() == signSize);
     }
 
+    VerifierEcDsa256::VerifierEcDsa256(infra::ConstByteRange key, Hasher& hasher, infra::ByteRange readBuffer)
+        : VerifierEcDsa(key, hasher, readBuffer)
+    {
+        assert(key.size() == signSize);
+    }
+
     infra::ByteRange VerifierEcDsa256::GetSignatureStorage(const hal::SynchronousFlash::Range& signature) const
     {
         if (signature.second - signature.first != signatureStorage.size())
@@ -12,6 +12,7 @@ namespace application
     {
     public:
         explicit VerifierEcDsa(infra::ConstByteRange key);
+        VerifierEcDsa(infra::ConstByteRange key, Hasher& hasher, infra::ByteRange readBuffer);
 
         bool IsValid(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& signature, const hal::SynchronousFlash::Range& data) const override;
 
@@ -28,6 +29,7 @@ namespace application
     {
     public:
         explicit VerifierEcDsa224(infra::ConstByteRange key);
+        VerifierEcDsa224(infra::ConstByteRange key, Hasher& hasher, infra::ByteRange readBuffer);
 
     protected:
         infra::ByteRange GetSignatureStorage(const hal::SynchronousFlash::Range& signature) const override;
@@ -43,6 +45,7 @@ namespace application
     {
     public:
         explicit VerifierEcDsa256(infra::ConstByteRange key);
+        VerifierEcDsa256(infra::ConstByteRange key, Hasher& hasher, infra::ByteRange readBuffer);
 
     protected:
         infra::ByteRange GetSignatureStorage(const hal::SynchronousFlash::Range& signature) const override;
@@ -1,8 +1,17 @@
 #include "upgrade/boot_loader/VerifierHashOnly.hpp"
-#include "mbedtls/sha256.h"
 
 namespace application
 {
+    VerifierHashOnly::VerifierHashOnly()
+        : softwareHasher(std::in_place)
+        , hasher(*softwareHasher)
+    {}
+
+    VerifierHashOnly::VerifierHashOnly(Hasher& hasher, infra::ByteRange readBuffer)
+        : hasher(hasher)
+        , readBuffer(readBuffer)
+    {}
+
     bool VerifierHashOnly::IsValid(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& signature, const hal::SynchronousFlash::Range& data) const
     {
         std::array<uint8_t, 32> messageHash = Hash(flash, data);
@@ -18,25 +27,10 @@ namespace application
 
     std::array<uint8_t, 32> VerifierHashOnly::Hash(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& data) const
     {
-        std::array<uint8_t, 32> hash;
-
-        mbedtls_sha256_context ctx;
-        mbedtls_sha256_init(&ctx);
-        mbedtls_sha256_starts(&ctx, 0);
-
-        auto message = data.first;
-        while (message != data.second)
-        {
-            std::array<uint8_t, 256> buffer;
-            auto size = std::min<std::size_t>(buffer.size(), data.second - message);
-            flash.ReadBuffer(infra::ByteRange(buffer.data(), buffer.data() + size), message);
-            mbedtls_sha256_update(&ctx, buffer.data(), size);
-            message += size;
-        }
-
-        mbedtls_sha256_finish(&ctx, hash.data());
-        mbedtls_sha256_free(&ctx);
-
-        return hash;
+        if (!readBuffer.empty())
+            return hasher.Calculate(flash, data, readBuffer);
+
+        std::array<uint8_t, 256> buffer;
+        return hasher.Calculate(flash, data, buffer);
     }
 }
@@ -1,7 +1,10 @@
 #ifndef UPGRADE_VERIFIER_HASH_ONLY_HPP
 #define UPGRADE_VERIFIER_HASH_ONLY_HPP
 
+#include "upgrade/boot_loader/Hasher.hpp"
+#include "upgrade/boot_loader/HasherSha256MbedTls.hpp"
 #include "upgrade/boot_loader/Verifier.hpp"
+#include <optional>
 
 namespace application
 {
@@ -9,10 +12,23 @@ namespace application
         : public Verifier
     {
     public:
+        // By default the hash is calculated in software, reading flash in small chunks on the stack.
+        // Provide a hasher, e.g. one backed by a hardware hash peripheral, and a large read buffer to speed up verification.
+        VerifierHashOnly();
+        VerifierHashOnly(Hasher& hasher, infra::ByteRange readBuffer);
+        // hasher may refer to softwareHasher, which a copy would not re-point
+        VerifierHashOnly(const VerifierHashOnly& other) = delete;
+        VerifierHashOnly& operator=(const VerifierHashOnly& other) = delete;
+
         bool IsValid(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& signature, const hal::SynchronousFlash::Range& data) const override;
 
     protected:
         std::array<uint8_t, 32> Hash(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& data) const;
+
+    private:
+        std::optional<HasherSha256MbedTls> softwareHasher;
+        Hasher& hasher;
+        infra::ByteRange readBuffer;
     };
 }
 
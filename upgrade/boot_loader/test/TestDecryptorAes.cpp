@@ -53,3 +53,32 @@ TEST_F(DecryptorAesTest, DecryptPartLarge)
                   0x40, 0x71, 0xb6, 0xef, 0x68, 0xfa, 0x22, 0x1a }),
         dataMbedTls);
 }
+
+TEST_F(DecryptorAesTest, DecryptPartAgainFromRestoredPosition)
+{
+    std::vector<uint8_t> start{ 1, 2, 3, 4 };
+    decryptorTiny.DecryptPart(start);
+    decryptorMbedTls.DecryptPart(start);
+
+    std::array<uint8_t, application::Decryptor::maxPositionSize> positionTiny;
+    std::array<uint8_t, application::Decryptor::maxPositionSize> positionMbedTls;
+    EXPECT_TRUE(decryptorTiny.SavePosition(positionTiny));
+    EXPECT_TRUE(decryptorMbedTls.SavePosition(positionMbedTls));
+
+    std::vector<uint8_t> firstTiny(20, 0);
+    std::vector<uint8_t> firstMbedTls(20, 0);
+    decryptorTiny.DecryptPart(firstTiny);
+    decryptorMbedTls.DecryptPart(firstMbedTls);
+
+    decryptorTiny.RestorePosition(positionTiny);
+    decryptorMbedTls.RestorePosition(positionMbedTls);
+
+    std::vector<uint8_t> secondTiny(20, 0);
+    std::vector<uint8_t> secondMbedTls(20, 0);
+    decryptorTiny.DecryptPart(secondTiny);
+    decryptorMbedTls.DecryptPart(secondMbedTls);
+
+    EXPECT_EQ(firstTiny, secondTiny);
+    EXPECT_EQ(firstMbedTls, secondMbedTls);
+    EXPECT_EQ(firstTiny, firstMbedTls);
+}
@@ -0,0 +1,74 @@
+#include "hal/synchronous_interfaces/test_doubles/SynchronousFlashStub.hpp"
+#include "upgrade/boot_loader/Hasher.hpp"
+#include "gmock/gmock.h"
+
+namespace
+{
+    class HasherStub
+        : public application::Hasher
+    {
+    public:
+        void Start() override
+        {
+            ++starts;
+            chunks.clear();
+        }
+
+        void Update(infra::ConstByteRange data) override
+        {
+            chunks.emplace_back(data.begin(), data.end());
+        }
+
+        std::array<uint8_t, 32> Finish() override
+        {
+            std::array<uint8_t, 32> hash{};
+            for (const auto& chunk : chunks)
+                for (auto byte : chunk)
+                    hash[0] += byte;
+
+            hash[1] = static_cast<uint8_t>(chunks.size());
+            return hash;
+        }
+
+        uint32_t starts = 0;
+        std::vector<std::vector<uint8_t>> chunks;
+    };
+}
+
+class HasherTest
+    : public testing::Test
+{
+public:
+    hal::SynchronousFlashStub flash{ 2, 8 };
+    HasherStub hasher;
+};
+
+TEST_F(HasherTest, data_is_hashed_in_chunks_of_the_buffer_size)
+{
+    flash.sectors = { { 1, 2, 3, 4, 5, 6, 7, 8 }, { 9, 10, 11, 12, 13, 14, 15, 16 } };
+
+    std::array<uint8_t, 4> buffer;
+    auto hash = hasher.Calculate(flash, { 1, 11 }, buffer);
+
+    EXPECT_EQ(1, hasher.starts);
+    EXPECT_EQ((std::vector<std::vector<uint8_t>>{ { 2, 3, 4, 5 }, { 6, 7, 8, 9 }, { 10, 11 } }), hasher.chunks);
+    EXPECT_EQ(65, hash[0]);
+    EXPECT_EQ(3, hash[1]);
+}
+
+TEST_F(HasherTest, large_buffer_hashes_all_data_in_one_update)
+{
+    std::array<uint8_t, 64> buffer;
+    hasher.Calculate(flash, { 0, 16 }, buffer);
+
+    EXPECT_EQ((std::vector<std::vector<uint8_t>>{ std::vector<uint8_t>(16, 0xff) }), hasher.chunks);
+}
+
+TEST_F(HasherTest, empty_range_is_hashed_without_updates)
+{
+    std::array<uint8_t, 4> buffer;
+    hasher.Calculate(flash, { 4, 4 }, buffer);
+
+    EXPECT_EQ(1, hasher.starts);
+    EXPECT_TRUE(hasher.chunks.empty());
+}
@@ -0,0 +1,99 @@
+#include "hal/synchronous_interfaces/test_doubles/SynchronousFlashStub.hpp"
+#include "upgrade/boot_loader/DecryptorNone.hpp"
+#include "upgrade/boot_loader/ImageUpgraderDecompressLz4.hpp"
+#include "upgrade/boot_loader/ImageUpgraderFlash.hpp"
+#include "upgrade/pack/UpgradePackHeader.hpp"
+#include "gmock/gmock.h"
+
+class ImageUpgraderDecompressLz4Test
+    : public testing::Test
+{
+public:
+    ImageUpgraderDecompressLz4Test()
+        : internalFlash(4, 4)
+        , upgradePackFlash(1, 64)
+    {}
+
+    uint32_t Upgrade(uint32_t uncompressedSize, uint32_t windowSize, const std::vector<uint8_t>& compressed, std::array<uint8_t, 4> magic = application::compressedImageMagicLz4)
+    {
+        application::CompressedImageHeader header{ magic, uncompressedSize, windowSize };
+        std::copy(reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header + 1), upgradePackFlash.sectors[0].begin());
+        std::copy(compressed.begin(), compressed.end(), upgradePackFlash.sectors[0].begin() + sizeof(header));
+
+        return upgrader.Upgrade(upgradePackFlash, 0, sizeof(header) + compressed.size(), 0);
+    }
+
+public:
+    application::DecryptorNone decryptor;
+    hal::SynchronousFlashStub internalFlash;
+    hal::SynchronousFlashStub upgradePackFlash;
+    application::ImageUpgraderFlash::WithBlockSize<3> flashUpgrader{ "", decryptor, internalFlash, 0 };
+    application::ImageUpgraderDecompressLz4::WithWindowSize<4> upgrader{ "upgrader", decryptor, flashUpgrader };
+};
+
+TEST_F(ImageUpgraderDecompressLz4Test, literals_are_copied)
+{
+    EXPECT_EQ(0, Upgrade(5, 4, { 0x50, 1, 2, 3, 4, 5 }));
+
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 4 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 5, 0xff, 0xff, 0xff }), internalFlash.sectors[1]);
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, match_repeats_earlier_output)
+{
+    EXPECT_EQ(0, Upgrade(12, 4, { 0x24, 1, 2, 2, 0, 0x20, 3, 4 }));
+
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 1, 2 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 1, 2 }), internalFlash.sectors[1]);
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 4 }), internalFlash.sectors[2]);
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, long_lengths_use_extra_bytes)
+{
+    std::vector<uint8_t> compressed{ 0xf0, 1 };
+    for (uint8_t i = 0; i != 16; ++i)
+        compressed.push_back(i);
+
+    EXPECT_EQ(0, Upgrade(16, 4, compressed));
+    EXPECT_EQ((std::vector<uint8_t>{ 12, 13, 14, 15 }), internalFlash.sectors[3]);
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, window_larger_than_available_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(1, 8, { 0x10, 1 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, offset_before_start_of_image_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(5, 4, { 0x10, 1, 2, 0, 0x00 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, truncated_image_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(5, 4, { 0x30, 1, 2, 3 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, missing_marker_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(5, 4, { 0x50, 1, 2, 3, 4, 5 }, { 'L', 'Z', '4', 0 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, input_ending_in_a_sequence_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(5, 4, { 0x20, 1, 2, 2 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, trailing_input_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(5, 4, { 0x50, 1, 2, 3, 4, 5, 0x10, 6 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, literals_beyond_uncompressed_size_fail)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(4, 4, { 0x50, 1, 2, 3, 4, 5 }));
+}
+
+TEST_F(ImageUpgraderDecompressLz4Test, match_beyond_uncompressed_size_fails)
+{
+    EXPECT_EQ(application::upgradeErrorCodeImageDecompressionFailed, Upgrade(8, 4, { 0x24, 1, 2, 2, 0 }));
+}
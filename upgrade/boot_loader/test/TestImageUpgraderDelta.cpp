@@ -0,0 +1,163 @@
+#include "hal/synchronous_interfaces/test_doubles/SynchronousFlashStub.hpp"
+#include "upgrade/boot_loader/DecryptorNone.hpp"
+#include "upgrade/boot_loader/ImageUpgraderDelta.hpp"
+#include "upgrade/boot_loader/ImageUpgraderFlash.hpp"
+#include "gmock/gmock.h"
+#include <numeric>
+
+namespace
+{
+    // The signature is a single byte holding the sum of the data
+    class VerifierSum
+        : public application::Verifier
+    {
+    public:
+        bool IsValid(hal::SynchronousFlash& flash, const hal::SynchronousFlash::Range& signature, const hal::SynchronousFlash::Range& data) const override
+        {
+            std::vector<uint8_t> contents(data.second - data.first);
+            flash.ReadBuffer(contents, data.first);
+            uint8_t storedSum = 0;
+            flash.ReadBuffer(infra::MakeByteRange(storedSum), signature.first);
+
+            return signature.second - signature.first == 1 && storedSum == std::accumulate(contents.begin(), contents.end(), uint8_t(0));
+        }
+    };
+
+    uint8_t Sum(const std::vector<uint8_t>& data)
+    {
+        return std::accumulate(data.begin(), data.end(), uint8_t(0));
+    }
+}
+
+class ImageUpgraderDeltaTest
+    : public testing::Test
+{
+public:
+    ImageUpgraderDeltaTest()
+        : baseFlash(1, 8)
+        , destinationFlash(2, 4)
+        , upgradePackFlash(1, 256)
+    {
+        baseFlash.sectors[0] = base;
+    }
+
+    uint32_t Upgrade(const std::vector<uint8_t>& image, const std::vector<uint8_t>& patch, uint8_t baseSum)
+    {
+        return Upgrade(upgrader, image, patch, baseSum);
+    }
+
+    uint32_t Upgrade(application::ImageUpgrader& upgrader, const std::vector<uint8_t>& image, std::vector<uint8_t> patch, uint8_t baseSum)
+    {
+        application::DeltaImageHeader header{};
+        header.imageSize = image.size();
+        header.baseSize = base.size();
+        header.signatureLength = 1;
+        header.baseSignature[0] = baseSum;
+        header.imageSignature[0] = Sum(image);
+
+        patch.insert(patch.begin(), reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header + 1));
+        std::copy(patch.begin(), patch.end(), upgradePackFlash.sectors[0].begin());
+
+        return upgrader.Upgrade(upgradePackFlash, 0, patch.size(), 0);
+    }
+
+    std::vector<uint8_t> Record(uint32_t diffLength, uint32_t extraLength, int32_t seek) const
+    {
+        application::DeltaRecord record{ diffLength, extraLength, seek };
+        return std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(&record), reinterpret_cast<const uint8_t*>(&record + 1));
+    }
+
+    std::vector<uint8_t> Concatenate(std::initializer_list<std::vector<uint8_t>> parts) const
+    {
+        std::vector<uint8_t> result;
+        for (auto& part : parts)
+            result.insert(result.end(), part.begin(), part.end());
+        return result;
+    }
+
+public:
+    const std::vector<uint8_t> base{ 1, 2, 3, 4, 5, 6, 7, 8 };
+    application::DecryptorNone decryptor;
+    VerifierSum verifier;
+    hal::SynchronousFlashStub baseFlash;
+    hal::SynchronousFlashStub destinationFlash;
+    hal::SynchronousFlashStub upgradePackFlash;
+    application::ImageUpgraderFlash::WithBlockSize<3> flashUpgrader{ "", decryptor, destinationFlash, 0 };
+    application::ImageUpgraderDelta upgrader{ "upgrader", decryptor, flashUpgrader, verifier, baseFlash, 0 };
+};
+
+TEST_F(ImageUpgraderDeltaTest, patch_is_applied_to_base)
+{
+    std::vector<uint8_t> image{ 1, 2, 3, 5, 9, 9, 7, 8 };
+    auto patch = Concatenate({ Record(4, 2, 2), { 0, 0, 0, 1, 9, 9 }, Record(2, 0, 0), { 0, 0 } });
+
+    EXPECT_EQ(0, Upgrade(image, patch, Sum(base)));
+
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 5 }), destinationFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 9, 9, 7, 8 }), destinationFlash.sectors[1]);
+}
+
+TEST_F(ImageUpgraderDeltaTest, different_base_is_rejected_before_writing)
+{
+    std::vector<uint8_t> image{ 1, 2, 3, 4 };
+    auto patch = Concatenate({ Record(4, 0, 0), { 0, 0, 0, 0 } });
+
+    EXPECT_EQ(application::upgradeErrorCodeDeltaBaseMismatch, Upgrade(image, patch, Sum(base) + 1));
+    EXPECT_EQ((std::vector<uint8_t>(4, 0xff)), destinationFlash.sectors[0]);
+}
+
+TEST_F(ImageUpgraderDeltaTest, reconstruction_is_checked_at_destination_of_decorated_upgrader)
+{
+    application::ImageUpgraderFlash::WithBlockSize<3> offsetFlashUpgrader{ "", decryptor, destinationFlash, 4 };
+    application::ImageUpgraderDelta offsetUpgrader{ "upgrader", decryptor, offsetFlashUpgrader, verifier, baseFlash, 0 };
+
+    std::vector<uint8_t> image{ 1, 2, 3, 5 };
+    auto patch = Concatenate({ Record(4, 0, 0), { 0, 0, 0, 1 } });
+
+    EXPECT_EQ(0, Upgrade(offsetUpgrader, image, patch, Sum(base)));
+
+    EXPECT_EQ((std::vector<uint8_t>(4, 0xff)), destinationFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 5 }), destinationFlash.sectors[1]);
+    EXPECT_EQ(&destinationFlash, offsetUpgrader.DestinationFlash());
+    EXPECT_EQ(4, offsetUpgrader.DestinationAddress(0));
+}
+
+TEST_F(ImageUpgraderDeltaTest, incorrect_reconstruction_is_rejected)
+{
+    std::vector<uint8_t> image{ 1, 2, 3, 4 };
+    auto patch = Concatenate({ Record(4, 0, 0), { 0, 0, 0, 1 } });
+
+    EXPECT_EQ(application::upgradeErrorCodeDeltaImageInvalid, Upgrade(image, patch, Sum(base)));
+}
+
+TEST_F(ImageUpgraderDeltaTest, truncated_patch_is_rejected)
+{
+    std::vector<uint8_t> image{ 1, 2, 3, 4 };
+    auto patch = Concatenate({ Record(4, 0, 0), { 0, 0 } });
+
+    EXPECT_EQ(application::upgradeErrorCodeDeltaImageInvalid, Upgrade(image, patch, Sum(base)));
+}
+
+TEST_F(ImageUpgraderDeltaTest, diff_beyond_base_is_rejected)
+{
+    std::vector<uint8_t> image{ 7, 8, 0, 0 };
+    auto patch = Concatenate({ Record(0, 0, 6), Record(4, 0, 0), { 0, 0, 0, 0 } });
+
+    EXPECT_EQ(application::upgradeErrorCodeDeltaImageInvalid, Upgrade(image, patch, Sum(base)));
+}
+
+TEST_F(ImageUpgraderDeltaTest, seek_before_start_of_base_is_rejected)
+{
+    std::vector<uint8_t> image{ 1, 2, 3, 4 };
+    auto patch = Concatenate({ Record(0, 0, -1), Record(4, 0, 0), { 0, 0, 0, 0 } });
+
+    EXPECT_EQ(application::upgradeErrorCodeDeltaImageInvalid, Upgrade(image, patch, Sum(base)));
+}
+
+TEST_F(ImageUpgraderDeltaTest, seek_beyond_end_of_base_is_rejected)
+{
+    std::vector<uint8_t> image{ 1, 2, 3, 4 };
+    auto patch = Concatenate({ Record(0, 0, 9), Record(0, 4, 0), { 1, 2, 3, 4 } });
+
+    EXPECT_EQ(application::upgradeErrorCodeDeltaImageInvalid, Upgrade(image, patch, Sum(base)));
+}
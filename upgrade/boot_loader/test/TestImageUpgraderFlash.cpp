@@ -79,3 +79,95 @@ TEST_F(ImageUpgraderFlashTest, SectorsAreFirstErased)
 
     EXPECT_EQ((std::vector<uint8_t>{ 1, 2, 3, 4 }), internalFlash.sectors[0]);
 }
+
+class ImageUpgraderFlashOverSectorsTest
+    : public testing::Test
+{
+public:
+    ImageUpgraderFlashOverSectorsTest()
+        : internalFlash(4, 4)
+        , upgradePackFlash(1, 16)
+    {
+        for (uint8_t i = 0; i != 16; ++i)
+            upgradePackFlash.sectors[0][i] = i;
+
+        for (auto& sector : internalFlash.sectors)
+            std::fill(sector.begin(), sector.end(), 0);
+
+        lazyErase.eraseLazily = true;
+    }
+
+public:
+    application::DecryptorNone decryptor;
+    hal::SynchronousFlashStub internalFlash;
+    hal::SynchronousFlashStub upgradePackFlash;
+    application::ImageUpgraderFlash::Config lazyErase;
+};
+
+TEST_F(ImageUpgraderFlashOverSectorsTest, UpgradeCopiesFlashOverMultipleSectors)
+{
+    application::ImageUpgraderFlash::WithBlockSize<3> upgrader("upgrader", decryptor, internalFlash, 0);
+    upgrader.Upgrade(upgradePackFlash, 2, 9, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 2, 3, 4, 5 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 6, 7, 8, 9 }), internalFlash.sectors[1]);
+    EXPECT_EQ((std::vector<uint8_t>{ 10, 0xff, 0xff, 0xff }), internalFlash.sectors[2]);
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 0, 0, 0 }), internalFlash.sectors[3]);
+    EXPECT_EQ(3, upgrader.GetStatistics().sectorsErased);
+}
+
+TEST_F(ImageUpgraderFlashOverSectorsTest, LazyEraseCopiesFlashOverMultipleSectors)
+{
+    application::ImageUpgraderFlash::WithBlockSize<3> upgrader("upgrader", decryptor, internalFlash, 0, lazyErase);
+    upgrader.Upgrade(upgradePackFlash, 2, 9, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 2, 3, 4, 5 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 6, 7, 8, 9 }), internalFlash.sectors[1]);
+    EXPECT_EQ((std::vector<uint8_t>{ 10, 0xff, 0xff, 0xff }), internalFlash.sectors[2]);
+    EXPECT_EQ(3, upgrader.GetStatistics().sectorsErased);
+}
+
+TEST_F(ImageUpgraderFlashOverSectorsTest, LazyEraseDoesNotEraseSectorsOutsideOfImage)
+{
+    application::ImageUpgraderFlash::WithBlockSize<16> upgrader("upgrader", decryptor, internalFlash, 0, lazyErase);
+    upgrader.Upgrade(upgradePackFlash, 0, 2, 6);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 0, 0, 0 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 0xff, 0xff, 0, 1 }), internalFlash.sectors[1]);
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 0, 0, 0 }), internalFlash.sectors[2]);
+    EXPECT_EQ(1, upgrader.GetStatistics().sectorsErased);
+}
+
+TEST_F(ImageUpgraderFlashOverSectorsTest, LazyEraseUsesDestinationAddressOffset)
+{
+    application::ImageUpgraderFlash::WithBlockSize<16> upgrader("upgrader", decryptor, internalFlash, 4, lazyErase);
+    upgrader.Upgrade(upgradePackFlash, 0, 4, 8);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3 }), internalFlash.sectors[3]);
+}
+
+TEST_F(ImageUpgraderFlashOverSectorsTest, LazyEraseUpToEndOfFlash)
+{
+    application::ImageUpgraderFlash::WithBlockSize<4> upgrader("upgrader", decryptor, internalFlash, 0, lazyErase);
+    upgrader.Upgrade(upgradePackFlash, 0, 16, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 12, 13, 14, 15 }), internalFlash.sectors[3]);
+    EXPECT_EQ(4, upgrader.GetStatistics().sectorsErased);
+}
+
+TEST_F(ImageUpgraderFlashOverSectorsTest, StagesAreTimed)
+{
+    uint32_t ticks = 0;
+    lazyErase.timestamp = [&ticks]()
+    {
+        return ticks++;
+    };
+
+    application::ImageUpgraderFlash::WithBlockSize<8> upgrader("upgrader", decryptor, internalFlash, 0, lazyErase);
+    upgrader.Upgrade(upgradePackFlash, 0, 16, 0);
+
+    EXPECT_EQ(2, upgrader.GetStatistics().readTicks);
+    EXPECT_EQ(2, upgrader.GetStatistics().decryptTicks);
+    EXPECT_EQ(2, upgrader.GetStatistics().eraseTicks);
+    EXPECT_EQ(2, upgrader.GetStatistics().writeTicks);
+}
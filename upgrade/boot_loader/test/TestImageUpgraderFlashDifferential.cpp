@@ -0,0 +1,167 @@
+#include "hal/synchronous_interfaces/test_doubles/SynchronousFlashStub.hpp"
+#include "upgrade/boot_loader/DecryptorNone.hpp"
+#include "upgrade/boot_loader/ImageUpgraderFlashDifferential.hpp"
+#include "gmock/gmock.h"
+
+namespace
+{
+    // Adds a repeating key stream to the data, so that decrypting the same data twice without restoring the position
+    // gives a different result
+    class CountingDecryptor
+        : public application::Decryptor
+    {
+    public:
+        explicit CountingDecryptor(infra::ConstByteRange keyStream)
+            : keyStream(keyStream)
+        {}
+
+        infra::ByteRange StateBuffer() override
+        {
+            return infra::ByteRange();
+        }
+
+        void Reset() override
+        {
+            offset = 0;
+        }
+
+        void DecryptPart(infra::ByteRange data) override
+        {
+            for (auto& byte : data)
+                byte += keyStream[offset++ % keyStream.size()];
+        }
+
+        bool DecryptAndAuthenticate(infra::ByteRange data) override
+        {
+            DecryptPart(data);
+            return true;
+        }
+
+        bool SavePosition(infra::ByteRange position) const override
+        {
+            if (!savesPosition)
+                return false;
+
+            position.front() = static_cast<uint8_t>(offset);
+            return true;
+        }
+
+        void RestorePosition(infra::ConstByteRange position) override
+        {
+            offset = position.front();
+        }
+
+        bool savesPosition = true;
+
+    private:
+        infra::ConstByteRange keyStream;
+        std::size_t offset = 0;
+    };
+}
+
+class ImageUpgraderFlashDifferentialTest
+    : public testing::Test
+{
+public:
+    ImageUpgraderFlashDifferentialTest()
+        : internalFlash(4, 4)
+        , upgradePackFlash(1, 16)
+    {
+        for (uint8_t i = 0; i != 16; ++i)
+            upgradePackFlash.sectors[0][i] = i;
+
+        for (auto& sector : internalFlash.sectors)
+            std::fill(sector.begin(), sector.end(), 0);
+    }
+
+public:
+    application::DecryptorNone decryptor;
+    hal::SynchronousFlashStub internalFlash;
+    hal::SynchronousFlashStub upgradePackFlash;
+};
+
+TEST_F(ImageUpgraderFlashDifferentialTest, UpgradeCopiesFlashOverMultipleSectors)
+{
+    application::ImageUpgraderFlashDifferential::WithBlockSize<4> upgrader("upgrader", decryptor, internalFlash, 0);
+    upgrader.Upgrade(upgradePackFlash, 2, 9, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 2, 3, 4, 5 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 6, 7, 8, 9 }), internalFlash.sectors[1]);
+    EXPECT_EQ((std::vector<uint8_t>{ 10, 0xff, 0xff, 0xff }), internalFlash.sectors[2]);
+    EXPECT_EQ(3, upgrader.SectorsRewritten());
+}
+
+TEST_F(ImageUpgraderFlashDifferentialTest, MatchingSectorsAreNotRewritten)
+{
+    internalFlash.sectors[1] = { 4, 5, 6, 7 };
+    internalFlash.sectors[3] = { 12, 13, 14, 15 };
+
+    application::ImageUpgraderFlashDifferential::WithBlockSize<4> upgrader("upgrader", decryptor, internalFlash, 0);
+    upgrader.Upgrade(upgradePackFlash, 0, 16, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3 }), internalFlash.sectors[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 8, 9, 10, 11 }), internalFlash.sectors[2]);
+    EXPECT_EQ(2, upgrader.GetStatistics().sectorsRewritten);
+    EXPECT_EQ(2, upgrader.GetStatistics().sectorsSkipped);
+}
+
+TEST_F(ImageUpgraderFlashDifferentialTest, PartialSectorIsComparedOnlyOverImage)
+{
+    internalFlash.sectors[1] = { 0x55, 0x55, 0, 1 };
+
+    application::ImageUpgraderFlashDifferential::WithBlockSize<4> upgrader("upgrader", decryptor, internalFlash, 0);
+    upgrader.Upgrade(upgradePackFlash, 0, 2, 6);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0x55, 0x55, 0, 1 }), internalFlash.sectors[1]);
+    EXPECT_EQ(0, upgrader.SectorsRewritten());
+}
+
+TEST_F(ImageUpgraderFlashDifferentialTest, SectorLargerThanBufferIsComparedInParts)
+{
+    internalFlash.sectors[1] = { 0, 1, 2, 3 };
+
+    application::ImageUpgraderFlashDifferential::WithBlockSize<3> upgrader("upgrader", decryptor, internalFlash, 4);
+    upgrader.Upgrade(upgradePackFlash, 0, 4, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3 }), internalFlash.sectors[1]);
+    EXPECT_EQ(0, upgrader.GetStatistics().sectorsRewritten);
+    EXPECT_EQ(1, upgrader.GetStatistics().sectorsSkipped);
+}
+
+TEST_F(ImageUpgraderFlashDifferentialTest, SectorLargerThanBufferIsRewrittenWhenLastPartDiffers)
+{
+    internalFlash.sectors[1] = { 0, 1, 2, 0x55 };
+
+    application::ImageUpgraderFlashDifferential::WithBlockSize<3> upgrader("upgrader", decryptor, internalFlash, 4);
+    upgrader.Upgrade(upgradePackFlash, 0, 4, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3 }), internalFlash.sectors[1]);
+    EXPECT_EQ(1, upgrader.SectorsRewritten());
+}
+
+TEST_F(ImageUpgraderFlashDifferentialTest, SectorLargerThanBufferIsDecryptedAgainWhenRewritten)
+{
+    const std::array<uint8_t, 4> keyStream{ 0x10, 0x20, 0x30, 0x40 };
+    CountingDecryptor countingDecryptor(keyStream);
+    internalFlash.sectors[1] = { 0x10, 0x21, 0x55, 0x55 };
+
+    application::ImageUpgraderFlashDifferential::WithBlockSize<3> upgrader("upgrader", countingDecryptor, internalFlash, 4);
+    upgrader.Upgrade(upgradePackFlash, 0, 4, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0x10, 0x21, 0x32, 0x43 }), internalFlash.sectors[1]);
+    EXPECT_EQ(1, upgrader.SectorsRewritten());
+}
+
+TEST_F(ImageUpgraderFlashDifferentialTest, SectorLargerThanBufferIsAlwaysRewrittenWhenDecryptorCannotSavePosition)
+{
+    const std::array<uint8_t, 4> keyStream{ 0, 0, 0, 0 };
+    CountingDecryptor countingDecryptor(keyStream);
+    countingDecryptor.savesPosition = false;
+    internalFlash.sectors[1] = { 0, 1, 2, 3 };
+
+    application::ImageUpgraderFlashDifferential::WithBlockSize<3> upgrader("upgrader", countingDecryptor, internalFlash, 4);
+    upgrader.Upgrade(upgradePackFlash, 0, 4, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 0, 1, 2, 3 }), internalFlash.sectors[1]);
+    EXPECT_EQ(1, upgrader.SectorsRewritten());
+}
@@ -18,9 +18,15 @@ public:
         return UpgradeMock(imageAddress, imageSize, destinationAddress);
     }
 
+    uint32_t SectorsRewritten() const override
+    {
+        return sectorsRewritten;
+    }
+
     MOCK_METHOD3(UpgradeMock, uint32_t(uint32_t, uint32_t, uint32_t));
 
     application::DecryptorNone decryptorNone;
+    uint32_t sectorsRewritten = sectorsRewrittenUnknown;
 };
 
 class PackUpgraderTest
@@ -50,8 +56,9 @@ public:
         header.prologue.status = application::UpgradePackStatus::readyToDeploy;
         header.prologue.magic = application::upgradePackMagic;
         header.prologue.errorCode = 0xffffffff;
+        header.prologue.sectorsRewritten = 0xffffffff;
         header.prologue.signedContentsLength = sizeof(application::UpgradePackHeaderEpilogue);
-        header.epilogue.headerVersion = 1;
+        header.epilogue.headerVersion = 2;
         header.epilogue.numberOfImages = numberOfImages;
 
         return header;
@@ -96,7 +103,7 @@ TEST_F(PackUpgraderTest, ImageInvokesImageUpgrader)
     infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
     stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
 
-    EXPECT_CALL(imageUpgraderMock, UpgradeMock(244, 2, 1)).WillOnce(testing::Return(0));
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Return(0));
     application::PackUpgrader packUpgrader(upgradePackFlash);
     packUpgrader.UpgradeFromImages(singleUpgraderMock);
 }
@@ -112,7 +119,7 @@ TEST_F(PackUpgraderTest, PackIsMarkedAsDeployed)
     infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
     stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
 
-    EXPECT_CALL(imageUpgraderMock, UpgradeMock(244, 2, 1)).WillOnce(testing::Return(0));
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Return(0));
     application::PackUpgrader packUpgrader(upgradePackFlash);
     packUpgrader.UpgradeFromImages(singleUpgraderMock);
 
@@ -130,7 +137,7 @@ TEST_F(PackUpgraderTest, when_upgrade_starts_pack_is_marked_as_deployStarted)
     infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
     stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
 
-    EXPECT_CALL(imageUpgraderMock, UpgradeMock(244, 2, 1)).WillOnce(testing::Throw<int>(0));
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Throw<int>(0));
     application::PackUpgrader packUpgrader(upgradePackFlash);
     EXPECT_THROW(packUpgrader.UpgradeFromImages(singleUpgraderMock), int);
 
@@ -149,7 +156,7 @@ TEST_F(PackUpgraderTest, pack_that_was_already_started_will_be_retried)
     infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
     stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
 
-    EXPECT_CALL(imageUpgraderMock, UpgradeMock(244, 2, 1)).WillOnce(testing::Return(0));
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Return(0));
     application::PackUpgrader packUpgrader(upgradePackFlash);
     packUpgrader.UpgradeFromImages(singleUpgraderMock);
 
@@ -159,7 +166,7 @@ TEST_F(PackUpgraderTest, pack_that_was_already_started_will_be_retried)
 TEST_F(PackUpgraderTest, WhenVersionIsIncorrectPackIsMarkedAsError)
 {
     UpgradePackHeaderNoSecurity header(CreateReadyToDeployHeader(1));
-    header.epilogue.headerVersion = 2;
+    header.epilogue.headerVersion = 3;
 
     const std::vector<uint8_t> image{ 1, 5 };
     application::ImageHeaderPrologue imageHeaderPrologue(CreateImageHeaderPrologue("upgrader", image.size()));
@@ -210,7 +217,7 @@ TEST_F(PackUpgraderTest, WhenUpgraderCannotUpgradePackIsMarkedAsError)
     infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
     stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
 
-    EXPECT_CALL(imageUpgraderMock, UpgradeMock(244, 2, 1)).WillOnce(testing::Return(application::upgradeErrorCodeImageUpgradeFailed));
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Return(application::upgradeErrorCodeImageUpgradeFailed));
     application::PackUpgrader packUpgrader(upgradePackFlash);
     packUpgrader.UpgradeFromImages(singleUpgraderMock);
 
@@ -253,3 +260,46 @@ TEST_F(PackUpgraderTest, HasImage_finds_second_image)
     application::PackUpgrader packUpgrader(upgradePackFlash);
     EXPECT_TRUE(packUpgrader.HasImage("2image"));
 }
+
+TEST_F(PackUpgraderTest, SectorsRewrittenIsReportedWhenDeployed)
+{
+    UpgradePackHeaderNoSecurity header(CreateReadyToDeployHeader(1));
+
+    const std::vector<uint8_t> image{ 1, 5 };
+    application::ImageHeaderPrologue imageHeaderPrologue(CreateImageHeaderPrologue("upgrader", image.size()));
+    application::ImageHeaderEpilogue imageHeaderEpilogue = CreateImageHeaderEpilogue();
+
+    infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
+    stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
+
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Return(0));
+    imageUpgraderMock.sectorsRewritten = 3;
+    application::PackUpgrader packUpgrader(upgradePackFlash);
+    packUpgrader.UpgradeFromImages(singleUpgraderMock);
+
+    application::UpgradePackHeaderPrologue& prologue = reinterpret_cast<application::UpgradePackHeaderPrologue&>(upgradePackFlash.sectors[0][0]);
+    EXPECT_EQ(application::UpgradePackStatus::deployed, prologue.status);
+    EXPECT_EQ(header.prologue.errorCode, prologue.errorCode);
+    EXPECT_EQ(3, prologue.sectorsRewritten);
+    EXPECT_EQ(3, packUpgrader.SectorsRewritten());
+}
+
+TEST_F(PackUpgraderTest, SectorsRewrittenIsUnknownWhenImageUpgraderDoesNotReportIt)
+{
+    UpgradePackHeaderNoSecurity header(CreateReadyToDeployHeader(1));
+
+    const std::vector<uint8_t> image{ 1, 5 };
+    application::ImageHeaderPrologue imageHeaderPrologue(CreateImageHeaderPrologue("upgrader", image.size()));
+    application::ImageHeaderEpilogue imageHeaderEpilogue = CreateImageHeaderEpilogue();
+
+    infra::ByteOutputStream stream(upgradePackFlash.sectors[0]);
+    stream << header << imageHeaderPrologue << imageHeaderEpilogue << infra::ConstByteRange(image);
+
+    EXPECT_CALL(imageUpgraderMock, UpgradeMock(248, 2, 1)).WillOnce(testing::Return(0));
+    application::PackUpgrader packUpgrader(upgradePackFlash);
+    packUpgrader.UpgradeFromImages(singleUpgraderMock);
+
+    application::UpgradePackHeaderPrologue& prologue = reinterpret_cast<application::UpgradePackHeaderPrologue&>(upgradePackFlash.sectors[0][0]);
+    EXPECT_EQ(0xffffffff, prologue.sectorsRewritten);
+    EXPECT_EQ(application::ImageUpgrader::sectorsRewrittenUnknown, packUpgrader.SectorsRewritten());
+}
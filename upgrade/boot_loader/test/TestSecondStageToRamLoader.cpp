@@ -125,9 +125,10 @@ public:
         header.prologue.status = application::UpgradePackStatus::readyToDeploy;
         header.prologue.magic = application::upgradePackMagic;
         header.prologue.errorCode = 0xffffffff;
+        header.prologue.sectorsRewritten = 0xffffffff;
         header.prologue.signedContentsLength = sizeof(application::UpgradePackHeaderEpilogue);
         std::strncpy(header.epilogue.productName.data(), "test product", header.epilogue.productName.max_size());
-        header.epilogue.headerVersion = 1;
+        header.epilogue.headerVersion = 2;
         header.epilogue.numberOfImages = numberOfImages;
 
         return header;
@@ -230,7 +231,7 @@ TEST_F(SecondStageToRamLoaderTest, dont_load_second_stage_when_not_ready_to_depl
 TEST_F(SecondStageToRamLoaderTest, WhenHeaderVersionIncorrectSecondStageDoesNotLoad)
 {
     UpgradePackHeaderNoSecurity header(CreateReadyToDeployHeader(1));
-    header.epilogue.headerVersion = 2;
+    header.epilogue.headerVersion = 3;
 
     const std::vector<uint8_t> secondStageImage{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 3, 5, 8, 13, 21 };
     application::ImageHeaderPrologue secondStageImageHeader(CreateImageHeader("boot2nd", secondStageImage.size()));
@@ -38,3 +38,21 @@ TEST(VerifierHashOnlyTest, correct_hash_as_signature_is_valid)
     application::VerifierHashOnly verifier;
     EXPECT_EQ(true, verifier.IsValid(flash, { 4, 36 }, { 0, 4 }));
 }
+
+TEST(VerifierHashOnlyTest, correct_hash_is_valid_with_injected_hasher_and_read_buffer)
+{
+    hal::SynchronousFlashStub flash(1, 64);
+
+    flash.sectors = {
+        { 0, 1, 2, 3,
+            0x05, 0x4E, 0xDE, 0xC1, 0xD0, 0x21, 0x1F, 0x62,
+            0x4F, 0xED, 0x0C, 0xBC, 0xA9, 0xD4, 0xF9, 0x40,
+            0x0B, 0x0E, 0x49, 0x1C, 0x43, 0x74, 0x2A, 0xF2,
+            0xC5, 0xB0, 0xAB, 0xEB, 0xF0, 0xC9, 0x90, 0xD8 }
+    };
+
+    application::HasherSha256MbedTls hasher;
+    std::array<uint8_t, 3> readBuffer;
+    application::VerifierHashOnly verifier(hasher, readBuffer);
+    EXPECT_EQ(true, verifier.IsValid(flash, { 4, 36 }, { 0, 4 }));
+}
@@ -31,6 +31,9 @@ namespace application
     static const uint32_t upgradeErrorCodeImageUpgradeFailed = 5;
     static const uint32_t upgradeErrorCodeInvalidStartAddressOrStackPointer = 6;
     static const uint32_t upgradeErrorCodeExternalImageUpgradeFailed = 7;
+    static const uint32_t upgradeErrorCodeImageDecompressionFailed = 8;
+    static const uint32_t upgradeErrorCodeDeltaBaseMismatch = 9;
+    static const uint32_t upgradeErrorCodeDeltaImageInvalid = 10;
 
     struct UpgradePackHeaderPrologue
     {
@@ -42,13 +45,15 @@ namespace application
 
         uint16_t signatureMethod; // Identifier that indicates the signature method chosen. 1 = ECDSA-224, 2 = ECDSA-256.
         uint16_t signatureLength; // Size of the signature. 56 for ECDSA-224, 64 for ECDSA-256.
+        uint32_t sectorsRewritten; // Set by the boot loaders together with the deployed status: the number of destination sectors
+                                   // erased and programmed. Left at 0xffffffff when the image upgraders do not keep track of this.
     };
 
-    static_assert(sizeof(UpgradePackHeaderPrologue) == 16, "Incorrect size");
+    static_assert(sizeof(UpgradePackHeaderPrologue) == 20, "Incorrect size");
 
     struct UpgradePackHeaderEpilogue
     {
-        uint16_t headerVersion; // Indicates the structure of the UpgradePackHeaders and ImageHeaderPrologue
+        uint16_t headerVersion; // Indicates the structure of the UpgradePackHeaders and ImageHeaderPrologue. Version 2 added sectorsRewritten.
         uint16_t headerLength;  // sizeof(UpgradePackHeaderPrologue) + signatureLength + sizeof(UpgradePackHeaderEpilogue)
         uint32_t numberOfImages;
         std::array<char, 64> productName;    // Product-specific name, checked by bootloader in order to avoid
@@ -76,6 +81,44 @@ namespace application
         uint32_t destinationAddress; // Address at which to flash the binary image
         uint32_t imageSize;          // Length of the binary image
     };
+
+    static const std::array<uint8_t, 4> compressedImageMagicLz4 = { 'L', 'Z', '4', 'B' };
+
+    // When an image is compressed, the binary image starts with this header, followed by LZ4 block sequences.
+    // ImageHeaderEpilogue::imageSize then holds the compressed length including this header.
+    struct CompressedImageHeader
+    {
+        std::array<uint8_t, 4> magic; // Marks the image as compressed. Filled with 'L', 'Z', '4', 'B'.
+        uint32_t uncompressedSize;    // Length of the image after decompression
+        uint32_t windowSize;          // Largest distance of a match, the decompressor needs a window at least this large
+    };
+
+    static_assert(sizeof(CompressedImageHeader) == 12, "Incorrect size");
+
+    // When an image is a delta against the currently installed image, the binary image starts with this header,
+    // followed by patch records. ImageHeaderEpilogue::imageSize then holds the length of the header and records.
+    struct DeltaImageHeader
+    {
+        uint32_t imageSize;                     // Length of the reconstructed image
+        uint32_t baseSize;                      // Length of the installed image the patch is made against
+        uint16_t signatureMethod;               // Same identifiers as UpgradePackHeaderPrologue::signatureMethod
+        uint16_t signatureLength;               // Number of bytes used of each signature below
+        std::array<uint8_t, 64> baseSignature;  // Signature over the installed image
+        std::array<uint8_t, 64> imageSignature; // Signature over the reconstructed image
+    };
+
+    static_assert(sizeof(DeltaImageHeader) == 140, "Incorrect size");
+
+    // Each record adds diffLength patch bytes to the base image at the current base position, then appends
+    // extraLength patch bytes as they are, and finally moves the base position by seek.
+    struct DeltaRecord
+    {
+        uint32_t diffLength;
+        uint32_t extraLength;
+        int32_t seek;
+    };
+
+    static_assert(sizeof(DeltaRecord) == 12, "Incorrect size");
 }
 
 #endif
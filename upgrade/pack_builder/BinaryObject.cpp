@@ -1,6 +1,6 @@
 #include "upgrade/pack_builder/BinaryObject.hpp"
-#include "infra/stream/StdStringInputStream.hpp"
 #include <algorithm>
+#include <cassert>
 
 namespace
 {
@@ -11,6 +11,22 @@ namespace
                 return std::isspace(c);
             });
     }
+
+    int HexDigit(const std::string& line, std::size_t index)
+    {
+        if (index >= line.size())
+            return -1;
+
+        auto c = line[index];
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+
+        return -1;
+    }
 }
 
 namespace application
@@ -85,21 +101,14 @@ namespace application
                 }
             }
 
-            for (auto byte : programData)
-            {
-                memory.Insert(byte, offset);
-                ++offset;
-            }
+            memory.Insert(programData, offset);
+            offset += programData.size();
         }
     }
 
     void BinaryObject::AddBinary(const std::vector<uint8_t>& data, uint32_t offset, const std::string& fileName)
     {
-        for (auto byte : data)
-        {
-            memory.Insert(byte, offset);
-            ++offset;
-        }
+        memory.Insert(data, offset);
     }
 
     const SparseVector<uint8_t>& BinaryObject::Memory() const
@@ -155,42 +164,42 @@ namespace application
 
     void BinaryObject::InsertLineContents(const LineContents& lineContents)
     {
-        for (std::size_t i = 0; i != lineContents.data.size(); ++i)
-            memory.Insert(lineContents.data[i], linearAddress + offset + lineContents.address + i);
+        memory.Insert(lineContents.data, linearAddress + offset + lineContents.address);
     }
 
     BinaryObject::LineContents::LineContents(const std::string& line, const std::string& fileName, int lineNumber)
     {
-        infra::StdStringInputStream stream(line, infra::softFail);
+        // The first character is the start code, which is not checked
+        std::size_t index = 1;
+        auto readByte = [&](uint8_t& byte)
+        {
+            auto high = HexDigit(line, index);
+            auto low = HexDigit(line, index + 1);
+            if (high < 0 || low < 0)
+                throw RecordTooShortException(fileName, lineNumber);
 
-        char colon;
-        stream >> colon;
+            byte = static_cast<uint8_t>(high * 16 + low);
+            index += 2;
+            return byte;
+        };
 
         uint8_t size = 0;
-        stream >> infra::hex >> infra::Width(2, '0') >> size >> infra::Width(4, '0') >> address >> infra::Width(2, '0') >> recordType;
-        uint8_t sum = static_cast<uint8_t>(size + static_cast<uint8_t>(address) + static_cast<uint8_t>(address >> 8) + recordType);
-
-        if (stream.Failed())
-            throw RecordTooShortException(fileName, lineNumber);
+        uint8_t addressHigh = 0;
+        uint8_t addressLow = 0;
+        uint8_t sum = static_cast<uint8_t>(readByte(size) + readByte(addressHigh) + readByte(addressLow) + readByte(recordType));
+        address = static_cast<uint16_t>(addressHigh << 8 | addressLow);
 
-        for (std::size_t i = 0; i != size; ++i)
-        {
-            uint8_t byte = 0;
-            stream >> infra::hex >> infra::Width(2) >> byte;
-            sum += byte;
-            data.push_back(byte);
-        }
+        data.resize(size);
+        for (auto& byte : data)
+            sum += readByte(byte);
 
         uint8_t checksum = 0;
-        stream >> infra::hex >> infra::Width(2) >> checksum;
-        sum += checksum;
+        sum += readByte(checksum);
 
-        if (stream.Failed())
-            throw RecordTooShortException(fileName, lineNumber);
         if (sum != 0)
             throw IncorrectCrcException(fileName, lineNumber);
 
-        if (!stream.Empty() && StringHasNonSpaces(std::string_view(line).substr(line.size() - stream.Available())))
+        if (StringHasNonSpaces(std::string_view(line).substr(index)))
             throw RecordTooLongException(fileName, lineNumber);
     }
 }
@@ -0,0 +1,145 @@
+#include "upgrade/pack_builder/ImageCompressorLz4.hpp"
+#include "upgrade/pack/UpgradePackHeader.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace application
+{
+    namespace
+    {
+        const std::size_t minimumMatchLength = 4;
+        const std::size_t lastLiteralsLength = 5;   // The LZ4 block format requires the last 5 bytes to be literals
+        const std::size_t matchStartLimit = 12;     // and the last match to start at least 12 bytes before the end
+        const std::size_t hashBits = 16;
+        const std::size_t maxChainLength = 64;
+
+        uint32_t Hash(const std::vector<uint8_t>& data, std::size_t position)
+        {
+            uint32_t sequence = data[position] | (data[position + 1] << 8) | (data[position + 2] << 16) | (static_cast<uint32_t>(data[position + 3]) << 24);
+            return (sequence * 2654435761u) >> (32 - hashBits);
+        }
+    }
+
+    ImageCompressorLz4::ImageCompressorLz4(const ImageSecurity& imageSecurity, uint32_t windowSize)
+        : imageSecurity(imageSecurity)
+        , windowSize(windowSize)
+    {
+        if (windowSize == 0 || windowSize > 65535)
+            throw std::runtime_error("LZ4 window size must be between 1 and 65535");
+    }
+
+    uint32_t ImageCompressorLz4::EncryptionAndMacMethod() const
+    {
+        return imageSecurity.EncryptionAndMacMethod();
+    }
+
+    std::vector<uint8_t> ImageCompressorLz4::Secure(const std::vector<uint8_t>& data) const
+    {
+        if (data.size() < sizeof(ImageHeaderEpilogue))
+            throw std::runtime_error("Image is missing its header");
+
+        ImageHeaderEpilogue epilogue;
+        std::copy(data.begin(), data.begin() + sizeof(epilogue), reinterpret_cast<uint8_t*>(&epilogue));
+
+        CompressedImageHeader header{ compressedImageMagicLz4, static_cast<uint32_t>(data.size() - sizeof(epilogue)), windowSize };
+        std::vector<uint8_t> compressed = Compress(std::vector<uint8_t>(data.begin() + sizeof(epilogue), data.end()));
+        epilogue.imageSize = static_cast<uint32_t>(sizeof(header) + compressed.size());
+
+        std::vector<uint8_t> result(reinterpret_cast<const uint8_t*>(&epilogue), reinterpret_cast<const uint8_t*>(&epilogue + 1));
+        result.insert(result.end(), reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header + 1));
+        result.insert(result.end(), compressed.begin(), compressed.end());
+
+        return imageSecurity.Secure(result);
+    }
+
+    std::vector<uint8_t> ImageCompressorLz4::Compress(const std::vector<uint8_t>& data) const
+    {
+        std::vector<uint8_t> result;
+        std::vector<int32_t> head(1 << hashBits, -1);
+        std::vector<int32_t> previous(data.size(), -1);
+
+        auto insert = [&](std::size_t position)
+        {
+            auto hash = Hash(data, position);
+            previous[position] = head[hash];
+            head[hash] = static_cast<int32_t>(position);
+        };
+
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+
+        while (data.size() >= matchStartLimit && position <= data.size() - matchStartLimit)
+        {
+            std::size_t bestLength = 0;
+            std::size_t bestCandidate = 0;
+
+            auto candidate = head[Hash(data, position)];
+            for (std::size_t chain = 0; candidate >= 0 && position - candidate <= windowSize && chain != maxChainLength; ++chain, candidate = previous[candidate])
+            {
+                auto length = MatchLength(data, candidate, position, data.size() - lastLiteralsLength);
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    bestCandidate = candidate;
+                }
+            }
+
+            if (bestLength >= minimumMatchLength)
+            {
+                AddSequence(result, data.data() + anchor, position - anchor, static_cast<uint16_t>(position - bestCandidate), bestLength);
+
+                auto matchEnd = position + bestLength;
+                for (; position != matchEnd && position <= data.size() - matchStartLimit; ++position)
+                    insert(position);
+
+                position = anchor = matchEnd;
+            }
+            else
+                insert(position++);
+        }
+
+        AddLastLiterals(result, data.data() + anchor, data.size() - anchor);
+
+        return result;
+    }
+
+    std::size_t ImageCompressorLz4::MatchLength(const std::vector<uint8_t>& data, std::size_t candidate, std::size_t position, std::size_t end) const
+    {
+        std::size_t length = 0;
+        while (position + length != end && data[candidate + length] == data[position + length])
+            ++length;
+
+        return length;
+    }
+
+    void ImageCompressorLz4::AddSequence(std::vector<uint8_t>& result, const uint8_t* literals, std::size_t literalLength, uint16_t offset, std::size_t matchLength) const
+    {
+        auto matchCode = matchLength - minimumMatchLength;
+
+        result.push_back(static_cast<uint8_t>((std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchCode, 15)));
+        if (literalLength >= 15)
+            AddLength(result, literalLength - 15);
+        result.insert(result.end(), literals, literals + literalLength);
+
+        result.push_back(static_cast<uint8_t>(offset));
+        result.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15)
+            AddLength(result, matchCode - 15);
+    }
+
+    void ImageCompressorLz4::AddLastLiterals(std::vector<uint8_t>& result, const uint8_t* literals, std::size_t literalLength) const
+    {
+        result.push_back(static_cast<uint8_t>(std::min<std::size_t>(literalLength, 15) << 4));
+        if (literalLength >= 15)
+            AddLength(result, literalLength - 15);
+        result.insert(result.end(), literals, literals + literalLength);
+    }
+
+    void ImageCompressorLz4::AddLength(std::vector<uint8_t>& result, std::size_t length) const
+    {
+        for (; length >= 255; length -= 255)
+            result.push_back(255);
+
+        result.push_back(static_cast<uint8_t>(length));
+    }
+}
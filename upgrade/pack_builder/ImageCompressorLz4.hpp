@@ -0,0 +1,38 @@
+#ifndef UPGRADE_IMAGE_COMPRESSOR_LZ4_HPP
+#define UPGRADE_IMAGE_COMPRESSOR_LZ4_HPP
+
+#include "upgrade/pack_builder/ImageSecurity.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace application
+{
+    // ImageCompressorLz4 compresses the binary image with the LZ4 block format before handing it to the next
+    // ImageSecurity for encryption. Match distances are limited to windowSize, so that the boot loader can
+    // decompress with a window of that size; see ImageUpgraderDecompressLz4.
+    class ImageCompressorLz4
+        : public ImageSecurity
+    {
+    public:
+        static const uint32_t defaultWindowSize = 4096;
+
+        explicit ImageCompressorLz4(const ImageSecurity& imageSecurity, uint32_t windowSize = defaultWindowSize);
+
+        uint32_t EncryptionAndMacMethod() const override;
+        std::vector<uint8_t> Secure(const std::vector<uint8_t>& data) const override;
+
+        std::vector<uint8_t> Compress(const std::vector<uint8_t>& data) const;
+
+    private:
+        std::size_t MatchLength(const std::vector<uint8_t>& data, std::size_t candidate, std::size_t position, std::size_t end) const;
+        void AddSequence(std::vector<uint8_t>& result, const uint8_t* literals, std::size_t literalLength, uint16_t offset, std::size_t matchLength) const;
+        void AddLastLiterals(std::vector<uint8_t>& result, const uint8_t* literals, std::size_t literalLength) const;
+        void AddLength(std::vector<uint8_t>& result, std::size_t length) const;
+
+    private:
+        const ImageSecurity& imageSecurity;
+        uint32_t windowSize;
+    };
+}
+
+#endif
@@ -24,7 +24,12 @@ namespace application
     std::vector<uint8_t> ImageEncryptorAes::Secure(const std::vector<uint8_t>& data) const
     {
         std::vector<uint8_t> counter(blockLength, 0);
-        randomDataGenerator.GenerateRandomData(counter);
+
+        {
+            // Images of different targets may be secured concurrently, while the random data generator is shared
+            std::lock_guard<std::mutex> lock(randomDataGeneratorMutex);
+            randomDataGenerator.GenerateRandomData(counter);
+        }
 
         mbedtls_aes_context ctx;
         mbedtls_aes_init(&ctx);
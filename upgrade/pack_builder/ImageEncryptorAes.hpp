@@ -5,6 +5,7 @@
 #include "infra/util/ByteRange.hpp"
 #include "upgrade/pack_builder/ImageSecurity.hpp"
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace application
@@ -25,6 +26,7 @@ namespace application
         bool CheckDecryption(const std::vector<uint8_t>& original, const std::vector<uint8_t>& encrypted) const;
 
         hal::SynchronousRandomDataGenerator& randomDataGenerator;
+        mutable std::mutex randomDataGeneratorMutex;
         infra::ConstByteRange key;
     };
 }
@@ -6,6 +6,8 @@
 
 namespace application
 {
+    // When an UpgradePackBuilder creates images concurrently, Secure is invoked from several threads at once, so
+    // implementations must then be thread-safe
     class ImageSecurity
     {
     public:
@@ -15,6 +15,8 @@ namespace application
         TargetNameTooLongException(const std::string& name, int maxSize);
     };
 
+    // When an UpgradePackBuilder creates images concurrently, Image is invoked on different inputs from several threads
+    // at once, so implementations must not share unsynchronised state between inputs
     class Input
     {
     public:
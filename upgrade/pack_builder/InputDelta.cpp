@@ -0,0 +1,163 @@
+#include "upgrade/pack_builder/InputDelta.hpp"
+#include "upgrade/pack_builder/InputBinary.hpp"
+#include <algorithm>
+
+namespace application
+{
+    namespace
+    {
+        const std::size_t minimumMatchLength = 8;
+        const std::size_t hashBits = 16;
+        const std::size_t maxCandidates = 32;
+        const std::size_t maxExtensionWithoutGain = 64;
+
+        uint32_t Hash(const std::vector<uint8_t>& data, std::size_t position)
+        {
+            uint32_t hash = 2166136261u;
+            for (std::size_t i = 0; i != minimumMatchLength; ++i)
+                hash = (hash ^ data[position + i]) * 16777619u;
+
+            return hash >> (32 - hashBits);
+        }
+    }
+
+    InputDelta::InputDelta(const std::string& targetName, const std::string& baseFileName, const std::string& fileName, uint32_t destinationAddress,
+        hal::FileSystem& fileSystem, const ImageSecurity& imageSecurity, ImageSigner& signer)
+        : InputDelta(targetName, fileSystem.ReadBinaryFile(baseFileName), fileSystem.ReadBinaryFile(fileName), destinationAddress, imageSecurity, signer)
+    {}
+
+    InputDelta::InputDelta(const std::string& targetName, const std::vector<uint8_t>& base, const std::vector<uint8_t>& contents, uint32_t destinationAddress,
+        const ImageSecurity& imageSecurity, ImageSigner& signer)
+        : Input(targetName)
+        , destinationAddress(destinationAddress)
+        , imageSecurity(imageSecurity)
+        , signer(signer)
+        , base(base)
+        , contents(contents)
+    {
+        if (signer.SignatureLength() > DeltaImageHeader().baseSignature.size())
+            throw std::runtime_error("Signature too long for delta image");
+    }
+
+    std::vector<uint8_t> InputDelta::Image() const
+    {
+        auto header = Header();
+
+        std::vector<uint8_t> image(reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header + 1));
+        auto patch = Patch();
+        image.insert(image.end(), patch.begin(), patch.end());
+
+        InputBinary inputBinary(TargetName(), image, destinationAddress, imageSecurity);
+        return inputBinary.Image();
+    }
+
+    std::vector<uint8_t> InputDelta::Patch() const
+    {
+        std::vector<std::vector<uint32_t>> index(1 << hashBits);
+        if (base.size() >= minimumMatchLength)
+            for (std::size_t position = 0; position <= base.size() - minimumMatchLength; ++position)
+                index[Hash(base, position)].push_back(static_cast<uint32_t>(position));
+
+        std::vector<uint8_t> patch;
+        std::size_t diffBase = 0;
+        std::size_t diffPosition = 0;
+        std::size_t diffLength = 0;
+        std::size_t position = 0;
+
+        while (position < contents.size())
+        {
+            auto match = FindMatch(index, position);
+
+            if (match.length < minimumMatchLength)
+            {
+                ++position;
+                continue;
+            }
+
+            AddRecord(patch, diffBase, diffPosition, diffLength, position - diffPosition - diffLength, match.base);
+
+            diffBase = match.base;
+            diffPosition = position;
+            diffLength = ExtendApproximately(match.base, position);
+            position += diffLength;
+        }
+
+        AddRecord(patch, diffBase, diffPosition, diffLength, contents.size() - diffPosition - diffLength, diffBase + diffLength);
+
+        return patch;
+    }
+
+    InputDelta::Match InputDelta::FindMatch(const std::vector<std::vector<uint32_t>>& index, std::size_t position) const
+    {
+        Match best{ 0, 0 };
+
+        if (contents.size() - position < minimumMatchLength)
+            return best;
+
+        const auto& candidates = index[Hash(contents, position)];
+        auto begin = candidates.size() > maxCandidates ? candidates.end() - maxCandidates : candidates.begin();
+        for (auto candidate = begin; candidate != candidates.end(); ++candidate)
+        {
+            std::size_t length = 0;
+            while (position + length != contents.size() && *candidate + length != base.size() && contents[position + length] == base[*candidate + length])
+                ++length;
+
+            if (length > best.length)
+                best = Match{ *candidate, length };
+        }
+
+        return best;
+    }
+
+    std::size_t InputDelta::ExtendApproximately(std::size_t basePosition, std::size_t position) const
+    {
+        // Like bsdiff, keep extending the region as long as at least half of the bytes match, since the differences
+        // then consist mostly of zeros. The region ends where the score of matches minus mismatches is highest.
+        std::size_t length = 0;
+        std::size_t bestLength = 0;
+        int score = 0;
+        int bestScore = 0;
+
+        while (position + length != contents.size() && basePosition + length != base.size() && length - bestLength <= maxExtensionWithoutGain)
+        {
+            score += contents[position + length] == base[basePosition + length] ? 1 : -1;
+            ++length;
+
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestLength = length;
+            }
+        }
+
+        return bestLength;
+    }
+
+    void InputDelta::AddRecord(std::vector<uint8_t>& patch, std::size_t diffBase, std::size_t diffPosition, std::size_t diffLength, std::size_t extraLength, std::size_t nextBase) const
+    {
+        DeltaRecord record{ static_cast<uint32_t>(diffLength), static_cast<uint32_t>(extraLength), static_cast<int32_t>(nextBase - (diffBase + diffLength)) };
+        patch.insert(patch.end(), reinterpret_cast<const uint8_t*>(&record), reinterpret_cast<const uint8_t*>(&record + 1));
+
+        for (std::size_t i = 0; i != diffLength; ++i)
+            patch.push_back(static_cast<uint8_t>(contents[diffPosition + i] - base[diffBase + i]));
+
+        auto extra = contents.begin() + diffPosition + diffLength;
+        patch.insert(patch.end(), extra, extra + extraLength);
+    }
+
+    DeltaImageHeader InputDelta::Header() const
+    {
+        DeltaImageHeader header{};
+        header.imageSize = static_cast<uint32_t>(contents.size());
+        header.baseSize = static_cast<uint32_t>(base.size());
+        header.signatureMethod = signer.SignatureMethod();
+        header.signatureLength = signer.SignatureLength();
+
+        auto baseSignature = signer.ImageSignature(base);
+        std::copy(baseSignature.begin(), baseSignature.end(), header.baseSignature.begin());
+        auto imageSignature = signer.ImageSignature(contents);
+        std::copy(imageSignature.begin(), imageSignature.end(), header.imageSignature.begin());
+
+        return header;
+    }
+}
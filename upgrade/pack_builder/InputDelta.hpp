@@ -0,0 +1,51 @@
+#ifndef UPGRADE_INPUT_DELTA_HPP
+#define UPGRADE_INPUT_DELTA_HPP
+
+#include "hal/interfaces/FileSystem.hpp"
+#include "upgrade/pack/UpgradePackHeader.hpp"
+#include "upgrade/pack_builder/ImageSecurity.hpp"
+#include "upgrade/pack_builder/ImageSigner.hpp"
+#include "upgrade/pack_builder/Input.hpp"
+
+namespace application
+{
+    // InputDelta produces a patch that transforms the base image, which is the image currently installed on the device,
+    // into the new contents. The patch is a stream of DeltaRecords in the style of bsdiff: regions that moved or changed
+    // slightly are stored as differences against the base, so they consist mostly of zeros and compress well.
+    // Both the base and the new image are signed by signer, so that the boot loader can check that the patch is
+    // applied to the right base, and that the reconstructed image is correct.
+    class InputDelta
+        : public Input
+    {
+    public:
+        InputDelta(const std::string& targetName, const std::string& baseFileName, const std::string& fileName, uint32_t destinationAddress,
+            hal::FileSystem& fileSystem, const ImageSecurity& imageSecurity, ImageSigner& signer);
+        InputDelta(const std::string& targetName, const std::vector<uint8_t>& base, const std::vector<uint8_t>& contents, uint32_t destinationAddress,
+            const ImageSecurity& imageSecurity, ImageSigner& signer);
+
+        std::vector<uint8_t> Image() const override;
+
+        std::vector<uint8_t> Patch() const;
+
+    private:
+        struct Match
+        {
+            std::size_t base;
+            std::size_t length;
+        };
+
+        Match FindMatch(const std::vector<std::vector<uint32_t>>& index, std::size_t position) const;
+        std::size_t ExtendApproximately(std::size_t base, std::size_t position) const;
+        void AddRecord(std::vector<uint8_t>& patch, std::size_t diffBase, std::size_t diffPosition, std::size_t diffLength, std::size_t extraLength, std::size_t nextBase) const;
+        DeltaImageHeader Header() const;
+
+    private:
+        uint32_t destinationAddress;
+        const ImageSecurity& imageSecurity;
+        ImageSigner& signer;
+        std::vector<uint8_t> base;
+        std::vector<uint8_t> contents;
+    };
+}
+
+#endif
@@ -16,9 +16,6 @@ namespace application
 
         std::vector<uint8_t> Image() const override;
 
-    private:
-        std::pair<std::vector<uint8_t>, uint32_t> Linearize(const application::SparseVector<uint8_t>& data) const;
-
     private:
         const ImageSecurity& imageSecurity;
         application::BinaryObject contents;
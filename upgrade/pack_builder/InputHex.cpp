@@ -14,26 +14,9 @@ namespace application
     {
         std::vector<uint8_t> binary;
         uint32_t startAddress = 0;
-        std::tie(binary, startAddress) = Linearize(contents.Memory());
+        std::tie(binary, startAddress) = contents.Memory().Linearize(0xff);
         InputBinary inputBinary(TargetName(), binary, startAddress, imageSecurity);
 
         return inputBinary.Image();
     }
-
-    std::pair<std::vector<uint8_t>, uint32_t> InputHex::Linearize(const application::SparseVector<uint8_t>& data) const
-    {
-        uint32_t startAddress = (*data.begin()).first;
-        std::vector<uint8_t> result;
-
-        for (auto i : data)
-        {
-            uint32_t address = i.first;
-            if (result.size() < address + 1 - startAddress)
-                result.resize(address + 1 - startAddress, 0xff);
-
-            result[address - startAddress] = i.second;
-        }
-
-        return std::make_pair(result, startAddress);
-    }
 }
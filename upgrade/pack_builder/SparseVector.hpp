@@ -1,6 +1,7 @@
 #ifndef UPGRADE_SPARSE_VECTOR_HPP
 #define UPGRADE_SPARSE_VECTOR_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
@@ -23,14 +24,18 @@ namespace application
         std::string message;
     };
 
+    // SparseVector stores contiguous segments of elements, keyed by the position of their first element.
+    // Contiguous data should be inserted and read per segment; the element-wise interface is kept for convenience.
     template<class T>
     class SparseVector
     {
     public:
+        using Segments = std::map<std::size_t, std::vector<T>>;
+
         class Iterator
         {
         public:
-            Iterator(const SparseVector<T>& vector, std::size_t position);
+            Iterator(typename Segments::const_iterator segment, std::size_t offset);
 
             std::pair<std::size_t, T> operator*() const;
             Iterator& operator++();
@@ -38,8 +43,8 @@ namespace application
             bool operator!=(const Iterator& other) const;
 
         private:
-            const SparseVector<T>& vector;
-            std::size_t position;
+            typename Segments::const_iterator segment;
+            std::size_t offset;
         };
 
         bool Empty() const;
@@ -50,14 +55,19 @@ namespace application
         bool InvariantHolds() const;
 
         void Insert(T element, std::size_t position);
+        void Insert(const std::vector<T>& elements, std::size_t position);
         T& operator[](std::size_t position);
         std::pair<std::size_t, T> ElementAtIndex(std::size_t position) const;
 
+        const Segments& GetSegments() const;
+        // Returns all elements from the first to the last position, with gaps filled with fill, and the first position
+        std::pair<std::vector<T>, std::size_t> Linearize(T fill) const;
+
         bool operator==(const SparseVector<T>& other) const;
         bool operator!=(const SparseVector<T>& other) const;
 
     private:
-        std::map<std::size_t, std::vector<T>> buckets;
+        Segments buckets;
     };
 
     ////    Implementation    ////
@@ -75,21 +85,25 @@ namespace application
     }
 
     template<class T>
-    SparseVector<T>::Iterator::Iterator(const SparseVector<T>& vector, std::size_t position)
-        : vector(vector)
-        , position(position)
+    SparseVector<T>::Iterator::Iterator(typename Segments::const_iterator segment, std::size_t offset)
+        : segment(segment)
+        , offset(offset)
     {}
 
     template<class T>
     std::pair<std::size_t, T> SparseVector<T>::Iterator::operator*() const
     {
-        return vector.ElementAtIndex(position);
+        return std::make_pair(segment->first + offset, segment->second[offset]);
     }
 
     template<class T>
     typename SparseVector<T>::Iterator& SparseVector<T>::Iterator::operator++()
     {
-        ++position;
+        if (++offset == segment->second.size())
+        {
+            ++segment;
+            offset = 0;
+        }
 
         return *this;
     }
@@ -97,7 +111,7 @@ namespace application
     template<class T>
     bool SparseVector<T>::Iterator::operator==(const Iterator& other) const
     {
-        return &vector == &other.vector && position == other.position;
+        return segment == other.segment && offset == other.offset;
     }
 
     template<class T>
@@ -115,13 +129,13 @@ namespace application
     template<class T>
     typename SparseVector<T>::Iterator SparseVector<T>::begin() const
     {
-        return Iterator(*this, 0);
+        return Iterator(buckets.begin(), 0);
     }
 
     template<class T>
     typename SparseVector<T>::Iterator SparseVector<T>::end() const
     {
-        return Iterator(*this, Size());
+        return Iterator(buckets.end(), 0);
     }
 
     template<class T>
@@ -156,29 +170,45 @@ namespace application
     template<class T>
     void SparseVector<T>::Insert(T element, std::size_t position)
     {
-        for (auto& bucket : buckets)
-        {
-            if (position == bucket.first + bucket.second.size())
-            {
-                bucket.second.push_back(element);
-                return;
-            }
+        Insert(std::vector<T>(1, element), position);
+    }
+
+    template<class T>
+    void SparseVector<T>::Insert(const std::vector<T>& elements, std::size_t position)
+    {
+        if (elements.empty())
+            return;
+
+        auto next = buckets.upper_bound(position);
+
+        if (next != buckets.end() && next->first < position + elements.size())
+            throw OverwriteException(next->first);
 
-            if (position >= bucket.first && position < bucket.first + bucket.second.size())
+        auto bucket = next;
+        if (bucket != buckets.begin() && (--bucket)->first + bucket->second.size() >= position)
+        {
+            if (bucket->first + bucket->second.size() != position)
                 throw OverwriteException(position);
+
+            bucket->second.insert(bucket->second.end(), elements.begin(), elements.end());
         }
+        else
+            bucket = buckets.emplace_hint(next, position, elements);
 
-        buckets.insert(std::make_pair(position, std::vector<T>(1, element)));
+        if (next != buckets.end() && next->first == position + elements.size())
+        {
+            bucket->second.insert(bucket->second.end(), next->second.begin(), next->second.end());
+            buckets.erase(next);
+        }
     }
 
     template<class T>
     T& SparseVector<T>::operator[](std::size_t position)
     {
-        for (auto& index : buckets)
-        {
-            if (index.first <= position && index.first + index.second.size() > position)
-                return index.second[position - index.first];
-        }
+        auto bucket = buckets.upper_bound(position);
+
+        if (bucket != buckets.begin() && (--bucket)->first + bucket->second.size() > position)
+            return bucket->second[position - bucket->first];
 
         std::abort();
     }
@@ -197,6 +227,28 @@ namespace application
         std::abort();
     }
 
+    template<class T>
+    const typename SparseVector<T>::Segments& SparseVector<T>::GetSegments() const
+    {
+        return buckets;
+    }
+
+    template<class T>
+    std::pair<std::vector<T>, std::size_t> SparseVector<T>::Linearize(T fill) const
+    {
+        if (buckets.empty())
+            return std::make_pair(std::vector<T>(), 0);
+
+        auto start = buckets.begin()->first;
+        auto& last = *buckets.rbegin();
+        std::vector<T> result(last.first + last.second.size() - start, fill);
+
+        for (auto& bucket : buckets)
+            std::copy(bucket.second.begin(), bucket.second.end(), result.begin() + (bucket.first - start));
+
+        return std::make_pair(std::move(result), start);
+    }
+
     template<class T>
     bool SparseVector<T>::operator==(const SparseVector<T>& other) const
     {
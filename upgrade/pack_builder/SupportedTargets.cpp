@@ -20,10 +20,17 @@ namespace application
         return *this;
     }
 
+    SupportedTargetsBuilder& SupportedTargetsBuilder::Compressed()
+    {
+        compressed = true;
+        return *this;
+    }
+
     SupportedTargetsBuilder& SupportedTargetsBuilder::AddCmd(const SupportedTargets::Target& target)
     {
         AddToMandatoryWhenNecessary(target);
         AddInOrder(target);
+        AddToCompressedWhenNecessary(target);
         targets.cmd.emplace_back(target);
         return *this;
     }
@@ -32,6 +39,7 @@ namespace application
     {
         AddToMandatoryWhenNecessary(target);
         AddInOrder(target);
+        AddToCompressedWhenNecessary(target);
         targets.hex.emplace_back(target);
         return *this;
     }
@@ -40,6 +48,7 @@ namespace application
     {
         AddToMandatoryWhenNecessary(target);
         AddInOrder(target);
+        AddToCompressedWhenNecessary(target);
         targets.elf.emplace_back(target, offset);
         return *this;
     }
@@ -48,10 +57,20 @@ namespace application
     {
         AddToMandatoryWhenNecessary(target);
         AddInOrder(target);
+        AddToCompressedWhenNecessary(target);
         targets.bin.emplace_back(target, offset);
         return *this;
     }
 
+    SupportedTargetsBuilder& SupportedTargetsBuilder::AddDelta(const SupportedTargets::Target& target, uint32_t offset)
+    {
+        AddToMandatoryWhenNecessary(target);
+        AddInOrder(target);
+        AddToCompressedWhenNecessary(target);
+        targets.delta.emplace_back(target, offset);
+        return *this;
+    }
+
     void SupportedTargetsBuilder::AddToMandatoryWhenNecessary(const SupportedTargets::Target& target)
     {
         if (mandatory)
@@ -70,6 +89,15 @@ namespace application
         }
     }
 
+    void SupportedTargetsBuilder::AddToCompressedWhenNecessary(const SupportedTargets::Target& target)
+    {
+        if (compressed)
+        {
+            targets.compressed.emplace_back(target);
+            compressed = false;
+        }
+    }
+
     SupportedTargetsBuilder SupportedTargets::Create()
     {
         return SupportedTargetsBuilder();
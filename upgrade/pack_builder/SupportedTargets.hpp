@@ -41,6 +41,11 @@ namespace application
             return bin;
         }
 
+        const auto& DeltaTargets() const
+        {
+            return delta;
+        }
+
         const auto& MandatoryTargets() const
         {
             return mandatory;
@@ -51,14 +56,21 @@ namespace application
             return order;
         }
 
+        const auto& CompressedTargets() const
+        {
+            return compressed;
+        }
+
     private:
         std::vector<Target> cmd;
         std::vector<Target> hex;
         std::vector<TargetWithOffset> elf;
         std::vector<TargetWithOffset> bin;
+        std::vector<TargetWithOffset> delta;
 
         std::vector<Target> mandatory;
         std::map<uint8_t, std::vector<Target>> order;
+        std::vector<Target> compressed;
     };
 
     class SupportedTargetsBuilder
@@ -72,20 +84,25 @@ namespace application
         SupportedTargetsBuilder& Mandatory();
         SupportedTargetsBuilder& Optional();
         SupportedTargetsBuilder& Order(uint8_t order);
+        // The image of the next target is compressed with ImageCompressorLz4, so the boot loader must decompress it with ImageUpgraderDecompressLz4
+        SupportedTargetsBuilder& Compressed();
 
         SupportedTargetsBuilder& AddCmd(const SupportedTargets::Target& target);
         SupportedTargetsBuilder& AddHex(const SupportedTargets::Target& target);
         SupportedTargetsBuilder& AddElf(const SupportedTargets::Target& target, uint32_t offset);
         SupportedTargetsBuilder& AddBin(const SupportedTargets::Target& target, uint32_t offset);
+        SupportedTargetsBuilder& AddDelta(const SupportedTargets::Target& target, uint32_t offset);
 
     private:
         void AddToMandatoryWhenNecessary(const SupportedTargets::Target& target);
         void AddInOrder(const SupportedTargets::Target& target);
+        void AddToCompressedWhenNecessary(const SupportedTargets::Target& target);
 
     private:
         SupportedTargets targets;
         bool mandatory{ false };
         std::optional<uint8_t> order;
+        bool compressed{ false };
     };
 }
 
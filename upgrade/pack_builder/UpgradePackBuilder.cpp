@@ -1,7 +1,9 @@
 #include "upgrade/pack_builder/UpgradePackBuilder.hpp"
 #include "upgrade/pack/UpgradePackHeader.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <future>
 
 namespace application
 {
@@ -9,9 +11,10 @@ namespace application
         : runtime_error("Signature does not verify")
     {}
 
-    UpgradePackBuilder::UpgradePackBuilder(const HeaderInfo& headerInfo, std::vector<std::unique_ptr<Input>>&& inputs, ImageSigner& signer, UpgradePackStatus initialStatus)
+    UpgradePackBuilder::UpgradePackBuilder(const HeaderInfo& headerInfo, std::vector<std::unique_ptr<Input>>&& inputs, ImageSigner& signer, UpgradePackStatus initialStatus, std::size_t concurrency)
         : headerInfo(headerInfo)
         , initialStatus(initialStatus)
+        , concurrency(std::max<std::size_t>(concurrency, 1))
         , inputs(std::move(inputs))
         , signer(signer)
     {
@@ -50,6 +53,7 @@ namespace application
         prologue.signedContentsLength = upgradePack.size();
         prologue.signatureMethod = signer.SignatureMethod();
         prologue.signatureLength = static_cast<uint16_t>(signature.size());
+        prologue.sectorsRewritten = 0xffffffff;
 
         upgradePack.insert(upgradePack.begin(), signature.begin(), signature.end());
         upgradePack.insert(upgradePack.begin(), reinterpret_cast<const uint8_t*>(&prologue), reinterpret_cast<const uint8_t*>(&prologue + 1));
@@ -58,7 +62,7 @@ namespace application
     void UpgradePackBuilder::AddEpilogue()
     {
         UpgradePackHeaderEpilogue epilogue = {};
-        epilogue.headerVersion = 1;
+        epilogue.headerVersion = 2;
         epilogue.headerLength = sizeof(UpgradePackHeaderPrologue) + signer.SignatureLength() + sizeof(UpgradePackHeaderEpilogue);
         epilogue.numberOfImages = inputs.size();
 
@@ -72,11 +76,31 @@ namespace application
 
     void UpgradePackBuilder::AddImages()
     {
-        for (const auto& input : inputs)
-        {
-            const auto& image = input->Image();
+        for (const auto& image : CreateImages())
             upgradePack.insert(upgradePack.end(), image.begin(), image.end());
-        }
+    }
+
+    std::vector<std::vector<uint8_t>> UpgradePackBuilder::CreateImages() const
+    {
+        std::vector<std::vector<uint8_t>> images(inputs.size());
+        std::atomic<std::size_t> next{ 0 };
+
+        auto createImages = [this, &images, &next]()
+        {
+            for (auto index = next++; index < inputs.size(); index = next++)
+                images[index] = inputs[index]->Image();
+        };
+
+        std::vector<std::future<void>> workers;
+        for (std::size_t i = 1; i < std::min(concurrency, inputs.size()); ++i)
+            workers.push_back(std::async(std::launch::async, createImages));
+
+        createImages();
+
+        for (auto& worker : workers)
+            worker.get();
+
+        return images;
     }
 
     void UpgradePackBuilder::AssignZeroFilled(const std::string& data, infra::MemoryRange<char> destination) const
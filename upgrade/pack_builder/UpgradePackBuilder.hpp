@@ -30,7 +30,10 @@ namespace application
         };
 
     public:
-        UpgradePackBuilder(const HeaderInfo& headerInfo, std::vector<std::unique_ptr<Input>>&& inputs, ImageSigner& signer, UpgradePackStatus initialStatus = UpgradePackStatus::readyToDeploy);
+        // With a concurrency larger than one, the images of the inputs are created on that many threads at once,
+        // so Input::Image() and the ImageSecurity it uses must then be safe to invoke concurrently. The images
+        // are always placed in the upgrade pack in the order of the inputs.
+        UpgradePackBuilder(const HeaderInfo& headerInfo, std::vector<std::unique_ptr<Input>>&& inputs, ImageSigner& signer, UpgradePackStatus initialStatus = UpgradePackStatus::readyToDeploy, std::size_t concurrency = 1);
 
         std::vector<uint8_t>& UpgradePack();
         void WriteUpgradePack(const hal::filesystem::path& fileName, hal::FileSystem& fileSystem);
@@ -40,12 +43,14 @@ namespace application
         void AddPrologueAndSignature();
         void AddEpilogue();
         void AddImages();
+        std::vector<std::vector<uint8_t>> CreateImages() const;
         void AssignZeroFilled(const std::string& data, infra::MemoryRange<char> destination) const;
         void CheckSignature();
 
     private:
         HeaderInfo headerInfo;
         UpgradePackStatus initialStatus;
+        std::size_t concurrency;
         std::vector<std::unique_ptr<Input>> inputs;
         ImageSigner& signer;
         std::vector<uint8_t> upgradePack;
@@ -1,6 +1,7 @@
 #include "upgrade/pack_builder/UpgradePackInputFactory.hpp"
 #include "upgrade/pack_builder/InputBinary.hpp"
 #include "upgrade/pack_builder/InputCommand.hpp"
+#include "upgrade/pack_builder/InputDelta.hpp"
 #include "upgrade/pack_builder/InputElf.hpp"
 #include "upgrade/pack_builder/InputHex.hpp"
 #include <algorithm>
@@ -13,6 +14,14 @@ namespace application
         , imageSecurity(imageSecurity)
     {}
 
+    UpgradePackInputFactory::UpgradePackInputFactory(hal::FileSystem& fileSystem, const SupportedTargets& targets, const ImageSecurity& imageSecurity, ImageSigner& signer, const BaseFiles& baseFiles)
+        : fileSystem(fileSystem)
+        , targets(targets)
+        , imageSecurity(imageSecurity)
+        , signer(&signer)
+        , baseFiles(baseFiles)
+    {}
+
     std::unique_ptr<Input> UpgradePackInputFactory::CreateInput(const std::string& targetName, const std::string& fileName, std::optional<uint32_t> address)
     {
         if (std::any_of(targets.CmdTargets().cbegin(), targets.CmdTargets().cend(), [&targetName](const auto& string)
@@ -25,16 +34,34 @@ namespace application
                 {
                     return string == targetName;
                 }))
-            return std::make_unique<InputHex>(targetName, fileName, fileSystem, imageSecurity);
+            return std::make_unique<InputHex>(targetName, fileName, fileSystem, ImageSecurityFor(targetName));
 
         for (const auto& [name, offset] : targets.ElfTargets())
             if (name == targetName)
-                return std::make_unique<InputElf>(targetName, fileName, offset, fileSystem, imageSecurity);
+                return std::make_unique<InputElf>(targetName, fileName, offset, fileSystem, ImageSecurityFor(targetName));
 
         for (const auto& [name, offset] : targets.BinTargets())
             if (name == targetName)
-                return std::make_unique<InputBinary>(targetName, fileName, address.value_or(offset), fileSystem, imageSecurity);
+                return std::make_unique<InputBinary>(targetName, fileName, address.value_or(offset), fileSystem, ImageSecurityFor(targetName));
+
+        for (const auto& [name, offset] : targets.DeltaTargets())
+            if (name == targetName)
+            {
+                auto baseFile = baseFiles.find(targetName);
+                if (signer == nullptr || baseFile == baseFiles.end())
+                    throw MissingBaseFileException(targetName);
+
+                return std::make_unique<InputDelta>(targetName, baseFile->second, fileName, address.value_or(offset), fileSystem, ImageSecurityFor(targetName), *signer);
+            }
 
         throw UnknownTargetException(targetName);
     }
+
+    const ImageSecurity& UpgradePackInputFactory::ImageSecurityFor(const std::string& targetName) const
+    {
+        if (std::find(targets.CompressedTargets().cbegin(), targets.CompressedTargets().cend(), targetName) != targets.CompressedTargets().cend())
+            return compressor;
+        else
+            return imageSecurity;
+    }
 }
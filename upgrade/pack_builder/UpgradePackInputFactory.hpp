@@ -2,9 +2,12 @@
 #define UPGRADE_UPGRADE_PACK_INPUT_FACTORY_HPP
 
 #include "hal/interfaces/FileSystem.hpp"
+#include "upgrade/pack_builder/ImageCompressorLz4.hpp"
 #include "upgrade/pack_builder/ImageSecurity.hpp"
+#include "upgrade/pack_builder/ImageSigner.hpp"
 #include "upgrade/pack_builder/InputFactory.hpp"
 #include "upgrade/pack_builder/SupportedTargets.hpp"
+#include <map>
 
 namespace application
 {
@@ -17,18 +20,38 @@ namespace application
         {}
     };
 
+    class MissingBaseFileException
+        : public std::runtime_error
+    {
+    public:
+        explicit MissingBaseFileException(const std::string& target)
+            : std::runtime_error(std::string("No base image given for delta target '") + target + "'")
+        {}
+    };
+
     class UpgradePackInputFactory
         : public InputFactory
     {
     public:
+        // Maps the name of a delta target onto the file holding the image currently installed for that target
+        using BaseFiles = std::map<std::string, std::string>;
+
         UpgradePackInputFactory(hal::FileSystem& fileSystem, const SupportedTargets& targets, const ImageSecurity& imageSecurity);
+        // Delta targets sign their base and reconstructed image with signer, which must therefore match the boot loader's Verifier
+        UpgradePackInputFactory(hal::FileSystem& fileSystem, const SupportedTargets& targets, const ImageSecurity& imageSecurity, ImageSigner& signer, const BaseFiles& baseFiles);
 
         std::unique_ptr<Input> CreateInput(const std::string& targetName, const std::string& fileName, std::optional<uint32_t> address) override;
 
+    private:
+        const ImageSecurity& ImageSecurityFor(const std::string& targetName) const;
+
     private:
         hal::FileSystem& fileSystem;
         const SupportedTargets& targets;
         const ImageSecurity& imageSecurity;
+        ImageCompressorLz4 compressor{ imageSecurity };
+        ImageSigner* signer = nullptr;
+        BaseFiles baseFiles;
     };
 }
 
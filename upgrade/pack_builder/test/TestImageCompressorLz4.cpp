@@ -0,0 +1,50 @@
+#include "upgrade/pack/UpgradePackHeader.hpp"
+#include "upgrade/pack_builder/ImageCompressorLz4.hpp"
+#include "upgrade/pack_builder/ImageEncryptorNone.hpp"
+#include "gtest/gtest.h"
+
+class ImageCompressorLz4Test
+    : public testing::Test
+{
+public:
+    application::ImageEncryptorNone encryptor;
+    application::ImageCompressorLz4 compressor{ encryptor };
+};
+
+TEST_F(ImageCompressorLz4Test, EncryptionAndMacMethodIsTakenFromImageSecurity)
+{
+    EXPECT_EQ(encryptor.EncryptionAndMacMethod(), compressor.EncryptionAndMacMethod());
+}
+
+TEST_F(ImageCompressorLz4Test, short_data_is_stored_as_literals)
+{
+    EXPECT_EQ((std::vector<uint8_t>{ 0x30, 1, 2, 3 }), compressor.Compress({ 1, 2, 3 }));
+}
+
+TEST_F(ImageCompressorLz4Test, repetition_is_stored_as_match)
+{
+    EXPECT_EQ((std::vector<uint8_t>{ 0x1a, 0, 1, 0, 0x50, 0, 0, 0, 0, 0 }), compressor.Compress(std::vector<uint8_t>(20, 0)));
+}
+
+TEST_F(ImageCompressorLz4Test, matches_are_limited_to_window)
+{
+    std::vector<uint8_t> data;
+    for (uint8_t i = 0; i != 20; ++i)
+        data.push_back(i);
+    data.insert(data.end(), data.begin(), data.end());
+
+    application::ImageCompressorLz4 smallWindow(encryptor, 16);
+    EXPECT_EQ(data.size() + 2, smallWindow.Compress(data).size());
+    EXPECT_GT(data.size(), compressor.Compress(data).size());
+}
+
+TEST_F(ImageCompressorLz4Test, Secure_compresses_image_after_header)
+{
+    std::vector<uint8_t> data{ 1, 0, 0, 0, 20, 0, 0, 0 };
+    data.resize(28, 0);
+
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 0, 0, 0, 22, 0, 0, 0,
+                  'L', 'Z', '4', 'B', 20, 0, 0, 0, 0, 0x10, 0, 0,
+                  0x1a, 0, 1, 0, 0x50, 0, 0, 0, 0, 0 }),
+        compressor.Secure(data));
+}
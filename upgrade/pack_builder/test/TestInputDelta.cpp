@@ -0,0 +1,108 @@
+#include "hal/interfaces/test_doubles/FileSystemStub.hpp"
+#include "upgrade/pack_builder/ImageEncryptorNone.hpp"
+#include "upgrade/pack_builder/InputDelta.hpp"
+#include "gtest/gtest.h"
+#include <numeric>
+
+namespace
+{
+    // The signature is a single byte holding the sum of the image
+    class ImageSignerSum
+        : public application::ImageSigner
+    {
+    public:
+        uint16_t SignatureMethod() const override
+        {
+            return 7;
+        }
+
+        uint16_t SignatureLength() const override
+        {
+            return 1;
+        }
+
+        std::vector<uint8_t> ImageSignature(const std::vector<uint8_t>& image) override
+        {
+            return { std::accumulate(image.begin(), image.end(), uint8_t(0)) };
+        }
+
+        bool CheckSignature(const std::vector<uint8_t>& signature, const std::vector<uint8_t>& image) override
+        {
+            return signature == ImageSignature(image);
+        }
+    };
+
+    std::vector<uint8_t> Record(uint32_t diffLength, uint32_t extraLength, int32_t seek)
+    {
+        application::DeltaRecord record{ diffLength, extraLength, seek };
+        return std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(&record), reinterpret_cast<const uint8_t*>(&record + 1));
+    }
+
+    std::vector<uint8_t> Concatenate(std::initializer_list<std::vector<uint8_t>> parts)
+    {
+        std::vector<uint8_t> result;
+        for (auto& part : parts)
+            result.insert(result.end(), part.begin(), part.end());
+        return result;
+    }
+
+    std::vector<uint8_t> Sequence(uint8_t begin, uint8_t end)
+    {
+        std::vector<uint8_t> result(end - begin);
+        std::iota(result.begin(), result.end(), begin);
+        return result;
+    }
+}
+
+class TestInputDelta
+    : public testing::Test
+{
+public:
+    application::ImageEncryptorNone encryptor;
+    ImageSignerSum signer;
+};
+
+TEST_F(TestInputDelta, identical_image_is_a_single_difference)
+{
+    application::InputDelta input("main", Sequence(0, 16), Sequence(0, 16), 0, encryptor, signer);
+
+    EXPECT_EQ(Concatenate({ Record(0, 0, 0), Record(16, 0, 0), std::vector<uint8_t>(16, 0) }), input.Patch());
+}
+
+TEST_F(TestInputDelta, inserted_data_is_stored_as_extra)
+{
+    auto contents = Concatenate({ Sequence(0, 20), { 0xaa, 0xbb }, Sequence(20, 40) });
+    application::InputDelta input("main", Sequence(0, 40), contents, 0, encryptor, signer);
+
+    EXPECT_EQ(Concatenate({ Record(0, 0, 0), Record(20, 2, 0), std::vector<uint8_t>(20, 0), { 0xaa, 0xbb }, Record(20, 0, 0), std::vector<uint8_t>(20, 0) }), input.Patch());
+}
+
+TEST_F(TestInputDelta, moved_data_seeks_in_base)
+{
+    auto contents = Concatenate({ Sequence(20, 40), Sequence(0, 20) });
+    application::InputDelta input("main", Sequence(0, 40), contents, 0, encryptor, signer);
+
+    EXPECT_EQ(Concatenate({ Record(0, 0, 20), Record(20, 0, -40), std::vector<uint8_t>(20, 0), Record(20, 0, 0), std::vector<uint8_t>(20, 0) }), input.Patch());
+}
+
+TEST_F(TestInputDelta, unrelated_data_is_stored_as_extra)
+{
+    application::InputDelta input("main", Sequence(0, 16), Sequence(100, 110), 0, encryptor, signer);
+
+    EXPECT_EQ(Concatenate({ Record(0, 10, 0), Sequence(100, 110) }), input.Patch());
+}
+
+TEST_F(TestInputDelta, Image_contains_header_with_signatures)
+{
+    application::InputDelta input("main", Sequence(0, 16), Sequence(1, 17), 4321, encryptor, signer);
+
+    auto image = input.Image();
+    auto& header = reinterpret_cast<application::DeltaImageHeader&>(image[sizeof(application::ImageHeaderPrologue) + sizeof(application::ImageHeaderEpilogue)]);
+
+    EXPECT_EQ(16, header.imageSize);
+    EXPECT_EQ(16, header.baseSize);
+    EXPECT_EQ(7, header.signatureMethod);
+    EXPECT_EQ(1, header.signatureLength);
+    EXPECT_EQ(120, header.baseSignature[0]);
+    EXPECT_EQ(136, header.imageSignature[0]);
+}
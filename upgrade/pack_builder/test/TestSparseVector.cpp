@@ -74,3 +74,47 @@ TEST_F(SparseVectorTest, Equality)
     secondVector.Insert(0, 0);
     EXPECT_NE(vector, secondVector);
 }
+
+TEST_F(SparseVectorTest, InsertRange)
+{
+    vector.Insert(std::vector<uint8_t>{ 1, 2, 3 }, 4);
+    vector.Insert(std::vector<uint8_t>{ 4, 5 }, 7);
+
+    EXPECT_EQ((application::SparseVector<uint8_t>::Segments{ { 4, { 1, 2, 3, 4, 5 } } }), vector.GetSegments());
+}
+
+TEST_F(SparseVectorTest, InsertRangeJoinsFollowingSegment)
+{
+    vector.Insert(std::vector<uint8_t>{ 1, 2 }, 0);
+    vector.Insert(std::vector<uint8_t>{ 5 }, 4);
+    vector.Insert(std::vector<uint8_t>{ 3, 4 }, 2);
+
+    EXPECT_EQ((application::SparseVector<uint8_t>::Segments{ { 0, { 1, 2, 3, 4, 5 } } }), vector.GetSegments());
+}
+
+TEST_F(SparseVectorTest, InsertRangeOverlappingFollowingSegmentThrowsException)
+{
+    vector.Insert(std::vector<uint8_t>{ 1, 2 }, 4);
+
+    EXPECT_THROW(vector.Insert(std::vector<uint8_t>{ 3, 4, 5 }, 2), application::OverwriteException);
+}
+
+TEST_F(SparseVectorTest, InsertRangeOverlappingPrecedingSegmentThrowsException)
+{
+    vector.Insert(std::vector<uint8_t>{ 1, 2 }, 4);
+
+    EXPECT_THROW(vector.Insert(std::vector<uint8_t>{ 3, 4 }, 5), application::OverwriteException);
+}
+
+TEST_F(SparseVectorTest, Linearize)
+{
+    vector.Insert(std::vector<uint8_t>{ 1, 2 }, 4);
+    vector.Insert(std::vector<uint8_t>{ 3 }, 8);
+
+    EXPECT_EQ(std::make_pair(std::vector<uint8_t>{ 1, 2, 0xff, 0xff, 3 }, std::size_t(4)), vector.Linearize(0xff));
+}
+
+TEST_F(SparseVectorTest, LinearizeEmpty)
+{
+    EXPECT_EQ(std::make_pair(std::vector<uint8_t>(), std::size_t(0)), vector.Linearize(0xff));
+}
@@ -7,12 +7,14 @@ TEST(SupportedTargetsTest, should_add_correct_targets)
                                                 .AddCmd("cmd")
                                                 .AddHex("hex")
                                                 .AddElf("elf", 1234)
-                                                .AddBin("bin", 5678);
+                                                .AddBin("bin", 5678)
+                                                .AddDelta("delta", 9012);
 
     EXPECT_EQ("cmd", targets.CmdTargets()[0]);
     EXPECT_EQ("hex", targets.HexTargets()[0]);
     EXPECT_EQ(application::SupportedTargets::TargetWithOffset{ std::make_pair("elf", 1234) }, targets.ElfTargets()[0]);
     EXPECT_EQ(application::SupportedTargets::TargetWithOffset{ std::make_pair("bin", 5678) }, targets.BinTargets()[0]);
+    EXPECT_EQ(application::SupportedTargets::TargetWithOffset{ std::make_pair("delta", 9012) }, targets.DeltaTargets()[0]);
 }
 
 TEST(SupportedTargetsTest, should_add_optional_target_by_default)
@@ -72,3 +74,13 @@ TEST(SupportedTargetsTest, should_add_target_to_order_only_if_specified)
     EXPECT_EQ(1, orderedTargets.size());
     EXPECT_EQ("data", orderedTargets.at(1).at(0));
 }
+
+TEST(SupportedTargetsTest, should_add_target_to_compressed_only_if_specified)
+{
+    application::SupportedTargets targets = application::SupportedTargets::Create()
+                                                .Compressed()
+                                                .AddBin("application", 0)
+                                                .AddHex("data");
+
+    EXPECT_EQ(std::vector<application::SupportedTargets::Target>{ "application" }, targets.CompressedTargets());
+}
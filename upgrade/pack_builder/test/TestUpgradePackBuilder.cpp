@@ -47,6 +47,20 @@ public:
     std::vector<uint8_t> contents;
 };
 
+class InputThrowing
+    : public application::Input
+{
+public:
+    InputThrowing()
+        : application::Input("throwing")
+    {}
+
+    std::vector<uint8_t> Image() const override
+    {
+        throw std::runtime_error("image failed");
+    }
+};
+
 class TestUpgradePackBuilder
     : public testing::Test
 {
@@ -132,7 +146,7 @@ TEST_F(TestUpgradePackBuilder, HeaderVersion)
     std::vector<uint8_t> upgradePack = upgradePackBuilder.UpgradePack();
     const application::UpgradePackHeaderEpilogue& epilogue = reinterpret_cast<const application::UpgradePackHeaderEpilogue&>(*(upgradePack.begin() + sizeof(application::UpgradePackHeaderPrologue) + signer.SignatureLength()));
 
-    EXPECT_EQ(1, epilogue.headerVersion);
+    EXPECT_EQ(2, epilogue.headerVersion);
 }
 
 TEST_F(TestUpgradePackBuilder, check_product_and_component_parts_in_header)
@@ -205,3 +219,32 @@ TEST_F(TestUpgradePackBuilder, SignatureDoesNotVerify)
                      }()),
         application::SignatureDoesNotVerifyException);
 }
+
+TEST_F(TestUpgradePackBuilder, images_created_concurrently_are_added_in_order)
+{
+    std::vector<uint8_t> expectedContents;
+    for (uint8_t i = 0; i != 16; ++i)
+    {
+        inputs.push_back(std::make_unique<InputStub>(std::vector<uint8_t>(i + 1, i)));
+        expectedContents.insert(expectedContents.end(), i + 1, i);
+    }
+
+    application::UpgradePackBuilder upgradePackBuilder(headerInfo, std::move(inputs), signer, application::UpgradePackStatus::readyToDeploy, 4);
+    std::vector<uint8_t> upgradePack = upgradePackBuilder.UpgradePack();
+    std::vector<uint8_t> imageContents(upgradePack.begin() + sizeof(application::UpgradePackHeaderPrologue) + signer.SignatureLength() + sizeof(application::UpgradePackHeaderEpilogue), upgradePack.end());
+
+    EXPECT_EQ(expectedContents, imageContents);
+}
+
+TEST_F(TestUpgradePackBuilder, exception_while_creating_images_concurrently_is_propagated)
+{
+    inputs.push_back(std::make_unique<InputStub>(std::vector<uint8_t>{ 1 }));
+    inputs.push_back(std::make_unique<InputThrowing>());
+    inputs.push_back(std::make_unique<InputStub>(std::vector<uint8_t>{ 2 }));
+
+    EXPECT_THROW(([this]
+                     {
+                         application::UpgradePackBuilder upgradePackBuilder(headerInfo, std::move(inputs), signer, application::UpgradePackStatus::readyToDeploy, 3);
+                     }()),
+        std::runtime_error);
+}
@@ -3,6 +3,35 @@
 #include "upgrade/pack_builder/ImageEncryptorNone.hpp"
 #include "upgrade/pack_builder/UpgradePackInputFactory.hpp"
 #include "gtest/gtest.h"
+#include <algorithm>
+
+namespace
+{
+    class ImageSignerStub
+        : public application::ImageSigner
+    {
+    public:
+        uint16_t SignatureMethod() const override
+        {
+            return 0;
+        }
+
+        uint16_t SignatureLength() const override
+        {
+            return 0;
+        }
+
+        std::vector<uint8_t> ImageSignature(const std::vector<uint8_t>& image) override
+        {
+            return {};
+        }
+
+        bool CheckSignature(const std::vector<uint8_t>& signature, const std::vector<uint8_t>& image) override
+        {
+            return true;
+        }
+    };
+}
 
 class TestUpgradePackInputFactory
     : public testing::Test
@@ -13,15 +42,21 @@ public:
         , execute([this]
               {
                   fileSystem.WriteFile("hex_file", std::vector<std::string>{ ":020000040001f9", ":0100000001fe", ":00000001FF" });
+                  fileSystem.WriteBinaryFile("base_file", std::vector<uint8_t>{ 1, 2, 3, 4 });
+                  fileSystem.WriteBinaryFile("delta_file", std::vector<uint8_t>{ 1, 2, 3, 5 });
                   fileSystem.WriteBinaryFile("elf_file", std::vector<uint8_t>{ 'E', 'L', 'F', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
 
                   targets = application::SupportedTargets::Create()
                                 .AddCmd("cmd")
                                 .AddBin("bin", 1234)
                                 .AddHex("hex")
-                                .AddElf("elf", 5678);
+                                .AddElf("elf", 5678)
+                                .AddDelta("delta", 9012)
+                                .Compressed()
+                                .AddBin("lz4", 1234);
               })
         , factory(fileSystem, targets, encryptor)
+        , deltaFactory(fileSystem, targets, encryptor, signer, { { "delta", "base_file" } })
     {}
 
     hal::FileSystemStub fileSystem;
@@ -29,6 +64,8 @@ public:
     infra::Execute execute;
     application::ImageEncryptorNone encryptor;
     application::UpgradePackInputFactory factory;
+    ImageSignerStub signer;
+    application::UpgradePackInputFactory deltaFactory;
 };
 
 TEST_F(TestUpgradePackInputFactory, create_Input_for_Command_target)
@@ -59,3 +96,25 @@ TEST_F(TestUpgradePackInputFactory, throws_for_unknown_target)
 {
     EXPECT_THROW(factory.CreateInput("unknown", "", std::nullopt), application::UnknownTargetException);
 }
+
+TEST_F(TestUpgradePackInputFactory, create_Input_for_Delta_target)
+{
+    auto input = deltaFactory.CreateInput("delta", "delta_file", std::nullopt);
+    EXPECT_EQ("delta", input->TargetName());
+}
+
+TEST_F(TestUpgradePackInputFactory, throws_for_Delta_target_without_base_file)
+{
+    EXPECT_THROW(factory.CreateInput("delta", "delta_file", std::nullopt), application::MissingBaseFileException);
+}
+
+TEST_F(TestUpgradePackInputFactory, create_compressed_Input_for_compressed_target)
+{
+    std::array<uint8_t, 4> magic{ 'L', 'Z', '4', 'B' };
+
+    auto image = factory.CreateInput("lz4", "bin_file", std::nullopt)->Image();
+    EXPECT_NE(image.end(), std::search(image.begin(), image.end(), magic.begin(), magic.end()));
+
+    image = factory.CreateInput("bin", "bin_file", std::nullopt)->Image();
+    EXPECT_EQ(image.end(), std::search(image.begin(), image.end(), magic.begin(), magic.end()));
+}
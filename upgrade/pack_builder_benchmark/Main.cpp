@@ -0,0 +1,95 @@
+#include "upgrade/pack_builder/BinaryObject.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures how long the upgrade pack builder takes to ingest a large Intel HEX file and to linearize the resulting
+// SparseVector. The generated file consists of 16-byte data records, leaves a gap of one record after every KiB, and
+// starts a new extended linear address record every 64 KiB, similar to the output of common linkers.
+//
+// Usage: upgrade.pack_builder_benchmark [size in KiB, default 16384]
+
+namespace
+{
+    const std::size_t recordSize = 16;
+    const std::size_t gapInterval = 1024;
+
+    std::string HexRecord(uint8_t recordType, uint16_t address, const std::vector<uint8_t>& data)
+    {
+        std::vector<uint8_t> bytes{ static_cast<uint8_t>(data.size()), static_cast<uint8_t>(address >> 8), static_cast<uint8_t>(address), recordType };
+        bytes.insert(bytes.end(), data.begin(), data.end());
+
+        uint8_t checksum = 0;
+        for (auto byte : bytes)
+            checksum -= byte;
+        bytes.push_back(checksum);
+
+        std::string result = ":";
+        char digits[3];
+        for (auto byte : bytes)
+        {
+            std::snprintf(digits, sizeof(digits), "%02X", byte);
+            result += digits;
+        }
+
+        return result;
+    }
+
+    std::vector<std::string> GenerateHex(std::size_t size)
+    {
+        std::vector<std::string> result;
+        std::vector<uint8_t> data(recordSize);
+
+        for (std::size_t address = 0; address < size; address += recordSize)
+        {
+            if (address % 0x10000 == 0)
+                result.push_back(HexRecord(4, 0, { static_cast<uint8_t>(address >> 24), static_cast<uint8_t>(address >> 16) }));
+
+            if (address % gapInterval == gapInterval - recordSize)
+                continue;
+
+            for (std::size_t i = 0; i != data.size(); ++i)
+                data[i] = static_cast<uint8_t>(address + i);
+
+            result.push_back(HexRecord(0, static_cast<uint16_t>(address), data));
+        }
+
+        result.push_back(HexRecord(1, 0, {}));
+        return result;
+    }
+
+    template<class F>
+    double Measure(F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    std::size_t size = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16384) * 1024;
+
+    auto hex = GenerateHex(size);
+    std::cout << "HEX file: " << size / 1024 << " KiB in " << hex.size() << " records" << std::endl;
+
+    application::BinaryObject binaryObject;
+    auto ingest = Measure([&]()
+        {
+            binaryObject.AddHex(hex, 0, "benchmark.hex");
+        });
+    std::cout << "AddHex:    " << ingest << " s, " << binaryObject.Memory().GetSegments().size() << " segments" << std::endl;
+
+    std::size_t linearSize = 0;
+    auto linearize = Measure([&]()
+        {
+            linearSize = binaryObject.Memory().Linearize(0xff).first.size();
+        });
+    std::cout << "Linearize: " << linearize << " s, " << linearSize << " bytes" << std::endl;
+
+    return 0;
+}
@@ -19,6 +19,12 @@ namespace main_
 
         for (const auto& [target, location] : supportedTargets.ElfTargets())
             AddTarget(target);
+
+        for (const auto& [target, location] : supportedTargets.DeltaTargets())
+        {
+            AddTarget(target);
+            AddBaseFile(target);
+        }
     }
 
     int UpgradePackBuilderApplication::Main(int argc, const char* argv[])
@@ -49,9 +55,14 @@ namespace main_
         for (auto& target : targets)
             requestedTargets.emplace_back(target.Name(), args::get(target), std::nullopt);
 
+        application::UpgradePackInputFactory::BaseFiles requestedBaseFiles;
+        for (auto& [target, baseFile] : baseFiles)
+            if (baseFile)
+                requestedBaseFiles.emplace(target, args::get(baseFile));
+
         try
         {
-            UpgradePackBuilderFacade(header).Build(supportedTargets, requestedTargets, args::get(outputFile));
+            UpgradePackBuilderFacade(header, args::get(concurrency), requestedBaseFiles).Build(supportedTargets, requestedTargets, args::get(outputFile));
         }
         catch (const std::exception& e)
         {
@@ -76,4 +87,10 @@ namespace main_
     {
         targets.emplace_back(targetGroup, target, "File for the '" + target + "' target", args::Matcher{ target }, OptionsForTarget(target));
     }
+
+    void UpgradePackBuilderApplication::AddBaseFile(const std::string& target)
+    {
+        baseFiles.emplace(std::piecewise_construct, std::forward_as_tuple(target),
+            std::forward_as_tuple(targetGroup, target + "-base", "Currently installed image from which the '" + target + "' delta is made", args::Matcher{ target + "-base" }));
+    }
 }
@@ -2,6 +2,7 @@
 #include "upgrade/pack_builder/SupportedTargets.hpp"
 #include "upgrade/pack_builder/UpgradePackBuilder.hpp"
 #include <list>
+#include <map>
 #include <string>
 
 namespace main_
@@ -16,6 +17,7 @@ namespace main_
     private:
         args::Options OptionsForTarget(const std::string& target) const;
         void AddTarget(const std::string& target);
+        void AddBaseFile(const std::string& target);
 
     private:
         const application::UpgradePackBuilder::HeaderInfo& header;
@@ -24,7 +26,9 @@ namespace main_
         args::ArgumentParser parser;
         args::HelpFlag help{ parser, "help", "Display this help menu", { 'h', "help" } };
         args::ValueFlag<std::string> outputFile{ parser, "filename", "Output file name", { 'o', "output" }, args::Options::Required };
+        args::ValueFlag<std::size_t> concurrency{ parser, "count", "Number of images that are created at once", { 'j', "concurrency" }, 1 };
         args::Group targetGroup{ parser, "Supported Targets" };
         std::list<args::ValueFlag<std::string>> targets;
+        std::map<std::string, args::ValueFlag<std::string>> baseFiles;
     };
 }
@@ -28,8 +28,11 @@ namespace main_
         {}
     };
 
-    UpgradePackBuilderFacade::UpgradePackBuilderFacade(const application::UpgradePackBuilder::HeaderInfo& headerInfo)
-        : headerInfo(headerInfo)
+    UpgradePackBuilderFacade::UpgradePackBuilderFacade(const application::UpgradePackBuilder::HeaderInfo& headerInfo, std::size_t concurrency,
+        const application::UpgradePackInputFactory::BaseFiles& baseFiles)
+        : concurrency(concurrency)
+        , baseFiles(baseFiles)
+        , headerInfo(headerInfo)
     {}
 
     void UpgradePackBuilderFacade::Build(const application::SupportedTargets& supportedTargets, const TargetAndFiles& requestedTargets, const std::string& outputFilename,
@@ -56,9 +59,9 @@ namespace main_
     {
         hal::FileSystemGeneric fileSystem;
         application::ImageEncryptorNone encryptor;
-        application::UpgradePackInputFactory inputFactory(fileSystem, supportedTargets, encryptor);
         application::ImageSignerHashOnly signer;
-        application::UpgradePackBuilder builder(headerInfo, std::move(CreateInputs(supportedTargets, requestedTargets, inputFactory)), signer);
+        application::UpgradePackInputFactory inputFactory(fileSystem, supportedTargets, encryptor, signer, baseFiles);
+        application::UpgradePackBuilder builder(headerInfo, std::move(CreateInputs(supportedTargets, requestedTargets, inputFactory)), signer, application::UpgradePackStatus::readyToDeploy, concurrency);
 
         builder.WriteUpgradePack(outputFilename, fileSystem);
     }
@@ -67,10 +70,10 @@ namespace main_
         const BuildOptions& buildOptions, infra::JsonObject& configuration, const application::ImageSecurity& encryptor, application::ImageSigner& signer)
     {
         hal::FileSystemGeneric fileSystem;
-        application::UpgradePackInputFactory inputFactory(fileSystem, supportedTargets, encryptor);
+        application::UpgradePackInputFactory inputFactory(fileSystem, supportedTargets, encryptor, signer, baseFiles);
 
         PreBuilder(requestedTargets, buildOptions, configuration);
-        application::UpgradePackBuilder builder(headerInfo, std::move(CreateInputs(supportedTargets, requestedTargets, inputFactory)), signer);
+        application::UpgradePackBuilder builder(headerInfo, std::move(CreateInputs(supportedTargets, requestedTargets, inputFactory)), signer, application::UpgradePackStatus::readyToDeploy, concurrency);
         PostBuilder(builder, signer, buildOptions);
 
         builder.WriteUpgradePack(outputFilename, fileSystem);
@@ -30,7 +30,11 @@ namespace main_
     class UpgradePackBuilderFacade
     {
     public:
-        explicit UpgradePackBuilderFacade(const application::UpgradePackBuilder::HeaderInfo& headerInfo);
+        // With a concurrency larger than one, the images are created on that many threads at once. This requires that the
+        // inputs and the ImageSecurity used by them are safe to invoke concurrently, see UpgradePackBuilder. Delta targets
+        // additionally invoke the ImageSigner, and take their base image from baseFiles.
+        explicit UpgradePackBuilderFacade(const application::UpgradePackBuilder::HeaderInfo& headerInfo, std::size_t concurrency = 1,
+            const application::UpgradePackInputFactory::BaseFiles& baseFiles = {});
         virtual ~UpgradePackBuilderFacade() = default;
 
         void Build(const application::SupportedTargets& supportedTargets, const TargetAndFiles& requestedTargets, const std::string& outputFilename,
@@ -54,6 +58,8 @@ namespace main_
         std::vector<std::unique_ptr<application::Input>> CreateInputs(const application::SupportedTargets& supportedTargets, const TargetAndFiles& requestedTargets, application::InputFactory& factory);
 
     private:
+        std::size_t concurrency;
+        application::UpgradePackInputFactory::BaseFiles baseFiles;
         uint8_t currentOrderOfTarget = 0;
 
     protected: